@@ -11,12 +11,8 @@ Collider::Collider(ColliderType type) : m_type(type) {
 }
 
 void Collider::onAttach() {
-    // Get Transform component from the same GameObject
-    m_transform = getGameObject()->getComponent<Transform>();
-    if (!m_transform) {
-        // If no Transform exists, create one
-        m_transform = getGameObject()->addComponent<Transform>();
-    }
+    // Every GameObject owns a Transform
+    m_transform = getGameObject()->getTransform();
 }
 
 // BoxCollider implementation
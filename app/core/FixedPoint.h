@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+
+namespace RoadSim::Core {
+
+/**
+ * @brief Q16.16 fixed-point number for deterministic simulation
+ * Arithmetic is integer-only so results are bit-identical across compilers,
+ * platforms and floating-point flags. Range is +/-32768, which is meant for
+ * per-lane coordinates (offset along a lane), not absolute world positions.
+ */
+class Fixed {
+public:
+    static constexpr int FractionBits = 16;
+    static constexpr int32_t One = 1 << FractionBits;
+    
+    constexpr Fixed() = default;
+    
+    static constexpr Fixed fromRaw(int32_t raw) {
+        Fixed result;
+        result.m_raw = raw;
+        return result;
+    }
+    
+    static constexpr Fixed fromInt(int32_t value) { return fromRaw(value * One); }
+    
+    /**
+     * @brief Quantize a float (rounds to nearest, ties away from zero)
+     * Values outside the range saturate; NaN becomes zero.
+     */
+    static constexpr Fixed fromFloat(float value) {
+        return fromRaw(saturate(value * static_cast<float>(One) + (value >= 0.0f ? 0.5f : -0.5f)));
+    }
+    
+    static constexpr Fixed fromDouble(double value) {
+        return fromRaw(saturate(value * static_cast<double>(One) + (value >= 0.0 ? 0.5 : -0.5)));
+    }
+    
+    constexpr int32_t raw() const { return m_raw; }
+    constexpr float toFloat() const { return static_cast<float>(m_raw) / static_cast<float>(One); }
+    constexpr double toDouble() const { return static_cast<double>(m_raw) / static_cast<double>(One); }
+    
+    constexpr Fixed operator+(Fixed other) const { return fromRaw(m_raw + other.m_raw); }
+    constexpr Fixed operator-(Fixed other) const { return fromRaw(m_raw - other.m_raw); }
+    constexpr Fixed operator-() const { return fromRaw(-m_raw); }
+    
+    constexpr Fixed operator*(Fixed other) const {
+        return fromRaw(static_cast<int32_t>((static_cast<int64_t>(m_raw) * other.m_raw) >> FractionBits));
+    }
+    
+    // Saturates instead of trapping on a zero divisor or an out-of-range quotient
+    constexpr Fixed operator/(Fixed other) const {
+        if (other.m_raw == 0) {
+            return fromRaw(m_raw < 0 ? INT32_MIN : INT32_MAX);
+        }
+        const int64_t quotient = (static_cast<int64_t>(m_raw) * One) / other.m_raw;
+        return fromRaw(static_cast<int32_t>(std::clamp<int64_t>(quotient, INT32_MIN, INT32_MAX)));
+    }
+    
+    constexpr Fixed& operator+=(Fixed other) { m_raw += other.m_raw; return *this; }
+    constexpr Fixed& operator-=(Fixed other) { m_raw -= other.m_raw; return *this; }
+    constexpr Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    constexpr Fixed& operator/=(Fixed other) { return *this = *this / other; }
+    
+    constexpr auto operator<=>(const Fixed&) const = default;
+    
+private:
+    int32_t m_raw = 0;
+    
+    // Truncate a scaled value to raw; casting an out-of-range value directly is undefined
+    template <typename T>
+    static constexpr int32_t saturate(T scaled) {
+        if (scaled != scaled) return 0;
+        if (scaled <= static_cast<T>(INT32_MIN)) return INT32_MIN;
+        if (scaled >= static_cast<T>(INT32_MAX)) return INT32_MAX;
+        return static_cast<int32_t>(scaled);
+    }
+};
+
+/**
+ * @brief 2D vector of fixed-point values
+ */
+struct FixedVec2 {
+    Fixed x;
+    Fixed y;
+    
+    constexpr FixedVec2 operator+(const FixedVec2& other) const { return {x + other.x, y + other.y}; }
+    constexpr FixedVec2 operator-(const FixedVec2& other) const { return {x - other.x, y - other.y}; }
+    constexpr FixedVec2 operator*(Fixed scalar) const { return {x * scalar, y * scalar}; }
+    constexpr bool operator==(const FixedVec2&) const = default;
+};
+
+namespace FixedTrig {
+
+// Angles are resolved to 1/1024 of a turn and linearly interpolated in between
+inline constexpr int TableSteps = 1024;
+inline constexpr int QuarterSteps = TableSteps / 4;
+
+/**
+ * @brief Quarter-wave sine table in Q16.16, built with integer-only Taylor series
+ */
+inline constexpr std::array<int32_t, QuarterSteps + 1> QuarterSineTable = [] {
+    std::array<int32_t, QuarterSteps + 1> table{};
+    constexpr int64_t halfPiQ30 = 1686629713; // pi/2 in Q2.30
+    
+    for (int i = 0; i <= QuarterSteps; ++i) {
+        const int64_t x = halfPiQ30 * i / QuarterSteps;
+        int64_t term = x;
+        int64_t sum = x;
+        
+        for (int k = 1; k <= 8; ++k) {
+            term = ((term * x) >> 30) * x >> 30;
+            term = -term / ((2 * k) * (2 * k + 1));
+            sum += term;
+        }
+        
+        // Q30 -> Q16 with rounding
+        table[i] = static_cast<int32_t>((sum + (int64_t{1} << 13)) >> 14);
+    }
+    
+    return table;
+}();
+
+constexpr int32_t sineAtStep(int step) {
+    step &= TableSteps - 1;
+    const int quadrant = step / QuarterSteps;
+    const int offset = step % QuarterSteps;
+    
+    switch (quadrant) {
+        case 0: return QuarterSineTable[offset];
+        case 1: return QuarterSineTable[QuarterSteps - offset];
+        case 2: return -QuarterSineTable[offset];
+        default: return -QuarterSineTable[QuarterSteps - offset];
+    }
+}
+
+/**
+ * @brief Deterministic sine of an angle in degrees
+ */
+constexpr Fixed sinDegrees(Fixed degrees) {
+    // Convert to table steps in Q16.16 with floor division
+    int64_t scaled = static_cast<int64_t>(degrees.raw()) * TableSteps;
+    int64_t steps = scaled / 360;
+    if (scaled % 360 != 0 && scaled < 0) --steps;
+    
+    const int step = static_cast<int>((steps >> Fixed::FractionBits) & (TableSteps - 1));
+    const int64_t fraction = steps & (Fixed::One - 1);
+    
+    const int64_t s0 = sineAtStep(step);
+    const int64_t s1 = sineAtStep(step + 1);
+    return Fixed::fromRaw(static_cast<int32_t>(s0 + (((s1 - s0) * fraction) >> Fixed::FractionBits)));
+}
+
+/**
+ * @brief Deterministic cosine of an angle in degrees
+ */
+constexpr Fixed cosDegrees(Fixed degrees) {
+    return sinDegrees(degrees + Fixed::fromInt(90));
+}
+
+/**
+ * @brief Unit direction vector for an angle in degrees
+ */
+constexpr FixedVec2 direction(Fixed degrees) {
+    return {cosDegrees(degrees), sinDegrees(degrees)};
+}
+
+} // namespace FixedTrig
+
+} // namespace RoadSim::Core
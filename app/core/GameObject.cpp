@@ -6,9 +6,12 @@ namespace RoadSim::Core {
 // Static member initialization
 size_t GameObject::s_nextId = 1;
 
-GameObject::GameObject(const std::string& name) 
+GameObject::GameObject(const std::string& name, TransformStore* transformStore) 
     : m_id(s_nextId++), m_name(name) {
     std::cout << "[GameObject] Created " << m_name << " (ID: " << m_id << ")" << std::endl;
+    
+    m_transform = transformStore ? addComponent<Transform>(*transformStore)
+                                 : addComponent<Transform>();
 }
 
 GameObject::~GameObject() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "Transform.h"
 #include <SFML/System/Vector2.hpp>
 #include <memory>
 #include <vector>
@@ -13,11 +14,16 @@ namespace RoadSim::Core {
 
 /**
  * @brief Base class for all objects in the simulation scene
- * Provides a Unity-like GameObject system with component architecture
+ * Provides a Unity-like GameObject system with component architecture.
+ * Every GameObject owns a Transform, which holds its position, rotation and scale.
  */
 class GameObject {
 public:
-    GameObject(const std::string& name = "GameObject");
+    /**
+     * @param name GameObject name
+     * @param transformStore Store for the Transform data (nullptr = default store)
+     */
+    GameObject(const std::string& name = "GameObject", TransformStore* transformStore = nullptr);
     virtual ~GameObject();
     
     // Non-copyable
@@ -87,6 +93,11 @@ public:
     bool removeComponent() {
         static_assert(std::is_base_of_v<Component, T>, "T must derive from Component");
         
+        if constexpr (std::is_same_v<T, Transform>) {
+            std::cerr << "[GameObject] Transform cannot be removed from " << m_name << std::endl;
+            return false;
+        }
+        
         auto typeIndex = std::type_index(typeid(T));
         auto it = m_components.find(typeIndex);
         
@@ -144,35 +155,40 @@ public:
      */
     void setActive(bool active) { m_active = active; }
     
+    /**
+     * @brief Get the Transform component
+     */
+    Transform* getTransform() const { return m_transform; }
+    
     /**
      * @brief Get GameObject position
      */
-    const sf::Vector2f& getPosition() const { return m_position; }
+    sf::Vector2f getPosition() const { return m_transform->getPosition(); }
     
     /**
      * @brief Set GameObject position
      */
-    void setPosition(const sf::Vector2f& position) { m_position = position; }
+    void setPosition(const sf::Vector2f& position) { m_transform->setPosition(position); }
     
     /**
      * @brief Get GameObject rotation (in degrees)
      */
-    float getRotation() const { return m_rotation; }
+    float getRotation() const { return m_transform->getRotation(); }
     
     /**
      * @brief Set GameObject rotation (in degrees)
      */
-    void setRotation(float rotation) { m_rotation = rotation; }
+    void setRotation(float rotation) { m_transform->setRotation(rotation); }
     
     /**
      * @brief Get GameObject scale
      */
-    const sf::Vector2f& getScale() const { return m_scale; }
+    sf::Vector2f getScale() const { return m_transform->getScale(); }
     
     /**
      * @brief Set GameObject scale
      */
-    void setScale(const sf::Vector2f& scale) { m_scale = scale; }
+    void setScale(const sf::Vector2f& scale) { m_transform->setScale(scale); }
     
     /**
      * @brief Get unique GameObject ID
@@ -186,13 +202,11 @@ private:
     std::string m_name;
     bool m_active = true;
     
-    // Transform data
-    sf::Vector2f m_position{0.0f, 0.0f};
-    float m_rotation = 0.0f;
-    sf::Vector2f m_scale{1.0f, 1.0f};
-    
     // Component storage
     std::unordered_map<std::type_index, std::unique_ptr<Component>> m_components;
+    
+    // Cached pointer to the Transform component (always present)
+    Transform* m_transform = nullptr;
 };
 
 } // namespace RoadSim::Core
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RoadSim::Core {
+
+/**
+ * @brief Intersection or shape point of the road network
+ */
+struct MapNode {
+    int32_t id = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+/**
+ * @brief Road segment between two nodes
+ */
+struct MapRoad {
+    int32_t id = 0;
+    int32_t fromNode = 0;
+    int32_t toNode = 0;
+    int32_t lanes = 1;
+    float speedLimit = 13.9f; // m/s (50 km/h)
+    bool oneWay = false;
+};
+
+/**
+ * @brief Traffic light controlling a node
+ */
+struct MapTrafficLight {
+    int32_t nodeId = 0;
+    float cycleTime = 60.0f; // Seconds
+    float offset = 0.0f;     // Seconds into the cycle at t=0
+};
+
+/**
+ * @brief Entity spawn location
+ */
+struct MapSpawnPoint {
+    float x = 0.0f;
+    float y = 0.0f;
+    std::string type;
+    float rate = 1.0f; // Entities per second
+};
+
+/**
+ * @brief Flat tables describing a road network (map.json)
+ */
+struct MapData {
+    std::string name;
+    std::vector<MapNode> nodes;
+    std::vector<MapRoad> roads;
+    std::vector<MapTrafficLight> trafficLights;
+    std::vector<MapSpawnPoint> spawnPoints;
+    
+    void clear() {
+        name.clear();
+        nodes.clear();
+        roads.clear();
+        trafficLights.clear();
+        spawnPoints.clear();
+    }
+};
+
+} // namespace RoadSim::Core
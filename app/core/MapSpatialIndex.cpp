@@ -0,0 +1,255 @@
+#include "MapSpatialIndex.h"
+#include "Trace.h"
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace RoadSim::Core {
+
+namespace {
+
+constexpr float TargetRoadsPerCell = 16.0f;
+
+uint32_t packItem(MapSpatialIndex::ItemKind kind, size_t index) {
+    return (static_cast<uint32_t>(kind) << 30) | static_cast<uint32_t>(index);
+}
+
+float distanceSquaredToSegment(sf::Vector2f point, sf::Vector2f start, sf::Vector2f end) {
+    const sf::Vector2f segment = end - start;
+    const sf::Vector2f offset = point - start;
+    const float lengthSquared = segment.x * segment.x + segment.y * segment.y;
+    float t = lengthSquared > 0.0f ? (offset.x * segment.x + offset.y * segment.y) / lengthSquared : 0.0f;
+    t = std::clamp(t, 0.0f, 1.0f);
+    const sf::Vector2f nearest = start + segment * t - point;
+    return nearest.x * nearest.x + nearest.y * nearest.y;
+}
+
+} // namespace
+
+MapSpatialIndex::MapSpatialIndex() = default;
+
+MapSpatialIndex::~MapSpatialIndex() = default;
+
+void MapSpatialIndex::clear() {
+    m_cellSize = 0.0f;
+    m_columns = 0;
+    m_rows = 0;
+    m_bounds = sf::FloatRect();
+    m_cellStart.assign(1, 0);
+    m_items.clear();
+    m_itemEnds.clear();
+    m_roads.clear();
+    m_lightPositions.clear();
+    m_spawnPositions.clear();
+}
+
+void MapSpatialIndex::build(const MapData& map, float cellSize) {
+    ROADSIM_TRACE_SCOPE("Core", "MapSpatialIndex::build");
+    clear();
+    
+    std::unordered_map<int32_t, sf::Vector2f> nodePositions;
+    nodePositions.reserve(map.nodes.size());
+    for (const MapNode& node : map.nodes) {
+        nodePositions.emplace(node.id, sf::Vector2f(node.x, node.y));
+    }
+    
+    // Resolve positions first; everything indexed lies inside the bounds
+    float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+    bool any = false;
+    auto extend = [&](sf::Vector2f p) {
+        if (!any) {
+            left = right = p.x;
+            top = bottom = p.y;
+            any = true;
+            return;
+        }
+        left = std::min(left, p.x);
+        right = std::max(right, p.x);
+        top = std::min(top, p.y);
+        bottom = std::max(bottom, p.y);
+    };
+    
+    m_roads.resize(map.roads.size());
+    size_t indexedRoads = 0;
+    for (size_t i = 0; i < map.roads.size(); ++i) {
+        const auto from = nodePositions.find(map.roads[i].fromNode);
+        const auto to = nodePositions.find(map.roads[i].toNode);
+        if (from == nodePositions.end() || to == nodePositions.end()) continue;
+        m_roads[i].start = from->second;
+        m_roads[i].end = to->second;
+        m_roads[i].indexed = true;
+        extend(from->second);
+        extend(to->second);
+        ++indexedRoads;
+    }
+    
+    std::vector<bool> lightIndexed(map.trafficLights.size(), false);
+    m_lightPositions.resize(map.trafficLights.size());
+    for (size_t i = 0; i < map.trafficLights.size(); ++i) {
+        const auto node = nodePositions.find(map.trafficLights[i].nodeId);
+        if (node == nodePositions.end()) continue;
+        m_lightPositions[i] = node->second;
+        lightIndexed[i] = true;
+        extend(node->second);
+    }
+    
+    m_spawnPositions.resize(map.spawnPoints.size());
+    for (size_t i = 0; i < map.spawnPoints.size(); ++i) {
+        m_spawnPositions[i] = sf::Vector2f(map.spawnPoints[i].x, map.spawnPoints[i].y);
+        extend(m_spawnPositions[i]);
+    }
+    
+    if (!any) return;
+    
+    const float width = right - left;
+    const float height = bottom - top;
+    if (cellSize <= 0.0f) {
+        cellSize = std::sqrt(width * height * TargetRoadsPerCell / static_cast<float>(std::max<size_t>(indexedRoads, 1)));
+    }
+    cellSize = std::max({cellSize, MinCellSize, width / (MaxCellsPerAxis - 1), height / (MaxCellsPerAxis - 1)});
+    
+    m_cellSize = cellSize;
+    m_columns = static_cast<int>(width / cellSize) + 1;
+    m_rows = static_cast<int>(height / cellSize) + 1;
+    m_bounds = sf::FloatRect(left, top, static_cast<float>(m_columns) * cellSize, static_cast<float>(m_rows) * cellSize);
+    
+    // Counting sort into cells: count, prefix-sum, then place
+    std::vector<uint32_t> counts(static_cast<size_t>(getCellCount()) + 1, 0);
+    auto forEachCell = [&](auto&& placeItem) {
+        for (size_t i = 0; i < m_roads.size(); ++i) {
+            Segment& segment = m_roads[i];
+            if (!segment.indexed) continue;
+            segment.spansCells = getCellIndex(segment.start) != getCellIndex(segment.end);
+            forEachSegmentCell(segment.start, segment.end, [&](int cell) { placeItem(cell, packItem(ItemKind::Road, i)); });
+        }
+        for (size_t i = 0; i < m_lightPositions.size(); ++i) {
+            if (lightIndexed[i]) placeItem(getCellIndex(m_lightPositions[i]), packItem(ItemKind::TrafficLight, i));
+        }
+        for (size_t i = 0; i < m_spawnPositions.size(); ++i) {
+            placeItem(getCellIndex(m_spawnPositions[i]), packItem(ItemKind::SpawnPoint, i));
+        }
+    };
+    
+    forEachCell([&](int cell, uint32_t) { counts[static_cast<size_t>(cell) + 1]++; });
+    for (size_t cell = 1; cell < counts.size(); ++cell) counts[cell] += counts[cell - 1];
+    m_cellStart = counts;
+    m_items.resize(m_cellStart.back());
+    forEachCell([&](int cell, uint32_t item) { m_items[counts[static_cast<size_t>(cell)]++] = item; });
+    
+    m_itemEnds.resize(m_items.size() * 2);
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        const uint32_t index = itemIndex(m_items[i]);
+        switch (itemKind(m_items[i])) {
+            case ItemKind::Road:
+                m_itemEnds[i * 2] = m_roads[index].start;
+                m_itemEnds[i * 2 + 1] = m_roads[index].end;
+                break;
+            case ItemKind::TrafficLight:
+                m_itemEnds[i * 2] = m_itemEnds[i * 2 + 1] = m_lightPositions[index];
+                break;
+            case ItemKind::SpawnPoint:
+                m_itemEnds[i * 2] = m_itemEnds[i * 2 + 1] = m_spawnPositions[index];
+                break;
+        }
+    }
+}
+
+int MapSpatialIndex::columnOf(float x) const {
+    return std::clamp(static_cast<int>(std::floor((x - m_bounds.left) / m_cellSize)), 0, m_columns - 1);
+}
+
+int MapSpatialIndex::rowOf(float y) const {
+    return std::clamp(static_cast<int>(std::floor((y - m_bounds.top) / m_cellSize)), 0, m_rows - 1);
+}
+
+template <typename F>
+void MapSpatialIndex::forEachSegmentCell(sf::Vector2f start, sf::Vector2f end, F&& visit) const {
+    // Grid walk (Amanatides-Woo) in cell units; next* is the segment parameter
+    // at the next column or row boundary, delta* the parameter per cell
+    const float x0 = (start.x - m_bounds.left) / m_cellSize;
+    const float y0 = (start.y - m_bounds.top) / m_cellSize;
+    const float x1 = (end.x - m_bounds.left) / m_cellSize;
+    const float y1 = (end.y - m_bounds.top) / m_cellSize;
+    int column = columnOf(start.x);
+    int row = rowOf(start.y);
+    const int lastColumn = columnOf(end.x);
+    const int lastRow = rowOf(end.y);
+    const int stepColumn = lastColumn >= column ? 1 : -1;
+    const int stepRow = lastRow >= row ? 1 : -1;
+    
+    const float infinity = std::numeric_limits<float>::infinity();
+    const float dx = std::abs(x1 - x0);
+    const float dy = std::abs(y1 - y0);
+    const float deltaX = dx > 0.0f ? 1.0f / dx : infinity;
+    const float deltaY = dy > 0.0f ? 1.0f / dy : infinity;
+    float nextX = dx > 0.0f ? (stepColumn > 0 ? static_cast<float>(column + 1) - x0 : x0 - static_cast<float>(column)) * deltaX : infinity;
+    float nextY = dy > 0.0f ? (stepRow > 0 ? static_cast<float>(row + 1) - y0 : y0 - static_cast<float>(row)) * deltaY : infinity;
+    
+    visit(row * m_columns + column);
+    
+    // Every step moves towards the last cell, so rounding cannot make the walk overshoot
+    while (column != lastColumn || row != lastRow) {
+        const bool advanceColumn = column != lastColumn && (row == lastRow || nextX <= nextY);
+        const bool advanceRow = row != lastRow && (column == lastColumn || nextY <= nextX);
+        if (advanceColumn && advanceRow) {
+            visit(row * m_columns + column + stepColumn);
+            visit((row + stepRow) * m_columns + column);
+        }
+        if (advanceColumn) {
+            column += stepColumn;
+            nextX += deltaX;
+        }
+        if (advanceRow) {
+            row += stepRow;
+            nextY += deltaY;
+        }
+        visit(row * m_columns + column);
+    }
+}
+
+int MapSpatialIndex::getCellIndex(sf::Vector2f point) const {
+    return rowOf(point.y) * m_columns + columnOf(point.x);
+}
+
+bool MapSpatialIndex::cellRange(const sf::FloatRect& area, int& left, int& top, int& right, int& bottom) const {
+    if (isEmpty() || !area.intersects(m_bounds)) return false;
+    
+    left = columnOf(area.left);
+    right = columnOf(area.left + area.width);
+    top = rowOf(area.top);
+    bottom = rowOf(area.top + area.height);
+    return true;
+}
+
+uint32_t MapSpatialIndex::findNearestRoad(sf::Vector2f point, float maxDistance) const {
+    int left, top, right, bottom;
+    const sf::FloatRect area(point.x - maxDistance, point.y - maxDistance, 2.0f * maxDistance, 2.0f * maxDistance);
+    if (!cellRange(area, left, top, right, bottom)) return NoItem;
+    
+    uint32_t nearest = NoItem;
+    float nearestDistance = maxDistance * maxDistance;
+    for (int row = top; row <= bottom; ++row) {
+        for (int column = left; column <= right; ++column) {
+            const int cell = row * m_columns + column;
+            for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                if (itemKind(m_items[i]) != ItemKind::Road) continue;
+                
+                // Endpoints stored beside the ids keep the scan within the cell's memory;
+                // most roads of a cell fail the cheap box test before the projection
+                const sf::Vector2f start = m_itemEnds[i * 2];
+                const sf::Vector2f end = m_itemEnds[i * 2 + 1];
+                if (point.x < std::min(start.x, end.x) - maxDistance || point.x > std::max(start.x, end.x) + maxDistance ||
+                    point.y < std::min(start.y, end.y) - maxDistance || point.y > std::max(start.y, end.y) + maxDistance) continue;
+                
+                const float distance = distanceSquaredToSegment(point, start, end);
+                if (distance <= nearestDistance) {
+                    nearestDistance = distance;
+                    nearest = itemIndex(m_items[i]);
+                }
+            }
+        }
+    }
+    return nearest;
+}
+
+} // namespace RoadSim::Core
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "MapData.h"
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace RoadSim::Core {
+
+/**
+ * @brief Uniform grid over the roads, traffic lights and spawn points of a map
+ * Items are stored per cell in one flat array (cell start offsets plus item
+ * ids), so a query touches only the cells overlapping the area. Roads are
+ * entered in every cell their centre line passes through (a supercover
+ * walk, so a diagonal road costs about one entry per cell crossed rather
+ * than its whole bounding box) and reported once per query. Indices refer
+ * to the MapData tables the index was built from; rebuild it whenever they
+ * change.
+ */
+class MapSpatialIndex {
+public:
+    enum class ItemKind : uint8_t {
+        Road,
+        TrafficLight,
+        SpawnPoint
+    };
+    
+    static constexpr float MinCellSize = 32.0f;
+    static constexpr int MaxCellsPerAxis = 1024;
+    static constexpr uint32_t NoItem = 0xFFFFFFFFu;
+    
+    MapSpatialIndex();
+    ~MapSpatialIndex();
+    
+    /**
+     * @brief Index the map's tables
+     * @param map Map tables; roads or lights referencing missing nodes are left out
+     * @param cellSize Cell edge in world units, or 0 to aim at ~16 roads per cell
+     */
+    void build(const MapData& map, float cellSize = 0.0f);
+    
+    void clear();
+    
+    /**
+     * @brief Visit each item entered in a cell overlapping area
+     * Roads crossing several cells are collected and reported after the
+     * others, once each.
+     * @param visitor Called as visitor(ItemKind, uint32_t index); roads at most once
+     */
+    template <typename F>
+    void query(const sf::FloatRect& area, F&& visitor) const {
+        int left, top, right, bottom;
+        if (!cellRange(area, left, top, right, bottom)) return;
+        
+        std::vector<uint32_t> spanning;
+        for (int row = top; row <= bottom; ++row) {
+            for (int column = left; column <= right; ++column) {
+                for (const uint32_t item : getCellItems(row * m_columns + column)) {
+                    const ItemKind kind = itemKind(item);
+                    const uint32_t index = itemIndex(item);
+                    if (kind == ItemKind::Road && m_roads[index].spansCells) {
+                        spanning.push_back(index);
+                        continue;
+                    }
+                    visitor(kind, index);
+                }
+            }
+        }
+        
+        std::sort(spanning.begin(), spanning.end());
+        spanning.erase(std::unique(spanning.begin(), spanning.end()), spanning.end());
+        for (const uint32_t road : spanning) visitor(ItemKind::Road, road);
+    }
+    
+    /**
+     * @brief Visit the cells overlapping area as runs of consecutive cell indices
+     * Cells are numbered row by row, so each row of the range is one run; rows
+     * spanning the full grid width are merged into a single run. Geometry
+     * sorted by cell can then be drawn with one call per run.
+     * @param visitor Called as visitor(firstCell, lastCell), both inclusive
+     */
+    template <typename F>
+    void forEachCellRun(const sf::FloatRect& area, F&& visitor) const {
+        int left, top, right, bottom;
+        if (!cellRange(area, left, top, right, bottom)) return;
+        
+        if (left == 0 && right == m_columns - 1) {
+            visitor(top * m_columns, bottom * m_columns + right);
+            return;
+        }
+        for (int row = top; row <= bottom; ++row) {
+            visitor(row * m_columns + left, row * m_columns + right);
+        }
+    }
+    
+    /**
+     * @brief Road whose centre line passes closest to a point
+     * @param maxDistance Search radius; at most a cell in practice
+     * @return Road index, or NoItem if none is within maxDistance
+     */
+    uint32_t findNearestRoad(sf::Vector2f point, float maxDistance) const;
+    
+    /**
+     * @brief Cell containing a point, clamped to the grid
+     */
+    int getCellIndex(sf::Vector2f point) const;
+    
+    /**
+     * @brief Inclusive range of cells overlapping area
+     * @return False if the area misses the grid (or the index is empty)
+     */
+    bool cellRange(const sf::FloatRect& area, int& left, int& top, int& right, int& bottom) const;
+    
+    std::span<const uint32_t> getCellItems(int cell) const {
+        return {m_items.data() + m_cellStart[cell], m_items.data() + m_cellStart[cell + 1]};
+    }
+    
+    static ItemKind itemKind(uint32_t item) { return static_cast<ItemKind>(item >> 30); }
+    static uint32_t itemIndex(uint32_t item) { return item & 0x3FFFFFFFu; }
+    
+    int getColumns() const { return m_columns; }
+    int getRows() const { return m_rows; }
+    int getCellCount() const { return m_columns * m_rows; }
+    float getCellSize() const { return m_cellSize; }
+    const sf::FloatRect& getBounds() const { return m_bounds; }
+    bool isEmpty() const { return m_columns == 0; }
+    
+    /**
+     * @brief Road centre line endpoints (valid for indexed roads only)
+     */
+    sf::Vector2f getRoadStart(uint32_t road) const { return m_roads[road].start; }
+    sf::Vector2f getRoadEnd(uint32_t road) const { return m_roads[road].end; }
+    bool isRoadIndexed(uint32_t road) const { return road < m_roads.size() && m_roads[road].indexed; }
+    
+    /**
+     * @brief Position of a traffic light's node or a spawn point
+     */
+    sf::Vector2f getTrafficLightPosition(uint32_t light) const { return m_lightPositions[light]; }
+    sf::Vector2f getSpawnPointPosition(uint32_t spawnPoint) const { return m_spawnPositions[spawnPoint]; }
+    
+private:
+    struct Segment {
+        sf::Vector2f start;
+        sf::Vector2f end;
+        bool indexed = false;       // False when a node is missing
+        bool spansCells = false;    // Entered in more than one cell
+    };
+    
+    float m_cellSize = 0.0f;
+    int m_columns = 0;
+    int m_rows = 0;
+    sf::FloatRect m_bounds;
+    
+    std::vector<uint32_t> m_cellStart;  // getCellCount() + 1 offsets into m_items
+    std::vector<uint32_t> m_items;      // Kind in the top two bits, table index below
+    std::vector<sf::Vector2f> m_itemEnds; // Two per item (road endpoints, else the position twice), kept next to the ids for nearest-road scans
+    std::vector<Segment> m_roads;
+    std::vector<sf::Vector2f> m_lightPositions;
+    std::vector<sf::Vector2f> m_spawnPositions;
+    
+    int columnOf(float x) const;
+    int rowOf(float y) const;
+    
+    /**
+     * @brief Call visit(cell) for each cell the segment touches, from start to end
+     * Where the segment passes exactly through a grid corner, both cells
+     * beside the corner are visited as well.
+     */
+    template <typename F>
+    void forEachSegmentCell(sf::Vector2f start, sf::Vector2f end, F&& visit) const;
+};
+
+} // namespace RoadSim::Core
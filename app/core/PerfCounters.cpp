@@ -0,0 +1,101 @@
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace RoadSim::Core {
+
+namespace {
+
+#ifdef __linux__
+constexpr std::array<uint64_t, PerfCounters::EventCount> HardwareEvents = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+int openCounter(uint64_t config) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.exclude_kernel = 1; // Allowed with perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    
+    // pid 0, cpu -1: the calling thread on any CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    m_fds.fill(-1);
+    
+#ifdef __linux__
+    int firstErrno = 0;
+    for (size_t i = 0; i < EventCount; ++i) {
+        m_fds[i] = openCounter(HardwareEvents[i]);
+        if (m_fds[i] < 0 && firstErrno == 0) firstErrno = errno;
+    }
+    
+    if (!isAvailable()) {
+        m_error = std::string("perf_event_open failed: ") + std::strerror(firstErrno);
+        if (firstErrno == EACCES || firstErrno == EPERM) {
+            m_error += " (check /proc/sys/kernel/perf_event_paranoid)";
+        }
+    }
+#else
+    m_error = "Hardware counters are only supported on Linux";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : m_fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable() const {
+    for (int fd : m_fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+bool PerfCounters::isEventAvailable(Event event) const {
+    return m_fds[event] >= 0;
+}
+
+PerfSample PerfCounters::read() const {
+    std::array<uint64_t, EventCount> values{};
+    
+#ifdef __linux__
+    for (size_t i = 0; i < EventCount; ++i) {
+        if (m_fds[i] < 0) continue;
+        
+        uint64_t data[3] = {}; // value, time enabled, time running
+        if (::read(m_fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        
+        // Scale up when the PMU was shared with other events
+        if (data[2] > 0 && data[2] < data[1]) {
+            values[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]));
+        } else {
+            values[i] = data[0];
+        }
+    }
+#endif
+    
+    return {values[Cycles], values[Instructions], values[CacheMisses], values[BranchMisses]};
+}
+
+} // namespace RoadSim::Core
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace RoadSim::Core {
+
+/**
+ * @brief Hardware counter values (or deltas between two reads)
+ */
+struct PerfSample {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cacheMisses = 0;
+    uint64_t branchMisses = 0;
+    
+    // Saturating: scaled (multiplexed) readings are estimates and may step backwards
+    PerfSample operator-(const PerfSample& other) const {
+        auto delta = [](uint64_t a, uint64_t b) { return a > b ? a - b : 0; };
+        return {delta(cycles, other.cycles), delta(instructions, other.instructions),
+                delta(cacheMisses, other.cacheMisses), delta(branchMisses, other.branchMisses)};
+    }
+    
+    PerfSample& operator+=(const PerfSample& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        cacheMisses += other.cacheMisses;
+        branchMisses += other.branchMisses;
+        return *this;
+    }
+    
+    /**
+     * @brief Instructions per cycle (0 when cycles are unavailable)
+     */
+    double instructionsPerCycle() const {
+        return cycles > 0 ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0;
+    }
+    
+    /**
+     * @brief Misses per thousand instructions
+     */
+    double cacheMissesPerKiloInstruction() const {
+        return instructions > 0 ? static_cast<double>(cacheMisses) * 1000.0 / static_cast<double>(instructions) : 0.0;
+    }
+    
+    double branchMissesPerKiloInstruction() const {
+        return instructions > 0 ? static_cast<double>(branchMisses) * 1000.0 / static_cast<double>(instructions) : 0.0;
+    }
+};
+
+/**
+ * @brief Hardware performance counters of one thread (Linux perf_event_open)
+ * Counts user-space cycles, instructions, cache misses and branch misses of
+ * the thread that opened them. Each counter is opened on its own, so a
+ * machine missing one event still reports the others; on other platforms,
+ * in containers or with a restrictive perf_event_paranoid nothing is
+ * available and read() returns zeros.
+ */
+class PerfCounters {
+public:
+    enum Event : size_t {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses,
+        EventCount
+    };
+    
+    /**
+     * @brief Open counters measuring the calling thread
+     */
+    PerfCounters();
+    ~PerfCounters();
+    
+    // Non-copyable (owns file descriptors)
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    
+    /**
+     * @brief Check whether at least one counter could be opened
+     */
+    bool isAvailable() const;
+    
+    /**
+     * @brief Check whether a specific counter could be opened
+     */
+    bool isEventAvailable(Event event) const;
+    
+    /**
+     * @brief Reason the counters are unavailable (empty when available)
+     */
+    const std::string& getError() const { return m_error; }
+    
+    /**
+     * @brief Read current totals, scaled when the kernel multiplexed counters
+     * Safe to call from any thread
+     */
+    PerfSample read() const;
+    
+private:
+    std::array<int, EventCount> m_fds;
+    std::string m_error;
+};
+
+/**
+ * @brief Counter totals accumulated over one phase
+ */
+struct PerfPhase {
+    PerfSample total;
+    uint64_t calls = 0;
+};
+
+/**
+ * @brief Accumulates the counter delta of a scope into a phase
+ * Does nothing when counters or phase are null, so instrumentation is free when disabled.
+ */
+class PerfScope {
+public:
+    PerfScope(const PerfCounters* counters, PerfPhase* phase)
+        : m_counters(phase ? counters : nullptr), m_phase(phase) {
+        if (m_counters) m_start = m_counters->read();
+    }
+    
+    ~PerfScope() {
+        if (m_counters) {
+            m_phase->total += m_counters->read() - m_start;
+            m_phase->calls++;
+        }
+    }
+    
+    // Non-copyable
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+    
+private:
+    const PerfCounters* m_counters;
+    PerfPhase* m_phase;
+    PerfSample m_start;
+};
+
+} // namespace RoadSim::Core
@@ -1,11 +1,16 @@
 #include "Scene.h"
+#include "FixedPoint.h"
+#include "Trace.h"
 #include <iostream>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 
 namespace RoadSim::Core {
 
-Scene::Scene(const std::string& name) : m_name(name) {
+Scene::Scene(const std::string& name) 
+    : m_name(name), m_transformStore(std::make_unique<TransformStore>()) {
     std::cout << "[Scene] Created scene: " << m_name << std::endl;
 }
 
@@ -15,7 +20,7 @@ Scene::~Scene() {
 }
 
 GameObject* Scene::createGameObject(const std::string& name) {
-    auto gameObject = std::make_unique<GameObject>(name);
+    auto gameObject = std::make_unique<GameObject>(name, m_transformStore.get());
     GameObject* ptr = gameObject.get();
     
     m_gameObjectsById[ptr->getId()] = ptr;
@@ -109,6 +114,7 @@ std::vector<GameObject*> Scene::getAllGameObjects() const {
 void Scene::update(float deltaTime) {
     if (!m_active) return;
     
+    ROADSIM_TRACE_SCOPE("Scene", "Scene::update");
     auto startTime = std::chrono::high_resolution_clock::now();
     
     // Update all active GameObjects
@@ -118,6 +124,9 @@ void Scene::update(float deltaTime) {
         }
     }
     
+    // Rebuild the matrices of everything that moved in one batch
+    m_transformStore->updateMatrices();
+    
     auto endTime = std::chrono::high_resolution_clock::now();
     m_statistics.lastUpdateTime = std::chrono::duration<double>(endTime - startTime).count();
     
@@ -127,6 +136,7 @@ void Scene::update(float deltaTime) {
 void Scene::fixedUpdate(float deltaTime) {
     if (!m_active) return;
     
+    ROADSIM_TRACE_SCOPE("Scene", "Scene::fixedUpdate");
     auto startTime = std::chrono::high_resolution_clock::now();
     
     // Fixed update for all active GameObjects
@@ -136,6 +146,8 @@ void Scene::fixedUpdate(float deltaTime) {
         }
     }
     
+    m_transformStore->updateMatrices();
+    
     auto endTime = std::chrono::high_resolution_clock::now();
     m_statistics.lastFixedUpdateTime = std::chrono::duration<double>(endTime - startTime).count();
 }
@@ -165,4 +177,29 @@ void Scene::updateStatistics() const {
     }
 }
 
+void Scene::hashState(StateHasher& hasher, bool quantize) const {
+    auto addValue = [&hasher, quantize](float value) {
+        if (quantize) {
+            // Same Q16.16 step as Fixed, widened so world coordinates do not overflow
+            hasher.add(static_cast<uint64_t>(std::llround(static_cast<double>(value) * Fixed::One)));
+        } else {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            hasher.add(bits);
+        }
+    };
+    
+    hasher.add(m_gameObjects.size());
+    forEachGameObject([&](const GameObject& gameObject) {
+        hasher.add(gameObject.isActive() ? 1 : 0);
+        const sf::Vector2f position = gameObject.getPosition();
+        const sf::Vector2f scale = gameObject.getScale();
+        addValue(position.x);
+        addValue(position.y);
+        addValue(gameObject.getRotation());
+        addValue(scale.x);
+        addValue(scale.y);
+    });
+}
+
 } // namespace RoadSim::Core
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "GameObject.h"
+#include "StateHasher.h"
+#include "TransformStore.h"
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -86,6 +88,19 @@ public:
         return result;
     }
     
+    /**
+     * @brief Visit every GameObject without building a list
+     * @param visitor Called with each GameObject, in creation order
+     */
+    template<typename F>
+    void forEachGameObject(F&& visitor) const {
+        for (const auto& gameObject : m_gameObjects) {
+            if (gameObject) {
+                visitor(static_cast<const GameObject&>(*gameObject));
+            }
+        }
+    }
+    
     /**
      * @brief Find all GameObjects matching a predicate
      * @param predicate Function that returns true for matching GameObjects
@@ -116,11 +131,25 @@ public:
      */
     void fixedUpdate(float deltaTime);
     
+    /**
+     * @brief Add the state of every GameObject to a replay hash
+     * Objects are visited in creation order; ids are left out since they
+     * depend on how many objects the process created before.
+     * @param quantize Hash positions, rotations and scales on the Q16.16 grid
+     *                 instead of raw float bits (fixed-point replays)
+     */
+    void hashState(StateHasher& hasher, bool quantize) const;
+    
     /**
      * @brief Clear all GameObjects from the scene
      */
     void clear();
     
+    /**
+     * @brief Get the store holding the transforms of this scene's GameObjects
+     */
+    TransformStore& getTransformStore() { return *m_transformStore; }
+    
     /**
      * @brief Get scene name
      */
@@ -158,6 +187,9 @@ private:
     std::string m_name;
     bool m_active = true;
     
+    // Declared before the GameObjects so it outlives their Transforms
+    std::unique_ptr<TransformStore> m_transformStore;
+    
     std::vector<std::unique_ptr<GameObject>> m_gameObjects;
     std::unordered_map<size_t, GameObject*> m_gameObjectsById;
     
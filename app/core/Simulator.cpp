@@ -1,13 +1,57 @@
 #include "Simulator.h"
+#include "FixedPoint.h"
+#include "StateHasher.h"
+#include "Trace.h"
 #include <iostream>
+#include <cstring>
+#include <array>
 
 namespace RoadSim::Core {
 
+namespace {
+
+enum class Phase : size_t {
+    Step,
+    Tick,
+    Behaviours,
+    StateHash,
+    Count
+};
+
+constexpr const char* PhaseNames[] = {"Step", "Tick", "Behaviours", "StateHash"};
+
+} // namespace
+
 struct Simulator::Impl {
     bool running = false;
     bool paused = false;
     double currentTime = 0.0;
     
+    // Deterministic mode
+    NumericMode numericMode = NumericMode::FloatingPoint;
+    Fixed fixedTimeStep = Fixed::fromDouble(1.0 / 60.0);
+    double stepAccumulator = 0.0;
+    uint64_t tickCount = 0;
+    TickCallback tickCallback;
+    StateHashSource stateHashSource;
+    
+    // Hardware counters, owned by the thread running step()
+    bool hardwareCountersEnabled = false;
+    std::unique_ptr<PerfCounters> perfCounters;
+    std::array<PerfPhase, static_cast<size_t>(Phase::Count)> perfPhases;
+    
+    PerfPhase* perfPhase(Phase phase) {
+        if (!hardwareCountersEnabled || !perfCounters || !perfCounters->isAvailable()) return nullptr;
+        return &perfPhases[static_cast<size_t>(phase)];
+    }
+    
+    // Replay verification
+    uint64_t hashInterval = 0;
+    std::vector<uint64_t> stateHashes;
+    
+    void advanceTick(Simulator& simulator, double tickSeconds);
+    void reset();
+    
     // TODO: Add simulation entities
     // std::vector<std::unique_ptr<Entity>> entities;
     // std::unique_ptr<Map> map;
@@ -24,7 +68,7 @@ Simulator::~Simulator() {
 
 void Simulator::initialize() {
     std::cout << "[Core] Simulator initialized" << std::endl;
-    m_impl->currentTime = 0.0;
+    m_impl->reset();
     m_impl->running = false;
     m_impl->paused = false;
     
@@ -40,13 +84,68 @@ void Simulator::step(float deltaTime) {
         return;
     }
     
-    m_impl->currentTime += deltaTime;
+    ROADSIM_TRACE_SCOPE("Simulator", "Simulator::step");
+    
+    if (m_impl->hardwareCountersEnabled && !m_impl->perfCounters) {
+        m_impl->perfCounters = std::make_unique<PerfCounters>();
+        if (!m_impl->perfCounters->isAvailable()) {
+            std::cerr << "[Core] Hardware counters unavailable: " << m_impl->perfCounters->getError() << std::endl;
+        }
+    }
+    PerfScope perfScope(m_impl->perfCounters.get(), m_impl->perfPhase(Phase::Step));
+    
+    if (m_impl->numericMode == NumericMode::FloatingPoint) {
+        m_impl->advanceTick(*this, deltaTime);
+        return;
+    }
+    
+    // Fixed-point mode: wall-clock time only decides how many whole ticks run,
+    // the ticks themselves are identical on every machine
+    m_impl->stepAccumulator += deltaTime;
+    const double tickSeconds = m_impl->fixedTimeStep.toDouble();
+    
+    while (m_impl->stepAccumulator >= tickSeconds) {
+        m_impl->stepAccumulator -= tickSeconds;
+        m_impl->advanceTick(*this, tickSeconds);
+    }
+}
+
+void Simulator::Impl::advanceTick(Simulator& simulator, double tickSeconds) {
+    ROADSIM_TRACE_SCOPE("Simulator", "Tick");
+    PerfScope perfScope(perfCounters.get(), perfPhase(Phase::Tick));
+    tickCount++;
+    
+    if (numericMode == NumericMode::FixedPoint) {
+        // Derive time from the tick count so it never accumulates rounding error
+        currentTime = static_cast<double>(tickCount) * fixedTimeStep.toDouble();
+    } else {
+        currentTime += tickSeconds;
+    }
     
     // TODO: Implement simulation step
     // - Update all entities (vehicles, pedestrians, cyclists)
     // - Process traffic light states
     // - Handle collisions and constraints
     // - Update metrics
+    
+    if (tickCallback) {
+        ROADSIM_TRACE_SCOPE("Simulator", "TickCallback");
+        PerfScope callbackScope(perfCounters.get(), perfPhase(Phase::Behaviours));
+        tickCallback(tickCount, currentTime);
+    }
+    
+    if (hashInterval > 0 && tickCount % hashInterval == 0) {
+        ROADSIM_TRACE_SCOPE("Simulator", "StateHash");
+        PerfScope hashScope(perfCounters.get(), perfPhase(Phase::StateHash));
+        stateHashes.push_back(simulator.computeStateHash());
+    }
+}
+
+void Simulator::Impl::reset() {
+    currentTime = 0.0;
+    stepAccumulator = 0.0;
+    tickCount = 0;
+    stateHashes.clear();
 }
 
 void Simulator::start() {
@@ -64,7 +163,7 @@ void Simulator::stop() {
     std::cout << "[Core] Simulation stopped" << std::endl;
     m_impl->running = false;
     m_impl->paused = false;
-    m_impl->currentTime = 0.0;
+    m_impl->reset();
 }
 
 bool Simulator::isRunning() const {
@@ -75,4 +174,106 @@ double Simulator::getCurrentTime() const {
     return m_impl->currentTime;
 }
 
+void Simulator::setNumericMode(NumericMode mode) {
+    std::cout << "[Core] Simulator numeric mode: " 
+              << (mode == NumericMode::FixedPoint ? "fixed-point" : "floating-point") << std::endl;
+    m_impl->numericMode = mode;
+    m_impl->reset();
+}
+
+Simulator::NumericMode Simulator::getNumericMode() const {
+    return m_impl->numericMode;
+}
+
+void Simulator::setFixedTimeStep(double seconds) {
+    Fixed step = Fixed::fromDouble(seconds);
+    if (step.raw() <= 0) {
+        std::cerr << "[Core] Invalid fixed time step: " << seconds << std::endl;
+        return;
+    }
+    m_impl->fixedTimeStep = step;
+}
+
+uint64_t Simulator::getTickCount() const {
+    return m_impl->tickCount;
+}
+
+void Simulator::setTickCallback(TickCallback callback) {
+    m_impl->tickCallback = std::move(callback);
+}
+
+void Simulator::setHardwareCountersEnabled(bool enabled) {
+    m_impl->hardwareCountersEnabled = enabled;
+    std::cout << "[Core] Hardware counters " << (enabled ? "enabled" : "disabled") << std::endl;
+}
+
+std::vector<Simulator::PhaseCounters> Simulator::getPhaseCounters() const {
+    std::vector<PhaseCounters> result;
+    if (!m_impl->hardwareCountersEnabled || !m_impl->perfCounters || !m_impl->perfCounters->isAvailable()) {
+        return result;
+    }
+    
+    for (size_t i = 0; i < m_impl->perfPhases.size(); ++i) {
+        result.push_back({PhaseNames[i], m_impl->perfPhases[i].total, m_impl->perfPhases[i].calls});
+    }
+    return result;
+}
+
+void Simulator::resetPhaseCounters() {
+    m_impl->perfPhases.fill({});
+}
+
+uint64_t Simulator::computeStateHash() const {
+    StateHasher hasher;
+    hasher.add(static_cast<uint64_t>(m_impl->numericMode));
+    hasher.add(m_impl->tickCount);
+    
+    if (m_impl->numericMode == NumericMode::FixedPoint) {
+        hasher.add(static_cast<uint32_t>(m_impl->fixedTimeStep.raw()));
+    } else {
+        uint64_t timeBits = 0;
+        std::memcpy(&timeBits, &m_impl->currentTime, sizeof(timeBits));
+        hasher.add(timeBits);
+    }
+    
+    if (m_impl->stateHashSource) {
+        m_impl->stateHashSource(hasher, m_impl->numericMode);
+    }
+    
+    return hasher.get();
+}
+
+void Simulator::setStateHashSource(StateHashSource source) {
+    m_impl->stateHashSource = std::move(source);
+}
+
+void Simulator::setStateHashInterval(uint64_t ticks) {
+    m_impl->hashInterval = ticks;
+}
+
+const std::vector<uint64_t>& Simulator::getStateHashes() const {
+    return m_impl->stateHashes;
+}
+
+bool Simulator::verifyStateHashes(const std::vector<uint64_t>& goldenHashes) const {
+    const auto& recorded = m_impl->stateHashes;
+    
+    if (recorded.size() != goldenHashes.size()) {
+        std::cerr << "[Core] State hash count mismatch: recorded " << recorded.size()
+                  << ", expected " << goldenHashes.size() << std::endl;
+        return false;
+    }
+    
+    for (size_t i = 0; i < recorded.size(); ++i) {
+        if (recorded[i] != goldenHashes[i]) {
+            std::cerr << "[Core] State diverged at tick " << (i + 1) * m_impl->hashInterval
+                      << ": hash " << std::hex << recorded[i] << " != " << goldenHashes[i] 
+                      << std::dec << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
 } // namespace RoadSim::Core
\ No newline at end of file
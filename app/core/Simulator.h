@@ -2,9 +2,14 @@
 
 #include <memory>
 #include <vector>
+#include <cstdint>
+#include <functional>
+#include "PerfCounters.h"
 
 namespace RoadSim::Core {
 
+class StateHasher;
+
 /**
  * @brief Main simulation engine with fixed time step
  * Handles deterministic simulation of traffic entities
@@ -58,6 +63,115 @@ public:
      */
     double getCurrentTime() const;
     
+    /**
+     * @brief Numeric representation used for simulation state
+     */
+    enum class NumericMode {
+        FloatingPoint,  // Variable step, float state (default)
+        FixedPoint      // Fixed tick, Q16.16 state, bit-exact replays
+    };
+    
+    /**
+     * @brief Select the numeric mode (resets tick count and recorded hashes)
+     * @param mode Numeric mode to use
+     */
+    void setNumericMode(NumericMode mode);
+    
+    /**
+     * @brief Get current numeric mode
+     */
+    NumericMode getNumericMode() const;
+    
+    /**
+     * @brief Set the tick length used in fixed-point mode
+     * @param seconds Tick length in seconds (quantized to Q16.16)
+     */
+    void setFixedTimeStep(double seconds);
+    
+    /**
+     * @brief Get number of simulation ticks executed since start
+     */
+    uint64_t getTickCount() const;
+    
+    /**
+     * @brief Callback invoked at the end of every simulation tick
+     * @param tick Tick number (starting at 1)
+     * @param time Simulation time after the tick in seconds
+     */
+    using TickCallback = std::function<void(uint64_t tick, double time)>;
+    
+    /**
+     * @brief Set the callback run after each tick (e.g. to step agent behaviours)
+     * @param callback Callback to invoke, or nullptr to clear
+     */
+    void setTickCallback(TickCallback callback);
+    
+    /**
+     * @brief Count hardware events per simulation phase (Linux perf_event_open)
+     * Counters are opened on the thread running step(); when they are
+     * unavailable the request is logged once and phases stay empty.
+     * @param enabled Counter state
+     */
+    void setHardwareCountersEnabled(bool enabled);
+    
+    /**
+     * @brief Hardware counter totals of one simulation phase
+     * Phases nest: Step includes Tick, which includes Behaviours and StateHash
+     */
+    struct PhaseCounters {
+        const char* name = "";
+        PerfSample counters;
+        uint64_t calls = 0;
+    };
+    
+    /**
+     * @brief Get per-phase counter totals (empty when counters are off or unavailable)
+     */
+    std::vector<PhaseCounters> getPhaseCounters() const;
+    
+    /**
+     * @brief Reset per-phase counter totals
+     */
+    void resetPhaseCounters();
+    
+    /**
+     * @brief Compute a hash of the full simulation state
+     * Covers the clock plus whatever the state hash source adds (entities).
+     * Only integer and fixed-point state is hashed in fixed-point mode
+     */
+    uint64_t computeStateHash() const;
+    
+    /**
+     * @brief Feeds the entity state into a state hash
+     * Called with the hasher and the current numeric mode; in fixed-point
+     * mode it must add quantized values only.
+     */
+    using StateHashSource = std::function<void(StateHasher& hasher, NumericMode mode)>;
+    
+    /**
+     * @brief Set the source of entity state for computeStateHash (e.g. the scene)
+     * @param source Source to use, or nullptr to hash the clock only
+     */
+    void setStateHashSource(StateHashSource source);
+    
+    /**
+     * @brief Record the state hash every N ticks (0 disables recording)
+     * @param ticks Number of ticks between recorded hashes
+     */
+    void setStateHashInterval(uint64_t ticks);
+    
+    /**
+     * @brief Get state hashes recorded so far
+     */
+    const std::vector<uint64_t>& getStateHashes() const;
+    
+    /**
+     * @brief Compare recorded state hashes against golden hashes of a reference run
+     * @param goldenHashes Hashes recorded by the reference run
+     * @return True if every recorded hash matches
+     */
+    bool verifyStateHashes(const std::vector<uint64_t>& goldenHashes) const;
+    
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
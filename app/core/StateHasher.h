@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace RoadSim::Core {
+
+/**
+ * @brief FNV-1a hash over 64-bit words used for replay verification
+ * Words are fed in little-endian byte order so hashes match across platforms.
+ */
+class StateHasher {
+public:
+    void add(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            m_hash ^= static_cast<uint8_t>(value >> (i * 8));
+            m_hash *= 1099511628211ull;
+        }
+    }
+    
+    uint64_t get() const { return m_hash; }
+    
+private:
+    uint64_t m_hash = 14695981039346656037ull;
+};
+
+} // namespace RoadSim::Core
@@ -0,0 +1,211 @@
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RoadSim::Core {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Fields are relaxed atomics so an export racing with the writer is well defined
+struct TraceEvent {
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> startNs{0};
+    std::atomic<int64_t> durationNs{0};
+};
+
+struct ThreadBuffer {
+    uint32_t threadId = 0;
+    std::string threadName; // Guarded by the registry mutex
+    std::unique_ptr<TraceEvent[]> events = std::make_unique<TraceEvent[]>(Trace::EventsPerThread);
+    std::atomic<uint64_t> written{0};   // Only the owning thread writes
+    std::atomic<uint64_t> clearedAt{0}; // Events before this index were cleared
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    Clock::time_point epoch = Clock::now();
+    std::atomic<bool> enabled{true};
+};
+
+Registry& registry() {
+    // Never destroyed: threads may still record while statics are torn down
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->threadId = static_cast<uint32_t>(reg.buffers.size() + 1);
+        buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+        t_buffer = buffer.get();
+        reg.buffers.push_back(std::move(buffer));
+    }
+    return *t_buffer;
+}
+
+void appendEscaped(std::string& out, const char* text) {
+    for (const char* c = text ? text : ""; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        if (static_cast<unsigned char>(*c) < 0x20) continue;
+        out += *c;
+    }
+}
+
+void appendMicroseconds(std::string& out, int64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", static_cast<double>(ns) / 1000.0);
+    out += text;
+}
+
+} // namespace
+
+bool Trace::isCompiledIn() {
+#ifdef ROADSIM_ENABLE_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Trace::setEnabled(bool enabled) {
+    registry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Trace::isEnabled() {
+    return registry().enabled.load(std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    buffer.threadName = name;
+}
+
+void Trace::record(const char* category, const char* name, int64_t startNs, int64_t endNs) {
+    if (!registry().enabled.load(std::memory_order_relaxed)) return;
+    
+    ThreadBuffer& buffer = threadBuffer();
+    const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer.events[index % EventsPerThread];
+    
+    event.category.store(category, std::memory_order_relaxed);
+    event.name.store(name, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    
+    // Publish the event to exporters
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+int64_t Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - registry().epoch).count();
+}
+
+std::string Trace::toChromeTraceJson() {
+    struct Span {
+        const char* category;
+        const char* name;
+        int64_t startNs;
+        int64_t durationNs;
+    };
+    
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    
+    std::string out;
+    out.reserve(1024);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"RoadSim\"}}";
+    
+    std::vector<Span> spans;
+    for (const auto& buffer : reg.buffers) {
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += std::to_string(buffer->threadId);
+        out += ",\"args\":{\"name\":\"";
+        appendEscaped(out, buffer->threadName.c_str());
+        out += "\"}}";
+        
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = std::max(buffer->clearedAt.load(std::memory_order_relaxed),
+                                  written > EventsPerThread ? written - EventsPerThread : 0);
+        
+        spans.clear();
+        for (uint64_t i = begin; i < written; ++i) {
+            const TraceEvent& event = buffer->events[i % EventsPerThread];
+            spans.push_back({event.category.load(std::memory_order_relaxed),
+                             event.name.load(std::memory_order_relaxed),
+                             event.startNs.load(std::memory_order_relaxed),
+                             event.durationNs.load(std::memory_order_relaxed)});
+        }
+        
+        // Drop spans the writer may have overwritten while they were copied. The
+        // fence keeps the relaxed copies above from moving past the reload, and
+        // the writer may already be filling slot writtenAfter % EventsPerThread,
+        // which held span writtenAfter - EventsPerThread
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t writtenAfter = buffer->written.load(std::memory_order_relaxed);
+        const uint64_t firstValid = writtenAfter + 1 > EventsPerThread ? writtenAfter + 1 - EventsPerThread : 0;
+        const size_t skip = static_cast<size_t>(std::min<uint64_t>(firstValid > begin ? firstValid - begin : 0, spans.size()));
+        
+        for (size_t i = skip; i < spans.size(); ++i) {
+            const Span& span = spans[i];
+            out += ",\n{\"name\":\"";
+            appendEscaped(out, span.name);
+            out += "\",\"cat\":\"";
+            appendEscaped(out, span.category);
+            out += "\",\"ph\":\"X\",\"ts\":";
+            appendMicroseconds(out, span.startNs);
+            out += ",\"dur\":";
+            appendMicroseconds(out, span.durationNs);
+            out += ",\"pid\":1,\"tid\":";
+            out += std::to_string(buffer->threadId);
+            out += "}";
+        }
+    }
+    
+    out += "\n]}\n";
+    return out;
+}
+
+bool Trace::exportChromeTrace(const std::string& filePath) {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[Core] Failed to open trace file: " << filePath << std::endl;
+        return false;
+    }
+    
+    file << toChromeTraceJson();
+    if (!file) {
+        std::cerr << "[Core] Failed to write trace file: " << filePath << std::endl;
+        return false;
+    }
+    
+    std::cout << "[Core] Trace exported to " << filePath << std::endl;
+    return true;
+}
+
+void Trace::clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        buffer->clearedAt.store(buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+} // namespace RoadSim::Core
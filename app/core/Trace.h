@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace RoadSim::Core {
+
+/**
+ * @brief Span tracing with Chrome trace (chrome://tracing, Perfetto) export
+ * Each thread records complete spans into its own fixed-size ring, written
+ * without locks; the oldest spans are overwritten when a ring is full.
+ * Instrument code with ROADSIM_TRACE_SCOPE, which compiles to nothing unless
+ * ROADSIM_ENABLE_TRACING is defined (CMake option ROADSIM_TRACING).
+ */
+class Trace {
+public:
+    static constexpr size_t EventsPerThread = 1 << 16;
+    
+    /**
+     * @brief Check whether the tracing macros are compiled in
+     */
+    static bool isCompiledIn();
+    
+    /**
+     * @brief Pause or resume recording at runtime (enabled by default)
+     * @param enabled Recording state
+     */
+    static void setEnabled(bool enabled);
+    
+    static bool isEnabled();
+    
+    /**
+     * @brief Name the calling thread in exported traces
+     * @param name Thread name
+     */
+    static void setThreadName(const std::string& name);
+    
+    /**
+     * @brief Record a completed span on the calling thread
+     * @param category Span category (string literal)
+     * @param name Span name (string literal)
+     * @param startNs Start time from now()
+     * @param endNs End time from now()
+     */
+    static void record(const char* category, const char* name, int64_t startNs, int64_t endNs);
+    
+    /**
+     * @brief Nanoseconds since the trace epoch
+     */
+    static int64_t now();
+    
+    /**
+     * @brief Build Chrome trace JSON from every thread's buffer
+     */
+    static std::string toChromeTraceJson();
+    
+    /**
+     * @brief Write Chrome trace JSON to a file
+     * @param filePath Output path
+     * @return True on success
+     */
+    static bool exportChromeTrace(const std::string& filePath);
+    
+    /**
+     * @brief Drop all recorded spans
+     */
+    static void clear();
+};
+
+/**
+ * @brief Records a span from construction to destruction
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(category), m_name(name), m_start(Trace::now()) {}
+    
+    ~TraceScope() {
+        Trace::record(m_category, m_name, m_start, Trace::now());
+    }
+    
+    // Non-copyable
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    
+private:
+    const char* m_category;
+    const char* m_name;
+    int64_t m_start;
+};
+
+} // namespace RoadSim::Core
+
+#ifdef ROADSIM_ENABLE_TRACING
+#define ROADSIM_TRACE_CONCAT_INNER(a, b) a##b
+#define ROADSIM_TRACE_CONCAT(a, b) ROADSIM_TRACE_CONCAT_INNER(a, b)
+#define ROADSIM_TRACE_SCOPE(category, name) \
+    ::RoadSim::Core::TraceScope ROADSIM_TRACE_CONCAT(roadsimTraceScope, __LINE__)(category, name)
+#define ROADSIM_TRACE_THREAD_NAME(name) ::RoadSim::Core::Trace::setThreadName(name)
+#else
+#define ROADSIM_TRACE_SCOPE(category, name) ((void)0)
+#define ROADSIM_TRACE_THREAD_NAME(name) ((void)0)
+#endif
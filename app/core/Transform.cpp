@@ -1,34 +1,33 @@
 #include "Transform.h"
-#include <cmath>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
 
 namespace RoadSim::Core {
 
 Transform::Transform(const sf::Vector2f& position, float rotation, const sf::Vector2f& scale)
-    : m_position(position), m_rotation(rotation), m_scale(scale) {
+    : Transform(TransformStore::getDefault(), position, rotation, scale) {
 }
 
+Transform::Transform(TransformStore& store, const sf::Vector2f& position, float rotation, const sf::Vector2f& scale)
+    : m_store(&store), m_handle(store.allocate(position, rotation, scale)) {
+}
 
+Transform::~Transform() {
+    m_store->release(m_handle);
+}
 
 sf::Vector2f Transform::getForward() const {
-    float radians = m_rotation * static_cast<float>(M_PI) / 180.0f;
-    return sf::Vector2f(std::cos(radians), std::sin(radians));
+    ensureUpToDate();
+    return m_store->getDirection(m_handle);
 }
 
 sf::Vector2f Transform::getRight() const {
-    float radians = (m_rotation + 90.0f) * static_cast<float>(M_PI) / 180.0f;
-    return sf::Vector2f(std::cos(radians), std::sin(radians));
+    ensureUpToDate();
+    sf::Vector2f forward = m_store->getDirection(m_handle);
+    return sf::Vector2f(-forward.y, forward.x);
 }
 
 const sf::Transform& Transform::getTransformMatrix() const {
-    if (m_transformDirty) {
-        updateTransformMatrix();
-        m_transformDirty = false;
-    }
-    return m_transformMatrix;
+    ensureUpToDate();
+    return m_store->getMatrix(m_handle);
 }
 
 sf::Vector2f Transform::transformPoint(const sf::Vector2f& localPoint) const {
@@ -36,16 +35,15 @@ sf::Vector2f Transform::transformPoint(const sf::Vector2f& localPoint) const {
 }
 
 sf::Vector2f Transform::inverseTransformPoint(const sf::Vector2f& worldPoint) const {
-    return getTransformMatrix().getInverse().transformPoint(worldPoint);
+    ensureUpToDate();
+    return m_store->getInverse(m_handle).transformPoint(worldPoint);
 }
 
-void Transform::updateTransformMatrix() const {
-    m_transformMatrix = sf::Transform::Identity;
-    
-    // Apply transformations in order: scale, rotate, translate
-    m_transformMatrix.scale(m_scale);
-    m_transformMatrix.rotate(m_rotation);
-    m_transformMatrix.translate(m_position);
+void Transform::ensureUpToDate() const {
+    // Flushes every pending change in the store, not just this one
+    if (m_store->isDirty(m_handle)) {
+        m_store->updateMatrices();
+    }
 }
 
-} // namespace RoadSim::Core
\ No newline at end of file
+} // namespace RoadSim::Core
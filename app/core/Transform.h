@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Component.h"
+#include "TransformStore.h"
+#include "FixedPoint.h"
+#include <cmath>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
@@ -8,7 +11,8 @@ namespace RoadSim::Core {
 
 /**
  * @brief Transform component for position, rotation, and scale
- * Essential component for spatial representation of GameObjects
+ * Essential component for spatial representation of GameObjects.
+ * Data lives in a TransformStore so matrices are rebuilt in batches.
  */
 class Transform : public Component {
 public:
@@ -16,19 +20,23 @@ public:
               float rotation = 0.0f, 
               const sf::Vector2f& scale = {1.0f, 1.0f});
     
-    virtual ~Transform() = default;
+    Transform(TransformStore& store,
+              const sf::Vector2f& position = {0.0f, 0.0f}, 
+              float rotation = 0.0f, 
+              const sf::Vector2f& scale = {1.0f, 1.0f});
+    
+    virtual ~Transform();
     
     /**
      * @brief Get world position
      */
-    const sf::Vector2f& getPosition() const { return m_position; }
+    sf::Vector2f getPosition() const { return m_store->getPosition(m_handle); }
     
     /**
      * @brief Set world position
      */
     void setPosition(const sf::Vector2f& position) { 
-        m_position = position;
-        m_transformDirty = true;
+        m_store->setPosition(m_handle, position);
     }
     
     /**
@@ -42,42 +50,38 @@ public:
      * @brief Translate by offset
      */
     void translate(const sf::Vector2f& offset) {
-        m_position += offset;
-        m_transformDirty = true;
+        m_store->setPosition(m_handle, getPosition() + offset);
     }
     
     /**
      * @brief Get rotation in degrees
      */
-    float getRotation() const { return m_rotation; }
+    float getRotation() const { return m_store->getRotation(m_handle); }
     
     /**
      * @brief Set rotation in degrees
      */
     void setRotation(float rotation) { 
-        m_rotation = rotation;
-        m_transformDirty = true;
+        m_store->setRotation(m_handle, rotation);
     }
     
     /**
      * @brief Rotate by angle in degrees
      */
     void rotate(float angle) {
-        m_rotation += angle;
-        m_transformDirty = true;
+        m_store->setRotation(m_handle, getRotation() + angle);
     }
     
     /**
      * @brief Get scale
      */
-    const sf::Vector2f& getScale() const { return m_scale; }
+    sf::Vector2f getScale() const { return m_store->getScale(m_handle); }
     
     /**
      * @brief Set scale
      */
     void setScale(const sf::Vector2f& scale) { 
-        m_scale = scale;
-        m_transformDirty = true;
+        m_store->setScale(m_handle, scale);
     }
     
     /**
@@ -97,8 +101,18 @@ public:
      */
     sf::Vector2f getRight() const;
     
+    /**
+     * @brief Get forward direction using deterministic fixed-point trigonometry
+     * Bit-identical on every platform, for use by the fixed-point simulation mode.
+     * The rotation is reduced to one turn first; Fixed only reaches +/-32768.
+     */
+    FixedVec2 getForwardFixed() const {
+        return FixedTrig::direction(Fixed::fromFloat(std::fmod(getRotation(), 360.0f)));
+    }
+    
     /**
      * @brief Get SFML transform matrix for rendering
+     * The reference stays valid until another transform is created in the same store
      */
     const sf::Transform& getTransformMatrix() const;
     
@@ -116,15 +130,10 @@ public:
     std::string getTypeName() const override { return "Transform"; }
     
 private:
-    sf::Vector2f m_position;
-    float m_rotation; // in degrees
-    sf::Vector2f m_scale;
-    
-    // Cached transform matrix
-    mutable sf::Transform m_transformMatrix;
-    mutable bool m_transformDirty = true;
+    TransformStore* m_store;
+    TransformHandle m_handle;
     
-    void updateTransformMatrix() const;
+    void ensureUpToDate() const;
 };
 
 } // namespace RoadSim::Core
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "TransformStore.h"
+#include <cmath>
+
+namespace RoadSim::Core {
+
+TransformStore::TransformStore() = default;
+
+TransformStore::~TransformStore() = default;
+
+TransformStore& TransformStore::getDefault() {
+    thread_local TransformStore defaultStore;
+    return defaultStore;
+}
+
+TransformHandle TransformStore::allocate(const sf::Vector2f& position, float rotation, const sf::Vector2f& scale) {
+    TransformHandle handle;
+    
+    if (!m_freeSlots.empty()) {
+        handle = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_positions[handle] = position;
+        m_rotations[handle] = rotation;
+        m_scales[handle] = scale;
+    } else {
+        handle = static_cast<TransformHandle>(m_positions.size());
+        m_positions.push_back(position);
+        m_rotations.push_back(rotation);
+        m_scales.push_back(scale);
+        m_matrices.emplace_back();
+        m_inverses.emplace_back();
+        m_sin.push_back(0.0f);
+        m_cos.push_back(1.0f);
+        m_dirty.push_back(0);
+    }
+    
+    markDirty(handle);
+    return handle;
+}
+
+void TransformStore::release(TransformHandle handle) {
+    if (handle >= m_positions.size()) return;
+    
+    // A released slot may still sit in the dirty list; clearing its flag makes
+    // updateMatrices() skip that entry, and a reused slot is queued afresh
+    m_dirty[handle] = 0;
+    m_freeSlots.push_back(handle);
+}
+
+void TransformStore::reserve(size_t capacity) {
+    m_positions.reserve(capacity);
+    m_rotations.reserve(capacity);
+    m_scales.reserve(capacity);
+    m_matrices.reserve(capacity);
+    m_inverses.reserve(capacity);
+    m_sin.reserve(capacity);
+    m_cos.reserve(capacity);
+    m_dirty.reserve(capacity);
+    m_dirtyList.reserve(capacity);
+}
+
+void TransformStore::updateMatrices() {
+    // Keep each flagged slot once: released slots have a clear flag, and a slot
+    // released and reused before this call was queued twice
+    size_t count = 0;
+    for (const TransformHandle handle : m_dirtyList) {
+        if (!m_dirty[handle]) continue;
+        m_dirty[handle] = 0;
+        m_dirtyList[count++] = handle;
+    }
+    m_dirtyList.resize(count);
+    if (count == 0) return;
+    
+    // Gather rotations of dirty slots so the trigonometry runs over contiguous data
+    m_angleScratch.resize(count);
+    m_sinScratch.resize(count);
+    m_cosScratch.resize(count);
+    
+    for (size_t i = 0; i < count; ++i) {
+        m_angleScratch[i] = m_rotations[m_dirtyList[i]];
+    }
+    
+    sinCosDegrees(m_angleScratch.data(), m_sinScratch.data(), m_cosScratch.data(), count);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const TransformHandle handle = m_dirtyList[i];
+        const float sine = m_sinScratch[i];
+        const float cosine = m_cosScratch[i];
+        const sf::Vector2f& position = m_positions[handle];
+        const sf::Vector2f& scale = m_scales[handle];
+        
+        m_sin[handle] = sine;
+        m_cos[handle] = cosine;
+        
+        // Local to world: scale, then rotate, then translate
+        m_matrices[handle] = sf::Transform(
+            cosine * scale.x, -sine * scale.y, position.x,
+            sine * scale.x,    cosine * scale.y, position.y,
+            0.0f,              0.0f,             1.0f);
+        
+        // World to local, inverted analytically; degenerate scale gives identity
+        if (scale.x != 0.0f && scale.y != 0.0f) {
+            const float invScaleX = 1.0f / scale.x;
+            const float invScaleY = 1.0f / scale.y;
+            const float a00 = cosine * invScaleX;
+            const float a01 = sine * invScaleX;
+            const float a10 = -sine * invScaleY;
+            const float a11 = cosine * invScaleY;
+            
+            m_inverses[handle] = sf::Transform(
+                a00,  a01,  -(a00 * position.x + a01 * position.y),
+                a10,  a11,  -(a10 * position.x + a11 * position.y),
+                0.0f, 0.0f, 1.0f);
+        } else {
+            m_inverses[handle] = sf::Transform::Identity;
+        }
+    }
+    
+    m_dirtyList.clear();
+}
+
+void TransformStore::sinCosDegrees(const float* degrees, float* sinOut, float* cosOut, size_t count) {
+    constexpr float degToRad = 3.14159265358979323846f / 180.0f;
+    
+    for (size_t i = 0; i < count; ++i) {
+        // Reduce to one turn first (exact in floating point; non-finite angles
+        // count as 0) so the quadrant always fits an int, then to [-45, 45] degrees
+        const float turn = std::isfinite(degrees[i]) ? std::fmod(degrees[i], 360.0f) : 0.0f;
+        const float quadrant = std::floor(turn * (1.0f / 90.0f) + 0.5f);
+        const float x = (turn - quadrant * 90.0f) * degToRad;
+        const float x2 = x * x;
+        
+        // Taylor polynomials, accurate to ~3e-7 on [-pi/4, pi/4]
+        const float s = x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f))));
+        const float c = 1.0f + x2 * (-0.5f + x2 * (1.0f / 24.0f + x2 * (-1.0f / 720.0f + x2 * (1.0f / 40320.0f))));
+        
+        const int q = static_cast<int>(quadrant) & 3;
+        const bool swap = (q & 1) != 0;
+        const float sinSign = (q & 2) ? -1.0f : 1.0f;
+        const float cosSign = ((q + 1) & 2) ? -1.0f : 1.0f;
+        
+        sinOut[i] = sinSign * (swap ? c : s);
+        cosOut[i] = cosSign * (swap ? s : c);
+    }
+}
+
+} // namespace RoadSim::Core
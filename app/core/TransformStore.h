@@ -0,0 +1,151 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace RoadSim::Core {
+
+using TransformHandle = uint32_t;
+
+/**
+ * @brief Contiguous storage for transform data of many objects
+ * Keeps position, rotation and scale in parallel arrays and recomputes
+ * the matrices of all modified slots in a single batched pass
+ */
+class TransformStore {
+public:
+    static constexpr TransformHandle InvalidHandle = UINT32_MAX;
+    
+    TransformStore();
+    ~TransformStore();
+    
+    // Non-copyable
+    TransformStore(const TransformStore&) = delete;
+    TransformStore& operator=(const TransformStore&) = delete;
+    
+    // Movable
+    TransformStore(TransformStore&&) = default;
+    TransformStore& operator=(TransformStore&&) = default;
+    
+    /**
+     * @brief Get the calling thread's store for transforms created outside of a Scene
+     * Each thread gets its own store, so standalone transforms never share
+     * unsynchronised arrays across threads; they must not outlive the thread
+     * that created them.
+     */
+    static TransformStore& getDefault();
+    
+    /**
+     * @brief Allocate a slot for a new transform
+     * @return Handle identifying the slot
+     */
+    TransformHandle allocate(const sf::Vector2f& position, float rotation, const sf::Vector2f& scale);
+    
+    /**
+     * @brief Release a slot so it can be reused
+     * @param handle Slot to release
+     */
+    void release(TransformHandle handle);
+    
+    /**
+     * @brief Reserve capacity for a number of transforms
+     * @param capacity Expected number of live transforms
+     */
+    void reserve(size_t capacity);
+    
+    // Returned by value: allocate() may move the arrays
+    sf::Vector2f getPosition(TransformHandle handle) const { return m_positions[handle]; }
+    float getRotation(TransformHandle handle) const { return m_rotations[handle]; }
+    sf::Vector2f getScale(TransformHandle handle) const { return m_scales[handle]; }
+    
+    void setPosition(TransformHandle handle, const sf::Vector2f& position) {
+        m_positions[handle] = position;
+        markDirty(handle);
+    }
+    
+    void setRotation(TransformHandle handle, float rotation) {
+        m_rotations[handle] = rotation;
+        markDirty(handle);
+    }
+    
+    void setScale(TransformHandle handle, const sf::Vector2f& scale) {
+        m_scales[handle] = scale;
+        markDirty(handle);
+    }
+    
+    /**
+     * @brief Check if the matrices of a slot are out of date
+     */
+    bool isDirty(TransformHandle handle) const { return m_dirty[handle] != 0; }
+    
+    /**
+     * @brief Recompute matrices, inverses and directions of all dirty slots
+     */
+    void updateMatrices();
+    
+    /**
+     * @brief Get cached local-to-world matrix (call updateMatrices first)
+     * The reference is invalidated by the next allocate().
+     */
+    const sf::Transform& getMatrix(TransformHandle handle) const { return m_matrices[handle]; }
+    
+    /**
+     * @brief Get cached world-to-local matrix (call updateMatrices first)
+     * The reference is invalidated by the next allocate().
+     */
+    const sf::Transform& getInverse(TransformHandle handle) const { return m_inverses[handle]; }
+    
+    /**
+     * @brief Get cached unit direction of the rotation (call updateMatrices first)
+     */
+    sf::Vector2f getDirection(TransformHandle handle) const { return {m_cos[handle], m_sin[handle]}; }
+    
+    /**
+     * @brief Get number of live transforms
+     */
+    size_t size() const { return m_positions.size() - m_freeSlots.size(); }
+    
+    /**
+     * @brief Get number of transforms waiting for a matrix update
+     * Until the next updateMatrices(), released slots may still be counted.
+     */
+    size_t getDirtyCount() const { return m_dirtyList.size(); }
+    
+    /**
+     * @brief Compute sine and cosine of angles in degrees
+     * Branch-free polynomial approximation the compiler can vectorize
+     */
+    static void sinCosDegrees(const float* degrees, float* sinOut, float* cosOut, size_t count);
+    
+private:
+    // Source data
+    std::vector<sf::Vector2f> m_positions;
+    std::vector<float> m_rotations; // in degrees
+    std::vector<sf::Vector2f> m_scales;
+    
+    // Derived data, refreshed by updateMatrices
+    std::vector<sf::Transform> m_matrices;
+    std::vector<sf::Transform> m_inverses;
+    std::vector<float> m_sin;
+    std::vector<float> m_cos;
+    
+    std::vector<uint8_t> m_dirty;
+    std::vector<TransformHandle> m_dirtyList;
+    std::vector<TransformHandle> m_freeSlots;
+    
+    // Scratch buffers for the batched trigonometry
+    std::vector<float> m_angleScratch;
+    std::vector<float> m_sinScratch;
+    std::vector<float> m_cosScratch;
+    
+    void markDirty(TransformHandle handle) {
+        if (!m_dirty[handle]) {
+            m_dirty[handle] = 1;
+            m_dirtyList.push_back(handle);
+        }
+    }
+};
+
+} // namespace RoadSim::Core
@@ -1,4 +1,9 @@
 #include "MapEditor.h"
+#include "../core/MapData.h"
+#include "../io/JsonLoader.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
 #include <iostream>
 
 namespace RoadSim::Editor {
@@ -7,13 +12,56 @@ struct MapEditor::Impl {
     bool initialized = false;
     bool hasChanges = false;
     std::string currentMapFile;
+    IO::JsonLoader loader;
     
-    // TODO: Add map data structures
-    // std::vector<Node> nodes;
-    // std::vector<Road> roads;
-    // std::vector<TrafficLight> trafficLights;
-    // std::vector<SpawnPoint> spawnPoints;
+    // Shared with snapshots; never modified while anyone else holds it
+    std::shared_ptr<Core::MapData> map = std::make_shared<Core::MapData>();
+    uint64_t revision = 0;
+    int32_t nextNodeId = 1;
+    int32_t nextRoadId = 1;
+    
+    // TODO: Add selection
     // std::vector<int> selectedElements;
+    
+    // .rsmap files are written in the binary format, anything else as JSON
+    static bool isBinaryPath(const std::string& filepath) {
+        return std::filesystem::path(filepath).extension() == ".rsmap";
+    }
+    
+    // Tables to modify, copied first if a snapshot shares them (all tables at
+    // once; see the class comment).
+    //
+    // use_count() is a relaxed load, so it may be stale, but only in one
+    // direction: only this thread creates snapshots, so other threads can only
+    // lower the count. A stale higher count costs an unneeded copy. A count of
+    // one means every other owner (e.g. the AutoSaver worker) has dropped its
+    // reference; that decrement is a release, and the acquire fence pairs with
+    // it so the owner's reads of the tables happen before our writes.
+    Core::MapData& edit() {
+        if (map.use_count() > 1) {
+            map = std::make_shared<Core::MapData>(*map);
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        ++revision;
+        hasChanges = true;
+        return *map;
+    }
+    
+    void replace(Core::MapData&& tables) {
+        map = std::make_shared<Core::MapData>(std::move(tables));
+        ++revision;
+        
+        nextNodeId = 1;
+        for (const Core::MapNode& node : map->nodes) nextNodeId = std::max(nextNodeId, node.id + 1);
+        nextRoadId = 1;
+        for (const Core::MapRoad& road : map->roads) nextRoadId = std::max(nextRoadId, road.id + 1);
+    }
+    
+    bool hasNode(int32_t nodeId) const {
+        return std::any_of(map->nodes.begin(), map->nodes.end(),
+                           [nodeId](const Core::MapNode& node) { return node.id == nodeId; });
+    }
 };
 
 MapEditor::MapEditor() : m_impl(std::make_unique<Impl>()) {
@@ -26,6 +74,7 @@ MapEditor::~MapEditor() {
 
 void MapEditor::initialize() {
     std::cout << "[Editor] MapEditor initialized" << std::endl;
+    m_impl->loader.initialize();
     m_impl->initialized = true;
     m_impl->hasChanges = false;
     
@@ -45,71 +94,113 @@ void MapEditor::createNewMap() {
 bool MapEditor::loadMap(const std::string& filepath) {
     std::cout << "[Editor] Loading map from: " << filepath << std::endl;
     
-    // TODO: Implement map loading
-    // - Parse JSON/TOML file
-    // - Load nodes, roads, traffic lights
-    // - Load spawn points and configurations
+    // JsonLoader detects binary maps from the file contents
+    Core::MapData loaded;
+    if (!m_impl->loader.loadMapData(filepath, loaded)) {
+        std::cerr << "[Editor] Failed to load map: " << m_impl->loader.getLastError() << std::endl;
+        return false;
+    }
     
+    m_impl->replace(std::move(loaded));
     m_impl->currentMapFile = filepath;
     m_impl->hasChanges = false;
-    return true; // Placeholder
+    return true;
 }
 
 bool MapEditor::saveMap(const std::string& filepath) {
     std::cout << "[Editor] Saving map to: " << filepath << std::endl;
     
-    // TODO: Implement map saving
-    // - Serialize map data to JSON/TOML
-    // - Save nodes, roads, traffic lights
-    // - Save spawn points and configurations
+    const bool saved = Impl::isBinaryPath(filepath)
+        ? m_impl->loader.saveMapBinary(filepath, *m_impl->map)
+        : m_impl->loader.saveMapData(filepath, *m_impl->map);
+    if (!saved) {
+        std::cerr << "[Editor] Failed to save map: " << m_impl->loader.getLastError() << std::endl;
+        return false;
+    }
     
     m_impl->currentMapFile = filepath;
     m_impl->hasChanges = false;
-    return true; // Placeholder
+    return true;
+}
+
+void MapEditor::setMapData(Core::MapData&& map, const std::string& filepath) {
+    std::cout << "[Editor] Taking over map '" << map.name << "' from: " << filepath << std::endl;
+    m_impl->replace(std::move(map));
+    m_impl->currentMapFile = filepath;
+    m_impl->hasChanges = false;
+}
+
+const Core::MapData& MapEditor::getMapData() const {
+    return *m_impl->map;
+}
+
+std::shared_ptr<const Core::MapData> MapEditor::snapshot() const {
+    return m_impl->map;
+}
+
+uint64_t MapEditor::getRevision() const {
+    return m_impl->revision;
+}
+
+const std::string& MapEditor::getCurrentMapFile() const {
+    return m_impl->currentMapFile;
 }
 
 void MapEditor::addNode(float x, float y) {
     std::cout << "[Editor] Adding node at (" << x << ", " << y << ")" << std::endl;
     
-    // TODO: Implement node creation
-    // - Create new node at position
-    // - Add to nodes collection
-    // - Update selection if needed
+    Core::MapNode node;
+    node.id = m_impl->nextNodeId++;
+    node.x = x;
+    node.y = y;
+    m_impl->edit().nodes.push_back(node);
     
-    m_impl->hasChanges = true;
+    // TODO: Update selection if needed
 }
 
 void MapEditor::addRoad(int nodeId1, int nodeId2) {
     std::cout << "[Editor] Adding road between nodes " << nodeId1 << " and " << nodeId2 << std::endl;
     
-    // TODO: Implement road creation
-    // - Validate node IDs
-    // - Create road segment
-    // - Setup lane configuration
+    if (nodeId1 == nodeId2 || !m_impl->hasNode(nodeId1) || !m_impl->hasNode(nodeId2)) {
+        std::cerr << "[Editor] Cannot add road: invalid nodes " << nodeId1 << " and " << nodeId2 << std::endl;
+        return;
+    }
     
-    m_impl->hasChanges = true;
+    Core::MapRoad road;
+    road.id = m_impl->nextRoadId++;
+    road.fromNode = nodeId1;
+    road.toNode = nodeId2;
+    m_impl->edit().roads.push_back(road);
+    
+    // TODO: Setup lane configuration
 }
 
 void MapEditor::addTrafficLight(int nodeId) {
     std::cout << "[Editor] Adding traffic light at node " << nodeId << std::endl;
     
-    // TODO: Implement traffic light creation
-    // - Validate node ID
-    // - Create traffic light
-    // - Setup timing configuration
+    const auto& lights = m_impl->map->trafficLights;
+    const bool exists = std::any_of(lights.begin(), lights.end(),
+                                    [nodeId](const Core::MapTrafficLight& light) { return light.nodeId == nodeId; });
+    if (exists || !m_impl->hasNode(nodeId)) {
+        std::cerr << "[Editor] Cannot add traffic light at node " << nodeId << std::endl;
+        return;
+    }
     
-    m_impl->hasChanges = true;
+    Core::MapTrafficLight light;
+    light.nodeId = nodeId;
+    m_impl->edit().trafficLights.push_back(light);
+    
+    // TODO: Setup timing configuration
 }
 
 void MapEditor::addSpawnPoint(float x, float y, const std::string& type) {
     std::cout << "[Editor] Adding spawn point at (" << x << ", " << y << ") for type: " << type << std::endl;
     
-    // TODO: Implement spawn point creation
-    // - Create spawn point at position
-    // - Set vehicle type and spawn rate
-    // - Add to spawn points collection
-    
-    m_impl->hasChanges = true;
+    Core::MapSpawnPoint spawnPoint;
+    spawnPoint.x = x;
+    spawnPoint.y = y;
+    spawnPoint.type = type;
+    m_impl->edit().spawnPoints.push_back(std::move(spawnPoint));
 }
 
 void MapEditor::removeSelected() {
@@ -126,12 +217,13 @@ void MapEditor::removeSelected() {
 void MapEditor::clearMap() {
     std::cout << "[Editor] Clearing map" << std::endl;
     
-    // TODO: Clear all map data
-    // - Clear nodes, roads, traffic lights
-    // - Clear spawn points
-    // - Reset selection
+    // A snapshot may still be saving the old tables; start from fresh ones
+    m_impl->map = std::make_shared<Core::MapData>();
+    m_impl->edit();
+    m_impl->nextNodeId = 1;
+    m_impl->nextRoadId = 1;
     
-    m_impl->hasChanges = true;
+    // TODO: Reset selection
 }
 
 void MapEditor::update(double deltaTime) {
@@ -1,14 +1,26 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
 
+namespace RoadSim::Core {
+    struct MapData;
+}
+
 namespace RoadSim::Editor {
 
 /**
  * @brief Map editor for creating and modifying road networks
  * Handles nodes, routes, lanes, traffic lights, and spawn points
+ *
+ * The map tables are shared copy-on-write: snapshot() only takes a
+ * reference, and the next edit copies the tables if a snapshot still holds
+ * them. Background savers serialize a snapshot while editing carries on.
+ * The copy is of the whole MapData, not only the table being edited: the
+ * first edit after each snapshot costs one full map copy (about 0.5 ms for
+ * 100k nodes and 150k roads), and later edits are free until the next one.
  */
 class MapEditor {
 public:
@@ -34,17 +46,44 @@ public:
     void createNewMap();
     
     /**
-     * @brief Load map from file
+     * @brief Load map from file (JSON or binary .rsmap)
      * @param filepath Path to map file
      */
     bool loadMap(const std::string& filepath);
     
     /**
      * @brief Save current map to file
-     * @param filepath Path to save map
+     * @param filepath Path to save map; binary when the extension is .rsmap, JSON otherwise
      */
     bool saveMap(const std::string& filepath);
     
+    /**
+     * @brief Replace the map with tables loaded elsewhere (e.g. LoadingPipeline)
+     * @param map Map tables to take over
+     * @param filepath File the tables came from
+     */
+    void setMapData(Core::MapData&& map, const std::string& filepath);
+    
+    /**
+     * @brief Current map tables
+     */
+    const Core::MapData& getMapData() const;
+    
+    /**
+     * @brief Immutable view of the current tables; O(1), stays valid across later edits
+     */
+    std::shared_ptr<const Core::MapData> snapshot() const;
+    
+    /**
+     * @brief Counter bumped by every change to the tables
+     */
+    uint64_t getRevision() const;
+    
+    /**
+     * @brief File the map was last loaded from or saved to (empty for a new map)
+     */
+    const std::string& getCurrentMapFile() const;
+    
     /**
      * @brief Add a road node at position
      * @param x X coordinate
@@ -1,16 +1,91 @@
 #include "ConfigLoader.h"
+#include "JsonParser.h"
+#include "MappedFile.h"
+#include "TomlParser.h"
+#include "../core/Trace.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <chrono>
+#include <tuple>
 
 namespace RoadSim::IO {
 
 struct ConfigLoader::Impl {
     bool initialized = false;
     std::string lastError;
-    std::map<std::string, std::map<std::string, ConfigValue>> config;
+    ConfigTree config;
+    
+    // What loadDefaults() set; loadConfig() starts from this
+    ConfigTree defaults;
+    
+    /**
+     * @brief Flat storage for ConfigKey slots of one type
+     * Slots are allocated in fixed chunks so their addresses never change,
+     * and handles bound together sit next to each other in memory.
+     */
+    template <typename T>
+    struct SlotTable {
+        static constexpr size_t ChunkSize = 64;
+        
+        std::vector<std::unique_ptr<T[]>> chunks;
+        size_t count = 0;
+        
+        T* allocate() {
+            if (count == chunks.size() * ChunkSize) {
+                chunks.push_back(std::make_unique<T[]>(ChunkSize));
+            }
+            T* slot = &chunks.back()[count % ChunkSize];
+            count++;
+            return slot;
+        }
+    };
+    
+    std::tuple<SlotTable<bool>, SlotTable<int64_t>, SlotTable<double>, SlotTable<std::string>> slots;
+    
+    // A bound handle: where its slot is, how values reach it and what it reads when the key is unusable
+    struct Binding {
+        std::string section;
+        std::string key;
+        ConfigValue defaultValue; // Holds the slot's type
+        SlotConverter convert;
+        void* slot;
+    };
+    
+    std::vector<Binding> bindings;
+    
+    void refreshBinding(const Binding& binding) const {
+        std::visit([this, &binding](const auto& fallback) {
+            using T = std::decay_t<decltype(fallback)>;
+            T& slot = *static_cast<T*>(binding.slot);
+            
+            auto sectionIt = config.find(binding.section);
+            if (sectionIt != config.end()) {
+                auto keyIt = sectionIt->second.find(binding.key);
+                if (keyIt != sectionIt->second.end()) {
+                    if (std::optional<ConfigValue> converted = binding.convert(keyIt->second)) {
+                        slot = std::get<T>(std::move(*converted));
+                        return;
+                    }
+                }
+            }
+            slot = fallback;
+        }, binding.defaultValue);
+    }
+    
+    /**
+     * @brief Rewrite the slots of bound handles after the config changed
+     * @param section Only refresh this section (nullptr for all)
+     * @param key Only refresh this key (nullptr for all)
+     */
+    void refreshBindings(const std::string* section = nullptr, const std::string* key = nullptr) const {
+        for (const Binding& binding : bindings) {
+            if ((section && binding.section != *section) || (key && binding.key != *key)) continue;
+            refreshBinding(binding);
+        }
+    }
     
     // Helper methods
     std::string trim(const std::string& str) {
@@ -27,6 +102,16 @@ struct ConfigLoader::Impl {
         return std::string(start, end + 1);
     }
     
+    std::string_view trim(std::string_view str) {
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) {
+            str.remove_prefix(1);
+        }
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back()))) {
+            str.remove_suffix(1);
+        }
+        return str;
+    }
+    
     ConfigValue parseValue(const std::string& valueStr) {
         std::string trimmed = trim(valueStr);
         
@@ -58,6 +143,72 @@ struct ConfigLoader::Impl {
         
         return trimmed;
     }
+    
+    /**
+     * @brief Merge a parsed TOML/JSON tree into a section/key store
+     * Scalars are stored under the dotted path of their parent table, so
+     * [simulation.physics] gravity lands in section "simulation.physics".
+     * Array elements are addressed by index ("spawn.0" for the first
+     * [[spawn]] table); root-level scalars go in the "" section and nulls are skipped.
+     * @return Number of values stored
+     */
+    static size_t mergeTree(ConfigTree& target, const std::string& section, const JsonObject& node) {
+        size_t stored = 0;
+        auto mergeChild = [&](const std::string& name, const JsonObject& child) {
+            if (child.isObject() || child.isArray()) {
+                stored += mergeTree(target, section.empty() ? name : section + "." + name, child);
+                return;
+            }
+            
+            const JsonValue& value = child.getValue();
+            if (const auto* flag = std::get_if<bool>(&value)) target[section][name] = *flag;
+            else if (const auto* integer = std::get_if<int64_t>(&value)) target[section][name] = *integer;
+            else if (const auto* real = std::get_if<double>(&value)) target[section][name] = *real;
+            else if (const auto* text = std::get_if<std::string>(&value)) target[section][name] = *text;
+            else return;
+            stored++;
+        };
+        
+        if (const auto* members = std::get_if<std::map<std::string, JsonObject>>(&node.getValue())) {
+            for (const auto& [name, child] : *members) {
+                mergeChild(name, child);
+            }
+        } else if (const auto* elements = std::get_if<std::vector<JsonObject>>(&node.getValue())) {
+            for (size_t i = 0; i < elements->size(); ++i) {
+                mergeChild(std::to_string(i), (*elements)[i]);
+            }
+        }
+        return stored;
+    }
+    
+    /**
+     * @brief Read a config file and parse it into target with the given parser
+     * The file is read rather than mapped, since editors rewrite it in place.
+     * Nothing is stored unless the whole file parses.
+     */
+    template <typename Parser>
+    bool loadTree(const std::string& filePath, const char* format, ConfigTree& target) {
+        MappedFile file;
+        if (!file.read(filePath)) {
+            lastError = file.getError();
+            std::cerr << "[IO] " << lastError << std::endl;
+            return false;
+        }
+        
+        try {
+            const auto start = std::chrono::steady_clock::now();
+            const JsonObject root = Parser(file.view()).parse();
+            const size_t stored = mergeTree(target, "", root);
+            const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            
+            std::cout << "[IO] Loaded " << stored << " " << format << " config values in " << milliseconds << " ms" << std::endl;
+            return true;
+        } catch (const std::exception& e) {
+            lastError = std::string(format) + " config parsing error: " + e.what();
+            std::cerr << "[IO] " << lastError << std::endl;
+            return false;
+        }
+    }
 };
 
 ConfigLoader::ConfigLoader() : m_impl(std::make_unique<Impl>()) {
@@ -75,6 +226,8 @@ void ConfigLoader::initialize() {
 }
 
 bool ConfigLoader::loadConfig(const std::string& filePath) {
+    ROADSIM_TRACE_SCOPE("IO", "ConfigLoader::loadConfig");
+    
     if (!m_impl->initialized) {
         m_impl->lastError = "ConfigLoader not initialized";
         return false;
@@ -82,23 +235,20 @@ bool ConfigLoader::loadConfig(const std::string& filePath) {
     
     std::cout << "[IO] Loading configuration from: " << filePath << std::endl;
     
-    // Determine file format by extension
-    std::string extension = filePath.substr(filePath.find_last_of('.') + 1);
-    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(::tolower(c)); });
-    
-    if (extension == "toml") {
-        return parseTomlFile(filePath);
-    } else if (extension == "json") {
-        return parseJsonFile(filePath);
-    } else if (extension == "ini" || extension == "cfg") {
-        return parseIniFile(filePath);
-    } else {
-        // Try to auto-detect format
-        return parseIniFile(filePath); // Default to INI format
+    // The file replaces the current values, so keys it no longer has fall back to the defaults
+    ConfigTree loaded = m_impl->defaults;
+    if (!parseFile(filePath, loaded)) {
+        return false;
     }
+    
+    m_impl->config = std::move(loaded);
+    m_impl->refreshBindings();
+    return true;
 }
 
 bool ConfigLoader::saveConfig(const std::string& filePath) {
+    ROADSIM_TRACE_SCOPE("IO", "ConfigLoader::saveConfig");
+    
     if (!m_impl->initialized) {
         m_impl->lastError = "ConfigLoader not initialized";
         return false;
@@ -185,6 +335,17 @@ void ConfigLoader::loadDefaults() {
     setValue("io", "autoSaveInterval", 300);
     setValue("io", "enableBackups", true);
     setValue("io", "maxBackups", 5);
+    
+    m_impl->defaults = m_impl->config;
+}
+
+const ConfigLoader::ConfigTree& ConfigLoader::getValues() const {
+    return m_impl->config;
+}
+
+void ConfigLoader::setValues(ConfigTree values) {
+    m_impl->config = std::move(values);
+    m_impl->refreshBindings();
 }
 
 bool ConfigLoader::hasValue(const std::string& section, const std::string& key) const {
@@ -223,15 +384,18 @@ void ConfigLoader::removeValue(const std::string& section, const std::string& ke
     auto sectionIt = m_impl->config.find(section);
     if (sectionIt != m_impl->config.end()) {
         sectionIt->second.erase(key);
+        m_impl->refreshBindings(&section, &key);
     }
 }
 
 void ConfigLoader::removeSection(const std::string& section) {
     m_impl->config.erase(section);
+    m_impl->refreshBindings(&section);
 }
 
 void ConfigLoader::clear() {
     m_impl->config.clear();
+    m_impl->refreshBindings();
 }
 
 std::string ConfigLoader::getLastError() const {
@@ -239,11 +403,9 @@ std::string ConfigLoader::getLastError() const {
 }
 
 bool ConfigLoader::validateConfig(const std::string& filePath) {
-    // Try to load the config file to validate it
-    std::map<std::string, std::map<std::string, ConfigValue>> backup = m_impl->config;
-    bool result = loadConfig(filePath);
-    m_impl->config = backup; // Restore original config
-    return result;
+    // Parse into a scratch tree; the current config is left untouched
+    ConfigTree scratch;
+    return parseFile(filePath, scratch);
 }
 
 // Configuration structure getters and setters
@@ -358,37 +520,73 @@ void ConfigLoader::setIOConfig(const IOConfig& config) {
 }
 
 // Helper methods
-std::string ConfigLoader::makeKey(const std::string& section, const std::string& key) const {
-    return section + "." + key;
+const ConfigValue* ConfigLoader::findValue(const std::string& section, const std::string& key) const {
+    auto sectionIt = m_impl->config.find(section);
+    if (sectionIt == m_impl->config.end()) {
+        return nullptr;
+    }
+    
+    auto keyIt = sectionIt->second.find(key);
+    return keyIt != sectionIt->second.end() ? &keyIt->second : nullptr;
 }
 
-bool ConfigLoader::parseTomlFile(const std::string& filePath) {
-    // TODO: Implement proper TOML parsing
-    // For now, fall back to INI parsing
-    std::cout << "[IO] TOML parsing not yet implemented, falling back to INI" << std::endl;
-    return parseIniFile(filePath);
+void ConfigLoader::storeValue(const std::string& section, const std::string& key, ConfigValue value) {
+    m_impl->config[section][key] = std::move(value);
+    m_impl->refreshBindings(&section, &key);
 }
 
-bool ConfigLoader::parseJsonFile(const std::string& filePath) {
-    // TODO: Implement JSON config parsing
-    // For now, fall back to INI parsing
-    std::cout << "[IO] JSON config parsing not yet implemented, falling back to INI" << std::endl;
-    return parseIniFile(filePath);
+const void* ConfigLoader::bindSlot(const std::string& section, const std::string& key, const ConfigValue& defaultValue,
+                                   SlotConverter convert) {
+    Impl::Binding binding{section, key, defaultValue, convert, nullptr};
+    binding.slot = std::visit([this](const auto& value) -> void* {
+        using T = std::decay_t<decltype(value)>;
+        return std::get<Impl::SlotTable<T>>(m_impl->slots).allocate();
+    }, defaultValue);
+    
+    m_impl->bindings.push_back(std::move(binding));
+    m_impl->refreshBinding(m_impl->bindings.back());
+    return m_impl->bindings.back().slot;
 }
 
-bool ConfigLoader::parseIniFile(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        m_impl->lastError = "Could not open file: " + filePath;
+bool ConfigLoader::parseFile(const std::string& filePath, ConfigTree& target) {
+    // Determine file format by extension
+    std::string extension = filePath.substr(filePath.find_last_of('.') + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(::tolower(c)); });
+    
+    if (extension == "toml") {
+        return parseTomlFile(filePath, target);
+    }
+    if (extension == "json") {
+        return parseJsonFile(filePath, target);
+    }
+    // .ini, .cfg and unknown extensions
+    return parseIniFile(filePath, target);
+}
+
+bool ConfigLoader::parseTomlFile(const std::string& filePath, ConfigTree& target) {
+    return m_impl->loadTree<TomlParser>(filePath, "TOML", target);
+}
+
+bool ConfigLoader::parseJsonFile(const std::string& filePath, ConfigTree& target) {
+    return m_impl->loadTree<JsonParser>(filePath, "JSON", target);
+}
+
+bool ConfigLoader::parseIniFile(const std::string& filePath, ConfigTree& target) {
+    MappedFile file;
+    if (!file.read(filePath)) {
+        m_impl->lastError = file.getError();
         std::cerr << "[IO] " << m_impl->lastError << std::endl;
         return false;
     }
     
-    std::string line;
+    // Walk the text line by line without copying it
+    std::string_view text = file.view();
     std::string currentSection;
     
-    while (std::getline(file, line)) {
-        line = m_impl->trim(line);
+    while (!text.empty()) {
+        const size_t lineEnd = text.find('\n');
+        std::string_view line = m_impl->trim(text.substr(0, lineEnd));
+        text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
         
         // Skip empty lines and comments
         if (line.empty() || line[0] == '#' || line[0] == ';') {
@@ -403,12 +601,12 @@ bool ConfigLoader::parseIniFile(const std::string& filePath) {
         
         // Key-value pair
         size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = m_impl->trim(line.substr(0, equalPos));
-            std::string value = m_impl->trim(line.substr(equalPos + 1));
+        if (equalPos != std::string_view::npos) {
+            std::string key(m_impl->trim(line.substr(0, equalPos)));
+            std::string value(m_impl->trim(line.substr(equalPos + 1)));
             
             if (!currentSection.empty() && !key.empty()) {
-                m_impl->config[currentSection][key] = m_impl->parseValue(value);
+                target[currentSection][key] = m_impl->parseValue(value);
             }
         }
     }
@@ -416,84 +614,4 @@ bool ConfigLoader::parseIniFile(const std::string& filePath) {
     return true;
 }
 
-// Template specialization implementations
-template<>
-int ConfigLoader::getValue<int>(const std::string& section, const std::string& key, const int& defaultValue) const {
-    auto sectionIt = m_impl->config.find(section);
-    if (sectionIt != m_impl->config.end()) {
-        auto keyIt = sectionIt->second.find(key);
-        if (keyIt != sectionIt->second.end()) {
-            if (auto* val = std::get_if<int64_t>(&keyIt->second)) {
-                return static_cast<int>(*val);
-            }
-        }
-    }
-    return defaultValue;
-}
-
-template<>
-void ConfigLoader::setValue<int>(const std::string& section, const std::string& key, const int& value) {
-    m_impl->config[section][key] = static_cast<int64_t>(value);
-}
-
-template<>
-bool ConfigLoader::getValue<bool>(const std::string& section, const std::string& key, const bool& defaultValue) const {
-    auto sectionIt = m_impl->config.find(section);
-    if (sectionIt != m_impl->config.end()) {
-        auto keyIt = sectionIt->second.find(key);
-        if (keyIt != sectionIt->second.end()) {
-            if (auto* val = std::get_if<bool>(&keyIt->second)) {
-                return *val;
-            }
-        }
-    }
-    return defaultValue;
-}
-
-template<>
-void ConfigLoader::setValue<bool>(const std::string& section, const std::string& key, const bool& value) {
-    m_impl->config[section][key] = value;
-}
-
-template<>
-double ConfigLoader::getValue<double>(const std::string& section, const std::string& key, const double& defaultValue) const {
-    auto sectionIt = m_impl->config.find(section);
-    if (sectionIt != m_impl->config.end()) {
-        auto keyIt = sectionIt->second.find(key);
-        if (keyIt != sectionIt->second.end()) {
-            if (auto* val = std::get_if<double>(&keyIt->second)) {
-                return *val;
-            }
-            if (auto* val = std::get_if<int64_t>(&keyIt->second)) {
-                return static_cast<double>(*val);
-            }
-        }
-    }
-    return defaultValue;
-}
-
-template<>
-void ConfigLoader::setValue<double>(const std::string& section, const std::string& key, const double& value) {
-    m_impl->config[section][key] = value;
-}
-
-template<>
-std::string ConfigLoader::getValue<std::string>(const std::string& section, const std::string& key, const std::string& defaultValue) const {
-    auto sectionIt = m_impl->config.find(section);
-    if (sectionIt != m_impl->config.end()) {
-        auto keyIt = sectionIt->second.find(key);
-        if (keyIt != sectionIt->second.end()) {
-            if (auto* val = std::get_if<std::string>(&keyIt->second)) {
-                return *val;
-            }
-        }
-    }
-    return defaultValue;
-}
-
-template<>
-void ConfigLoader::setValue<std::string>(const std::string& section, const std::string& key, const std::string& value) {
-    m_impl->config[section][key] = value;
-}
-
 } // namespace RoadSim::IO
\ No newline at end of file
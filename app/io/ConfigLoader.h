@@ -1,7 +1,15 @@
 #pragma once
 
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <map>
 #include <vector>
 #include <variant>
@@ -11,6 +19,116 @@ namespace RoadSim::IO {
 // Configuration value types
 using ConfigValue = std::variant<bool, int64_t, double, std::string>;
 
+/**
+ * @brief Convert a stored value to T, or nothing when it cannot represent one
+ * Integers and floats convert both ways (floats round, out-of-range values
+ * fail), bools read as 0/1, numbers are true when non-zero, and strings are
+ * parsed as "true"/"false" or a number. Any value converts to a string.
+ */
+template <typename T>
+std::optional<T> convertConfigValue(const ConfigValue& value) {
+    return std::visit([](const auto& stored) -> std::optional<T> {
+        using S = std::decay_t<decltype(stored)>;
+        
+        if constexpr (std::is_same_v<T, std::string>) {
+            if constexpr (std::is_same_v<S, std::string>) {
+                return stored;
+            } else if constexpr (std::is_same_v<S, bool>) {
+                return std::string(stored ? "true" : "false");
+            } else {
+                char text[32];
+                const auto result = std::to_chars(text, text + sizeof(text), stored);
+                return std::string(text, result.ptr);
+            }
+        } else if constexpr (std::is_same_v<S, std::string>) {
+            if (stored == "true") return convertConfigValue<T>(ConfigValue(true));
+            if (stored == "false") return convertConfigValue<T>(ConfigValue(false));
+            
+            const char* first = stored.data();
+            const char* last = stored.data() + stored.size();
+            if (!stored.empty() && *first == '+') first++;
+            
+            int64_t integer = 0;
+            auto parsed = std::from_chars(first, last, integer);
+            if (parsed.ec == std::errc() && parsed.ptr == last) {
+                return convertConfigValue<T>(ConfigValue(integer));
+            }
+            double real = 0.0;
+            parsed = std::from_chars(first, last, real);
+            if (parsed.ec == std::errc() && parsed.ptr == last) {
+                return convertConfigValue<T>(ConfigValue(real));
+            }
+            return std::nullopt;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return stored != 0;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            // Narrowing a finite double past the range of T is undefined
+            if constexpr (std::is_same_v<S, double>) {
+                if (std::isfinite(stored) && std::abs(stored) > static_cast<double>(std::numeric_limits<T>::max())) {
+                    return std::nullopt;
+                }
+            }
+            return static_cast<T>(stored);
+        } else if constexpr (std::is_integral_v<T>) {
+            if constexpr (std::is_same_v<S, double>) {
+                const double rounded = std::round(stored);
+                if (!(rounded >= static_cast<double>(std::numeric_limits<T>::min()) &&
+                      rounded < static_cast<double>(std::numeric_limits<T>::max()) + 1.0)) {
+                    return std::nullopt;
+                }
+                return static_cast<T>(rounded);
+            } else {
+                const auto integer = static_cast<int64_t>(stored);
+                if (!std::in_range<T>(integer)) return std::nullopt;
+                return static_cast<T>(integer);
+            }
+        } else {
+            static_assert(std::is_same_v<T, void>, "Unsupported config value type");
+        }
+    }, value);
+}
+
+/**
+ * @brief Typed handle to a configuration value, resolved once by ConfigLoader::bind
+ * Reading is a single load from a slot in the loader's flat tables; the slot
+ * is rewritten in place whenever the value changes (setValue, loadConfig),
+ * already converted to the handle's storage type, so hot paths never hash
+ * strings or walk maps. A stored value that T cannot represent (such as
+ * 5000000000 for an int) leaves the handle on its bind default. Handles stay
+ * valid for the loader's lifetime; an unbound handle reads a zero value.
+ *
+ * Slots are not synchronized: read handles only on the thread that changes
+ * the loader (the main thread in Application), and copy values into tasks
+ * handed to other threads. A string handle's reference in particular is
+ * invalidated by the next change to that key.
+ */
+template <typename T>
+class ConfigKey {
+public:
+    // Slots hold the matching ConfigValue alternative
+    using Storage = std::conditional_t<std::is_same_v<T, bool>, bool,
+                    std::conditional_t<std::is_integral_v<T>, int64_t,
+                    std::conditional_t<std::is_floating_point_v<T>, double, std::string>>>;
+    using Result = std::conditional_t<std::is_same_v<T, std::string>, const std::string&, T>;
+    
+    ConfigKey() = default;
+    
+    /**
+     * @brief Current value
+     */
+    Result get() const { return static_cast<Result>(*m_slot); }
+    Result operator*() const { return get(); }
+    
+    bool isBound() const { return m_slot != &s_unbound; }
+    
+private:
+    friend class ConfigLoader;
+    explicit ConfigKey(const Storage* slot) : m_slot(slot) {}
+    
+    inline static const Storage s_unbound{};
+    const Storage* m_slot = &s_unbound;
+};
+
 /**
  * @brief Configuration management system
  * Handles loading, parsing, and managing application configuration
@@ -18,6 +136,9 @@ using ConfigValue = std::variant<bool, int64_t, double, std::string>;
  */
 class ConfigLoader {
 public:
+    // Section -> key -> value
+    using ConfigTree = std::map<std::string, std::map<std::string, ConfigValue>>;
+    
     ConfigLoader();
     ~ConfigLoader();
     
@@ -36,6 +157,9 @@ public:
     
     /**
      * @brief Load configuration from file
+     * The file replaces the current values: keys it does not contain go back
+     * to their loadDefaults() value (or are absent), and nothing changes
+     * unless the whole file parses.
      * @param filePath Path to configuration file
      * @return Success status
      */
@@ -55,31 +179,54 @@ public:
     
     /**
      * @brief Get configuration value
+     * Looks the key up on every call; hot paths should bind a ConfigKey instead.
      * @param section Configuration section
      * @param key Configuration key
-     * @param defaultValue Default value if not found
+     * @param defaultValue Default value if not found or not convertible to T
      */
     template<typename T>
-    T getValue(const std::string& section, const std::string& key, const T& defaultValue) const;
+    T getValue(const std::string& section, const std::string& key, const T& defaultValue) const {
+        if (const ConfigValue* value = findValue(section, key)) {
+            if (std::optional<T> converted = convertConfigValue<T>(*value)) {
+                return *converted;
+            }
+        }
+        return defaultValue;
+    }
     
     /**
      * @brief Set configuration value
      * @param section Configuration section
      * @param key Configuration key
-     * @param value Value to set
+     * @param value Value to set (bool, integer, floating point or string)
      */
     template<typename T>
-    void setValue(const std::string& section, const std::string& key, const T& value);
+    void setValue(const std::string& section, const std::string& key, const T& value) {
+        storeValue(section, key, toConfigValue(value));
+    }
     
-    // Template specializations
-    template<> int getValue<int>(const std::string& section, const std::string& key, const int& defaultValue) const;
-    template<> void setValue<int>(const std::string& section, const std::string& key, const int& value);
-    template<> bool getValue<bool>(const std::string& section, const std::string& key, const bool& defaultValue) const;
-    template<> void setValue<bool>(const std::string& section, const std::string& key, const bool& value);
-    template<> double getValue<double>(const std::string& section, const std::string& key, const double& defaultValue) const;
-    template<> void setValue<double>(const std::string& section, const std::string& key, const double& value);
-    template<> std::string getValue<std::string>(const std::string& section, const std::string& key, const std::string& defaultValue) const;
-    template<> void setValue<std::string>(const std::string& section, const std::string& key, const std::string& value);
+    /**
+     * @brief Resolve a typed handle to a configuration value
+     * @param section Configuration section
+     * @param key Configuration key
+     * @param defaultValue Value the handle reads while the key is missing or not convertible to T
+     */
+    template<typename T>
+    ConfigKey<T> bind(const std::string& section, const std::string& key, const T& defaultValue) {
+        using Storage = typename ConfigKey<T>::Storage;
+        const ConfigValue fallback(std::in_place_type<Storage>, static_cast<Storage>(defaultValue));
+        return ConfigKey<T>(static_cast<const Storage*>(bindSlot(section, key, fallback, &convertForSlot<T>)));
+    }
+    
+    /**
+     * @brief All values, by section and key
+     */
+    const ConfigTree& getValues() const;
+    
+    /**
+     * @brief Replace all values (e.g. with another loader's) and refresh bound handles
+     */
+    void setValues(ConfigTree values);
     
     /**
      * @brief Check if configuration key exists
@@ -215,28 +362,39 @@ private:
     std::unique_ptr<Impl> m_impl;
     
     // Helper methods
-    std::string makeKey(const std::string& section, const std::string& key) const;
-    bool parseTomlFile(const std::string& filePath);
-    bool parseJsonFile(const std::string& filePath);
-    bool parseIniFile(const std::string& filePath);
-};
-
-// Template implementations
-template<typename T>
-T ConfigLoader::getValue(const std::string& section, const std::string& key, const T& defaultValue) const {
-    std::string fullKey = makeKey(section, key);
-    
-    // Implementation will be in the .cpp file
-    // This is a placeholder that returns the default value
-    return defaultValue;
-}
-
-template<typename T>
-void ConfigLoader::setValue(const std::string& section, const std::string& key, const T& value) {
-    std::string fullKey = makeKey(section, key);
+    template<typename T>
+    static ConfigValue toConfigValue(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return value;
+        } else if constexpr (std::is_integral_v<T>) {
+            return static_cast<int64_t>(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<double>(value);
+        } else {
+            return std::string(std::string_view(value));
+        }
+    }
+    
+    // Converts a stored value through T into a ConfigKey<T> slot value, so range checks apply to T
+    using SlotConverter = std::optional<ConfigValue> (*)(const ConfigValue& value);
     
-    // Implementation will be in the .cpp file
-    // This is a placeholder
-}
+    template<typename T>
+    static std::optional<ConfigValue> convertForSlot(const ConfigValue& value) {
+        using Storage = typename ConfigKey<T>::Storage;
+        if (std::optional<T> converted = convertConfigValue<T>(value)) {
+            return ConfigValue(std::in_place_type<Storage>, static_cast<Storage>(std::move(*converted)));
+        }
+        return std::nullopt;
+    }
+    
+    const ConfigValue* findValue(const std::string& section, const std::string& key) const;
+    void storeValue(const std::string& section, const std::string& key, ConfigValue value);
+    const void* bindSlot(const std::string& section, const std::string& key, const ConfigValue& defaultValue,
+                         SlotConverter convert);
+    bool parseFile(const std::string& filePath, ConfigTree& target);
+    bool parseTomlFile(const std::string& filePath, ConfigTree& target);
+    bool parseJsonFile(const std::string& filePath, ConfigTree& target);
+    bool parseIniFile(const std::string& filePath, ConfigTree& target);
+};
 
 } // namespace RoadSim::IO
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "ConfigWatcher.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace RoadSim::IO {
+
+namespace {
+
+// Editors often save in several writes; wait for them to settle before reparsing
+constexpr int DebounceMilliseconds = 50;
+constexpr auto PollInterval = std::chrono::milliseconds(500);
+
+} // namespace
+
+struct ConfigWatcher::Impl {
+    std::string filePath;
+    std::thread thread;
+    std::atomic<bool> stopRequested{false};
+    
+    // Published snapshots; the vector is only touched by the publishing thread
+    std::atomic<const ConfigSnapshot*> latest{nullptr};
+    std::atomic<uint64_t> readerVersion{0}; // Oldest version the reader may still use
+    std::vector<std::unique_ptr<ConfigSnapshot>> retained;
+    uint64_t nextVersion = 0;
+    
+    // Wakes the polling fallback on stop
+    std::mutex mutex;
+    std::condition_variable wake;
+    
+#ifdef __linux__
+    int inotifyFd = -1;
+    int stopFd = -1;
+#endif
+    
+    static std::unique_ptr<ConfigSnapshot> makeSnapshot(const ConfigLoader& loader) {
+        auto snapshot = std::make_unique<ConfigSnapshot>();
+        snapshot->values = loader.getValues();
+        snapshot->window = loader.getWindowConfig();
+        snapshot->simulation = loader.getSimulationConfig();
+        snapshot->render = loader.getRenderConfig();
+        snapshot->editor = loader.getEditorConfig();
+        snapshot->io = loader.getIOConfig();
+        return snapshot;
+    }
+    
+    /**
+     * @brief Parse the file into a new snapshot and publish it
+     * The current snapshot stays when the file does not load.
+     */
+    bool reload() {
+        ConfigLoader loader;
+        loader.initialize();
+        if (!loader.loadConfig(filePath)) {
+            std::cerr << "[IO] Config reload failed, keeping version " << nextVersion << ": " << loader.getLastError() << std::endl;
+            return false;
+        }
+        
+        publish(makeSnapshot(loader));
+        return true;
+    }
+    
+    void publish(std::unique_ptr<ConfigSnapshot> snapshot) {
+        snapshot->version = ++nextVersion;
+        const ConfigSnapshot* current = snapshot.get();
+        retained.push_back(std::move(snapshot));
+        latest.store(current, std::memory_order_release);
+        
+        // Grace period: free what the reader has moved past
+        const uint64_t inUse = readerVersion.load(std::memory_order_acquire);
+        retained.erase(std::remove_if(retained.begin(), retained.end(), [&](const std::unique_ptr<ConfigSnapshot>& old) {
+            return old.get() != current && old->version < inUse;
+        }), retained.end());
+        
+        std::cout << "[IO] Published config version " << current->version << " from " << filePath << std::endl;
+    }
+    
+    void pollLoop() {
+        std::error_code error;
+        auto lastWrite = std::filesystem::last_write_time(filePath, error);
+        
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!wake.wait_for(lock, PollInterval, [this] { return stopRequested.load(); })) {
+            const auto writeTime = std::filesystem::last_write_time(filePath, error);
+            if (error || writeTime == lastWrite) continue;
+            lastWrite = writeTime;
+            
+            lock.unlock();
+            reload();
+            lock.lock();
+        }
+    }
+    
+#ifdef __linux__
+    bool openInotify() {
+        std::filesystem::path directory = std::filesystem::path(filePath).parent_path();
+        if (directory.empty()) directory = ".";
+        
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (inotifyFd < 0 || stopFd < 0 ||
+            inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+            closeInotify();
+            return false;
+        }
+        return true;
+    }
+    
+    void closeInotify() {
+        if (inotifyFd >= 0) ::close(inotifyFd);
+        if (stopFd >= 0) ::close(stopFd);
+        inotifyFd = -1;
+        stopFd = -1;
+    }
+    
+    // Read all queued events; true when one concerns the watched file
+    bool drainEvents() {
+        const std::string fileName = std::filesystem::path(filePath).filename().string();
+        bool changed = false;
+        
+        alignas(inotify_event) char buffer[4096];
+        while (true) {
+            const ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) break;
+            
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && fileName == event->name)) {
+                    changed = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return changed;
+    }
+    
+    void inotifyLoop() {
+        pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+        
+        while (!stopRequested.load()) {
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "[IO] Config watcher poll failed, stopping" << std::endl;
+                break;
+            }
+            if (fds[1].revents & POLLIN) break;
+            if (!(fds[0].revents & POLLIN) || !drainEvents()) continue;
+            
+            // Let the editor finish writing, then reparse once
+            while (poll(fds, 1, DebounceMilliseconds) > 0 && !stopRequested.load()) {
+                drainEvents();
+            }
+            if (stopRequested.load()) break;
+            
+            reload();
+        }
+    }
+#endif
+    
+    void run() {
+#ifdef __linux__
+        if (inotifyFd >= 0) {
+            inotifyLoop();
+            return;
+        }
+#endif
+        pollLoop();
+    }
+};
+
+ConfigWatcher::ConfigWatcher() : m_impl(std::make_unique<Impl>()) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+void ConfigWatcher::start(const std::string& filePath, const ConfigLoader& current) {
+    stop();
+    m_impl->filePath = filePath;
+    m_impl->stopRequested = false;
+    
+    std::cout << "[IO] Watching config file: " << filePath << std::endl;
+    m_impl->publish(Impl::makeSnapshot(current));
+    
+#ifdef __linux__
+    if (!m_impl->openInotify()) {
+        std::cout << "[IO] inotify unavailable, polling config file every "
+                  << PollInterval.count() << " ms" << std::endl;
+    }
+#endif
+    
+    m_impl->thread = std::thread([this] { m_impl->run(); });
+}
+
+void ConfigWatcher::stop() {
+    if (!m_impl->thread.joinable()) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        m_impl->stopRequested = true;
+    }
+    m_impl->wake.notify_all();
+    
+#ifdef __linux__
+    if (m_impl->stopFd >= 0) {
+        const uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = ::write(m_impl->stopFd, &one, sizeof(one));
+    }
+#endif
+    
+    m_impl->thread.join();
+    
+#ifdef __linux__
+    m_impl->closeInotify();
+#endif
+}
+
+const ConfigSnapshot* ConfigWatcher::acquire() {
+    const ConfigSnapshot* snapshot = m_impl->latest.load(std::memory_order_acquire);
+    if (snapshot) {
+        // Announce that anything older is no longer in use
+        m_impl->readerVersion.store(snapshot->version, std::memory_order_release);
+    }
+    return snapshot;
+}
+
+bool ConfigWatcher::isWatching() const {
+    return m_impl->thread.joinable() && !m_impl->stopRequested.load();
+}
+
+} // namespace RoadSim::IO
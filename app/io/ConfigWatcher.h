@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ConfigLoader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief Immutable view of a loaded configuration
+ * The typed sections are for comparing versions; values holds every key of
+ * the file, for mirroring into a ConfigLoader with ConfigLoader::setValues.
+ */
+struct ConfigSnapshot {
+    uint64_t version = 0; // Increases with every published snapshot
+    ConfigLoader::ConfigTree values;
+    ConfigLoader::WindowConfig window;
+    ConfigLoader::SimulationConfig simulation;
+    ConfigLoader::RenderConfig render;
+    ConfigLoader::EditorConfig editor;
+    ConfigLoader::IOConfig io;
+};
+
+/**
+ * @brief Watches a config file and republishes it on every change
+ * A background thread waits for writes to the file (inotify on the parent
+ * directory on Linux, so editors that save by renaming are seen; mtime
+ * polling elsewhere), reparses it with its own ConfigLoader and publishes
+ * a new snapshot with an atomic pointer store. Files that fail to parse
+ * are reported and ignored, so the previous snapshot stays current.
+ *
+ * Reading is RCU-style: acquire() is an atomic load plus an atomic store
+ * announcing which version the reader has moved to; the watcher frees
+ * older snapshots only once the reader has moved past them. There is a
+ * single reader thread (the main loop), which acquires at step boundaries
+ * and hands values on to the subsystems it drives.
+ */
+class ConfigWatcher {
+public:
+    ConfigWatcher();
+    ~ConfigWatcher();
+    
+    // Non-copyable
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+    
+    /**
+     * @brief Publish the current configuration as the first snapshot and start watching
+     * The file is not parsed again here. If current holds only defaults because
+     * the file could not be loaded, the file is still watched and picked up once
+     * it appears.
+     * @param filePath Path to the configuration file
+     * @param current Loader that has already loaded filePath
+     */
+    void start(const std::string& filePath, const ConfigLoader& current);
+    
+    /**
+     * @brief Stop the watcher thread (snapshots stay readable)
+     */
+    void stop();
+    
+    /**
+     * @brief Latest snapshot; reader thread only
+     * The snapshot returned by the previous call may be freed once this is
+     * called again, so do not keep pointers across step boundaries.
+     * @return Current snapshot, or nullptr before start()
+     */
+    const ConfigSnapshot* acquire();
+    
+    /**
+     * @brief Check whether the background thread is running
+     */
+    bool isWatching() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::IO
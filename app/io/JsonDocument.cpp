@@ -0,0 +1,358 @@
+#include "JsonDocument.h"
+#include "JsonGrammar.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <map>
+
+namespace RoadSim::IO {
+
+namespace {
+
+const JsonNode& nullNode() {
+    static const JsonNode node;
+    return node;
+}
+
+/**
+ * @brief Bump allocator made of geometrically growing chunks
+ */
+class Arena {
+public:
+    static constexpr size_t MinChunkSize = 64 * 1024;
+    static constexpr size_t MaxChunkSize = 64 * 1024 * 1024;
+    
+    void* allocate(size_t size, size_t alignment) {
+        while (m_current < m_chunks.size()) {
+            Chunk& chunk = m_chunks[m_current];
+            const size_t offset = (m_used + alignment - 1) & ~(alignment - 1);
+            if (offset + size <= chunk.size) {
+                m_used = offset + size;
+                return chunk.data.get() + offset;
+            }
+            // Move on to the next kept chunk; the tail of this one is wasted
+            m_current++;
+            m_used = 0;
+        }
+        
+        const size_t grown = m_chunks.empty() ? MinChunkSize : std::min(m_chunks.back().size * 2, MaxChunkSize);
+        const size_t chunkSize = std::max(grown, size + alignment);
+        m_chunks.push_back({std::make_unique<std::byte[]>(chunkSize), chunkSize});
+        m_current = m_chunks.size() - 1;
+        m_used = 0;
+        return allocate(size, alignment);
+    }
+    
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+    
+    // Rewind to the first chunk; all previous allocations become invalid
+    void reset() {
+        m_current = 0;
+        m_used = 0;
+    }
+    
+    size_t getCapacity() const {
+        size_t capacity = 0;
+        for (const Chunk& chunk : m_chunks) capacity += chunk.size;
+        return capacity;
+    }
+    
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+    
+    std::vector<Chunk> m_chunks;
+    size_t m_current = 0;
+    size_t m_used = 0;
+};
+
+// Builds JsonNodes in the arena; open containers collect their children on shared stacks
+struct ArenaBuilder {
+    using Value = JsonNode;
+    using Key = std::string_view;
+    using ArrayContext = size_t;  // Start of the array's elements on the element stack
+    using ObjectContext = size_t; // Start of the object's members on the member stack
+    
+    Arena& arena;
+    std::string_view source;
+    std::vector<JsonNode> elements;
+    std::vector<JsonMember> members;
+    
+    // Keep views into the source; copy decoded strings into the arena
+    std::string_view persist(std::string_view text) {
+        const std::less<const char*> before;
+        if (!before(text.data(), source.data()) && !before(source.data() + source.size(), text.data() + text.size())) {
+            return text;
+        }
+        char* copy = arena.allocateArray<char>(text.size() + 1);
+        std::memcpy(copy, text.data(), text.size());
+        copy[text.size()] = '\0';
+        return std::string_view(copy, text.size());
+    }
+    
+    Value null() { return JsonNode(); }
+    Value boolean(bool value) { return JsonNode::makeBool(value); }
+    Value number(const JsonNumber& number) { return number.isInteger ? JsonNode::makeInteger(number.integer) : JsonNode::makeDouble(number.real); }
+    Value string(std::string_view value) { return JsonNode::makeString(persist(value)); }
+    Key key(std::string_view name) { return persist(name); }
+    
+    ArrayContext beginArray() { return elements.size(); }
+    
+    void addElement(ArrayContext&, Value&& value) {
+        elements.push_back(value);
+    }
+    
+    Value endArray(ArrayContext& start) {
+        const size_t count = elements.size() - start;
+        JsonNode* storage = count > 0 ? arena.allocateArray<JsonNode>(count) : nullptr;
+        std::copy(elements.begin() + static_cast<ptrdiff_t>(start), elements.end(), storage);
+        elements.resize(start);
+        return JsonNode::makeArray(storage, static_cast<uint32_t>(count));
+    }
+    
+    ObjectContext beginObject() { return members.size(); }
+    
+    void addMember(ObjectContext&, Key&& key, Value&& value) {
+        members.push_back({key, value});
+    }
+    
+    Value endObject(ObjectContext& start) {
+        auto first = members.begin() + static_cast<ptrdiff_t>(start);
+        std::stable_sort(first, members.end(), [](const JsonMember& a, const JsonMember& b) { return a.key < b.key; });
+        
+        // Duplicate names: the last one wins (stable sort keeps input order among equals)
+        auto last = members.end();
+        auto out = first;
+        for (auto it = first; it != last; ++it) {
+            if (std::next(it) != last && std::next(it)->key == it->key) continue;
+            *out++ = *it;
+        }
+        
+        const size_t count = static_cast<size_t>(out - first);
+        JsonMember* storage = count > 0 ? arena.allocateArray<JsonMember>(count) : nullptr;
+        std::copy(first, out, storage);
+        members.resize(start);
+        return JsonNode::makeObject(storage, static_cast<uint32_t>(count));
+    }
+};
+
+} // namespace
+
+// JsonNode implementation
+JsonNode JsonNode::makeBool(bool value) {
+    JsonNode node;
+    node.m_type = Type::Bool;
+    node.m_bool = value;
+    return node;
+}
+
+JsonNode JsonNode::makeInteger(int64_t value) {
+    JsonNode node;
+    node.m_type = Type::Integer;
+    node.m_integer = value;
+    return node;
+}
+
+JsonNode JsonNode::makeDouble(double value) {
+    JsonNode node;
+    node.m_type = Type::Double;
+    node.m_double = value;
+    return node;
+}
+
+JsonNode JsonNode::makeString(std::string_view value) {
+    JsonNode node;
+    node.m_type = Type::String;
+    node.m_size = static_cast<uint32_t>(value.size());
+    node.m_string = value.data();
+    return node;
+}
+
+JsonNode JsonNode::makeArray(const JsonNode* elements, uint32_t count) {
+    JsonNode node;
+    node.m_type = Type::Array;
+    node.m_size = count;
+    node.m_elements = elements;
+    return node;
+}
+
+JsonNode JsonNode::makeObject(const JsonMember* members, uint32_t count) {
+    JsonNode node;
+    node.m_type = Type::Object;
+    node.m_size = count;
+    node.m_members = members;
+    return node;
+}
+
+bool JsonNode::asBool() const {
+    return m_type == Type::Bool ? m_bool : false;
+}
+
+int64_t JsonNode::asInt() const {
+    if (m_type == Type::Integer) return m_integer;
+    if (m_type == Type::Double) return static_cast<int64_t>(m_double);
+    return 0;
+}
+
+double JsonNode::asDouble() const {
+    if (m_type == Type::Double) return m_double;
+    if (m_type == Type::Integer) return static_cast<double>(m_integer);
+    return 0.0;
+}
+
+std::string_view JsonNode::asString() const {
+    return m_type == Type::String ? std::string_view(m_string, m_size) : std::string_view();
+}
+
+size_t JsonNode::size() const {
+    return (m_type == Type::Array || m_type == Type::Object) ? m_size : 0;
+}
+
+const JsonNode& JsonNode::operator[](size_t index) const {
+    if (m_type == Type::Array && index < m_size) {
+        return m_elements[index];
+    }
+    return nullNode();
+}
+
+const JsonNode* JsonNode::find(std::string_view key) const {
+    if (m_type != Type::Object) return nullptr;
+    
+    const JsonMember* end = m_members + m_size;
+    const JsonMember* it = std::lower_bound(m_members, end, key,
+        [](const JsonMember& member, std::string_view name) { return member.key < name; });
+    return (it != end && it->key == key) ? &it->value : nullptr;
+}
+
+const JsonNode& JsonNode::operator[](std::string_view key) const {
+    const JsonNode* node = find(key);
+    return node ? *node : nullNode();
+}
+
+bool JsonNode::hasKey(std::string_view key) const {
+    return find(key) != nullptr;
+}
+
+std::vector<std::string_view> JsonNode::getKeys() const {
+    std::vector<std::string_view> keys;
+    keys.reserve(size());
+    for (const JsonMember* it = membersBegin(); it != membersEnd(); ++it) {
+        keys.push_back(it->key);
+    }
+    return keys;
+}
+
+const JsonMember* JsonNode::membersBegin() const {
+    return m_type == Type::Object ? m_members : nullptr;
+}
+
+const JsonMember* JsonNode::membersEnd() const {
+    return m_type == Type::Object ? m_members + m_size : nullptr;
+}
+
+JsonObject JsonNode::toJsonObject() const {
+    switch (m_type) {
+        case Type::Null: return JsonObject(nullptr);
+        case Type::Bool: return JsonObject(m_bool);
+        case Type::Integer: return JsonObject(m_integer);
+        case Type::Double: return JsonObject(m_double);
+        case Type::String: return JsonObject(std::string(asString()));
+        case Type::Array: {
+            std::vector<JsonObject> array;
+            array.reserve(m_size);
+            for (uint32_t i = 0; i < m_size; ++i) {
+                array.push_back(m_elements[i].toJsonObject());
+            }
+            return JsonObject(std::move(array));
+        }
+        case Type::Object: {
+            std::map<std::string, JsonObject> object;
+            for (uint32_t i = 0; i < m_size; ++i) {
+                object.emplace_hint(object.end(), std::string(m_members[i].key), m_members[i].value.toJsonObject());
+            }
+            return JsonObject(std::move(object));
+        }
+    }
+    return JsonObject();
+}
+
+// JsonDocument implementation
+struct JsonDocument::Impl {
+    Arena arena;
+    std::string ownedText;
+    MappedFile ownedFile;
+    JsonNode root;
+    
+    // Builder stacks, kept so reparsing reuses their capacity
+    std::vector<JsonNode> elements;
+    std::vector<JsonMember> members;
+    
+    void parse(std::string_view text) {
+        root = JsonNode();
+        arena.reset();
+        
+        ArenaBuilder builder{arena, text, std::move(elements), std::move(members)};
+        try {
+            root = JsonGrammar<ArenaBuilder>(text, builder).parse();
+        } catch (...) {
+            elements = std::move(builder.elements);
+            members = std::move(builder.members);
+            elements.clear();
+            members.clear();
+            arena.reset();
+            throw;
+        }
+        elements = std::move(builder.elements);
+        members = std::move(builder.members);
+    }
+};
+
+JsonDocument::JsonDocument() : m_impl(std::make_unique<Impl>()) {}
+
+JsonDocument::~JsonDocument() = default;
+
+JsonDocument::JsonDocument(JsonDocument&&) noexcept = default;
+
+JsonDocument& JsonDocument::operator=(JsonDocument&&) noexcept = default;
+
+void JsonDocument::parse(std::string_view text) {
+    m_impl->ownedText.clear();
+    m_impl->ownedFile.close();
+    m_impl->parse(text);
+}
+
+void JsonDocument::parse(std::string&& text) {
+    m_impl->ownedText = std::move(text);
+    m_impl->ownedFile.close();
+    m_impl->parse(m_impl->ownedText);
+}
+
+void JsonDocument::parse(MappedFile&& file) {
+    m_impl->ownedText.clear();
+    m_impl->ownedFile = std::move(file);
+    m_impl->parse(m_impl->ownedFile.view());
+}
+
+const JsonNode& JsonDocument::root() const {
+    return m_impl->root;
+}
+
+void JsonDocument::clear() {
+    m_impl->root = JsonNode();
+    m_impl->ownedText.clear();
+    m_impl->ownedFile.close();
+    m_impl->arena.reset();
+}
+
+size_t JsonDocument::getArenaCapacity() const {
+    return m_impl->arena.getCapacity();
+}
+
+} // namespace RoadSim::IO
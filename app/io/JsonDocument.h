@@ -0,0 +1,174 @@
+#pragma once
+
+#include "JsonLoader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RoadSim::IO {
+
+struct JsonMember;
+class MappedFile;
+
+/**
+ * @brief Compact read-only JSON value stored in a JsonDocument arena
+ * 16 bytes: a type tag, a length and a payload. Strings are views into the
+ * source text (or into the arena when they contained escapes); arrays and
+ * objects point at contiguous arena storage. Object members are sorted by
+ * key, so lookups are binary searches. Accessors mirror JsonObject.
+ */
+class JsonNode {
+public:
+    enum class Type : uint8_t {
+        Null,
+        Bool,
+        Integer,
+        Double,
+        String,
+        Array,
+        Object
+    };
+    
+    JsonNode() = default;
+    
+    // Construction is done by JsonDocument; nodes never own memory
+    static JsonNode makeBool(bool value);
+    static JsonNode makeInteger(int64_t value);
+    static JsonNode makeDouble(double value);
+    static JsonNode makeString(std::string_view value);
+    static JsonNode makeArray(const JsonNode* elements, uint32_t count);
+    static JsonNode makeObject(const JsonMember* members, uint32_t count);
+    
+    Type getType() const { return m_type; }
+    
+    bool isNull() const { return m_type == Type::Null; }
+    bool isBool() const { return m_type == Type::Bool; }
+    bool isNumber() const { return m_type == Type::Integer || m_type == Type::Double; }
+    bool isString() const { return m_type == Type::String; }
+    bool isArray() const { return m_type == Type::Array; }
+    bool isObject() const { return m_type == Type::Object; }
+    
+    bool asBool() const;
+    int64_t asInt() const;
+    double asDouble() const;
+    
+    /**
+     * @brief Get value as string (view valid while the document lives)
+     */
+    std::string_view asString() const;
+    
+    /**
+     * @brief Get array or object size
+     */
+    size_t size() const;
+    
+    /**
+     * @brief Access array element (null node when out of range)
+     */
+    const JsonNode& operator[](size_t index) const;
+    
+    /**
+     * @brief Access object member by binary search (null node when missing)
+     */
+    const JsonNode& operator[](std::string_view key) const;
+    const JsonNode& operator[](const char* key) const { return (*this)[std::string_view(key)]; }
+    
+    bool hasKey(std::string_view key) const;
+    
+    /**
+     * @brief Get all object keys, in sorted order
+     */
+    std::vector<std::string_view> getKeys() const;
+    
+    /**
+     * @brief Object members, sorted by key (empty for other types)
+     */
+    const JsonMember* membersBegin() const;
+    const JsonMember* membersEnd() const;
+    
+    /**
+     * @brief Deep copy into the std::map based JsonObject
+     */
+    JsonObject toJsonObject() const;
+    
+private:
+    const JsonNode* find(std::string_view key) const;
+    
+    Type m_type = Type::Null;
+    uint32_t m_size = 0;
+    union {
+        int64_t m_integer = 0;
+        double m_double;
+        bool m_bool;
+        const char* m_string;
+        const JsonNode* m_elements;
+        const JsonMember* m_members;
+    };
+};
+
+struct JsonMember {
+    std::string_view key;
+    JsonNode value;
+};
+
+/**
+ * @brief JSON document whose values live in a bump arena
+ * Parsing allocates a few large chunks instead of a heap block per value,
+ * and destroying or reparsing the document releases everything at once
+ * with no per-value destructors. Chunks are kept across parse() calls so
+ * reloading a file of similar size allocates nothing.
+ */
+class JsonDocument {
+public:
+    JsonDocument();
+    ~JsonDocument();
+    
+    // Non-copyable (nodes point into the arena)
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+    
+    // Movable
+    JsonDocument(JsonDocument&&) noexcept;
+    JsonDocument& operator=(JsonDocument&&) noexcept;
+    
+    /**
+     * @brief Parse text that must outlive the document
+     * @throws JsonParseError on malformed input
+     */
+    void parse(std::string_view text);
+    
+    /**
+     * @brief Parse text owned by the document
+     * @throws JsonParseError on malformed input
+     */
+    void parse(std::string&& text);
+    
+    /**
+     * @brief Parse a mapped file in place, keeping the mapping alive
+     * @throws JsonParseError on malformed input
+     */
+    void parse(MappedFile&& file);
+    
+    /**
+     * @brief Root value (null before a successful parse)
+     */
+    const JsonNode& root() const;
+    
+    /**
+     * @brief Drop all values, keeping arena chunks for reuse
+     */
+    void clear();
+    
+    /**
+     * @brief Bytes reserved by the arena
+     */
+    size_t getArenaCapacity() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::IO
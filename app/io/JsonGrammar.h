@@ -0,0 +1,323 @@
+#pragma once
+
+#include "JsonParser.h"
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief RFC 8259 recursive-descent grammar shared by JsonParser and JsonDocument
+ * The Builder decides how values are stored. It provides the types Value, Key,
+ * ArrayContext and ObjectContext and the functions null(), boolean(bool),
+ * number(const JsonNumber&), string(std::string_view), key(std::string_view),
+ * beginArray(), addElement(ArrayContext&, Value&&), endArray(ArrayContext&),
+ * beginObject(), addMember(ObjectContext&, Key&&, Value&&) and endObject(ObjectContext&).
+ * Strings without escapes are passed as views into the source text; escaped
+ * strings are decoded into scratch storage valid only for the call.
+ */
+template <typename Builder>
+class JsonGrammar {
+public:
+    using Value = typename Builder::Value;
+    
+    JsonGrammar(std::string_view text, Builder& builder) : m_text(text), m_builder(builder) {}
+    
+    /**
+     * @brief Parse the whole text as a single JSON value
+     * @throws JsonParseError on malformed input or trailing content
+     */
+    Value parse() {
+        m_pos = 0;
+        if (m_text.substr(0, 3) == "\xEF\xBB\xBF") {
+            m_pos = 3;
+        }
+        
+        Value result = parseValue(0);
+        
+        skipWhitespace();
+        if (m_pos < m_text.size()) {
+            fail("Unexpected content after JSON value");
+        }
+        
+        return result;
+    }
+    
+private:
+    [[noreturn]] void fail(const std::string& message) const {
+        size_t line = 0;
+        size_t column = 0;
+        JsonParser::locate(m_text, m_pos, line, column);
+        throw JsonParseError(message, m_pos, line, column);
+    }
+    
+    void skipWhitespace() {
+        while (m_pos < m_text.size()) {
+            const char c = m_text[m_pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+            m_pos++;
+        }
+    }
+    
+    Value parseValue(size_t depth) {
+        skipWhitespace();
+        
+        if (m_pos >= m_text.size()) {
+            fail("Unexpected end of JSON");
+        }
+        
+        const char c = m_text[m_pos];
+        switch (c) {
+            case '{': return parseObject(depth + 1);
+            case '[': return parseArray(depth + 1);
+            case '"': return m_builder.string(parseString());
+            case 't': parseLiteral("true"); return m_builder.boolean(true);
+            case 'f': parseLiteral("false"); return m_builder.boolean(false);
+            case 'n': parseLiteral("null"); return m_builder.null();
+            default:
+                if (c == '-' || (c >= '0' && c <= '9')) {
+                    return parseNumber();
+                }
+                fail("Unexpected character " + describe(c));
+        }
+    }
+    
+    Value parseObject(size_t depth) {
+        if (depth > JsonParser::MaxDepth) {
+            fail("Maximum nesting depth exceeded");
+        }
+        
+        m_pos++; // Skip '{'
+        auto context = m_builder.beginObject();
+        
+        skipWhitespace();
+        if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+            m_pos++;
+            return m_builder.endObject(context);
+        }
+        
+        while (true) {
+            skipWhitespace();
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+                fail("Expected object key");
+            }
+            
+            // Take the key before parsing the value, which may reuse the scratch string
+            auto key = m_builder.key(parseString());
+            
+            skipWhitespace();
+            if (m_pos >= m_text.size() || m_text[m_pos] != ':') {
+                fail("Expected ':' after object key");
+            }
+            m_pos++;
+            
+            m_builder.addMember(context, std::move(key), parseValue(depth));
+            
+            skipWhitespace();
+            if (m_pos >= m_text.size()) {
+                fail("Unterminated object");
+            }
+            if (m_text[m_pos] == ',') {
+                m_pos++;
+                continue;
+            }
+            if (m_text[m_pos] == '}') {
+                m_pos++;
+                return m_builder.endObject(context);
+            }
+            fail("Expected ',' or '}' in object");
+        }
+    }
+    
+    Value parseArray(size_t depth) {
+        if (depth > JsonParser::MaxDepth) {
+            fail("Maximum nesting depth exceeded");
+        }
+        
+        m_pos++; // Skip '['
+        auto context = m_builder.beginArray();
+        
+        skipWhitespace();
+        if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+            m_pos++;
+            return m_builder.endArray(context);
+        }
+        
+        while (true) {
+            m_builder.addElement(context, parseValue(depth));
+            
+            skipWhitespace();
+            if (m_pos >= m_text.size()) {
+                fail("Unterminated array");
+            }
+            if (m_text[m_pos] == ',') {
+                m_pos++;
+                continue;
+            }
+            if (m_text[m_pos] == ']') {
+                m_pos++;
+                return m_builder.endArray(context);
+            }
+            fail("Expected ',' or ']' in array");
+        }
+    }
+    
+    void parseLiteral(std::string_view literal) {
+        if (m_text.substr(m_pos, literal.size()) != literal) {
+            fail("Invalid literal");
+        }
+        m_pos += literal.size();
+    }
+    
+    Value parseNumber() {
+        const size_t start = m_pos;
+        while (m_pos < m_text.size() && isNumberCharacter(m_text[m_pos])) {
+            m_pos++;
+        }
+        
+        JsonNumber number;
+        if (const char* error = parseJsonNumber(m_text.substr(start, m_pos - start), number)) {
+            m_pos = start;
+            fail(error);
+        }
+        
+        return m_builder.number(number);
+    }
+    
+    std::string_view parseString() {
+        m_pos++; // Skip opening quote
+        const size_t start = m_pos;
+        bool decoding = false; // Set at the first escape; until then the result is a view of the source
+        
+        while (true) {
+            // Scan the run of plain ASCII up to the next special byte in one go
+            const size_t runStart = m_pos;
+            while (m_pos < m_text.size()) {
+                const auto c = static_cast<unsigned char>(m_text[m_pos]);
+                if (c == '"' || c == '\\' || c < 0x20 || c >= 0x80) break;
+                m_pos++;
+            }
+            if (decoding) {
+                m_scratch.append(m_text.data() + runStart, m_pos - runStart);
+            }
+            
+            if (m_pos >= m_text.size()) {
+                fail("Unterminated string");
+            }
+            
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if (c == '"') {
+                m_pos++;
+                return decoding ? std::string_view(m_scratch) : m_text.substr(start, m_pos - 1 - start);
+            }
+            
+            if (c < 0x20) {
+                fail("Unescaped control character in string");
+            }
+            
+            if (c >= 0x80) {
+                const size_t sequenceStart = m_pos;
+                validateUtf8Sequence();
+                if (decoding) {
+                    m_scratch.append(m_text.data() + sequenceStart, m_pos - sequenceStart);
+                }
+                continue;
+            }
+            
+            // Escape sequence
+            if (!decoding) {
+                m_scratch.assign(m_text.data() + start, m_pos - start);
+                decoding = true;
+            }
+            
+            m_pos++;
+            if (m_pos >= m_text.size()) {
+                fail("Unterminated escape sequence");
+            }
+            
+            switch (m_text[m_pos++]) {
+                case '"': m_scratch += '"'; break;
+                case '\\': m_scratch += '\\'; break;
+                case '/': m_scratch += '/'; break;
+                case 'b': m_scratch += '\b'; break;
+                case 'f': m_scratch += '\f'; break;
+                case 'n': m_scratch += '\n'; break;
+                case 'r': m_scratch += '\r'; break;
+                case 't': m_scratch += '\t'; break;
+                case 'u': {
+                    uint32_t codepoint = parseHexQuad();
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                        if (m_text.substr(m_pos, 2) != "\\u") {
+                            fail("Unpaired high surrogate");
+                        }
+                        m_pos += 2;
+                        const uint32_t low = parseHexQuad();
+                        if (low < 0xDC00 || low > 0xDFFF) {
+                            fail("Invalid low surrogate");
+                        }
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+                        fail("Unpaired low surrogate");
+                    }
+                    appendUtf8(m_scratch, codepoint);
+                    break;
+                }
+                default:
+                    m_pos--;
+                    fail("Invalid escape sequence");
+            }
+        }
+    }
+    
+    uint32_t parseHexQuad() {
+        if (m_pos + 4 > m_text.size()) {
+            fail("Truncated \\u escape");
+        }
+        
+        uint32_t value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            const char c = m_text[m_pos++];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+            else {
+                m_pos--;
+                fail("Invalid hex digit in \\u escape");
+            }
+        }
+        return value;
+    }
+    
+    void validateUtf8Sequence() {
+        const size_t length = utf8SequenceLength(static_cast<unsigned char>(m_text[m_pos]));
+        if (length == 0) {
+            fail("Invalid UTF-8 lead byte");
+        }
+        if (m_pos + length > m_text.size()) {
+            fail("Truncated UTF-8 sequence");
+        }
+        if (!isValidUtf8Sequence(m_text.substr(m_pos, length))) {
+            fail("Invalid UTF-8 sequence");
+        }
+        m_pos += length;
+    }
+    
+    static std::string describe(char c) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (byte < 0x20 || byte >= 0x7F) {
+            char text[8];
+            std::snprintf(text, sizeof(text), "0x%02X", byte);
+            return text;
+        }
+        return std::string("'") + c + "'";
+    }
+    
+    std::string_view m_text;
+    Builder& m_builder;
+    size_t m_pos = 0;
+    std::string m_scratch;
+};
+
+} // namespace RoadSim::IO
@@ -1,16 +1,45 @@
 #include "JsonLoader.h"
+#include "JsonDocument.h"
+#include "JsonParser.h"
+#include "JsonStreamReader.h"
+#include "JsonWriter.h"
+#include "MapBinary.h"
+#include "MapDataHandler.h"
+#include "MappedFile.h"
+#include "../core/Trace.h"
+#include <chrono>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
 #include <iostream>
 #include <stdexcept>
 
 namespace RoadSim::IO {
 
+namespace {
+
+// Returned by const lookups that miss
+const JsonObject& nullObject() {
+    static const JsonObject null;
+    return null;
+}
+
+// Returned by mutable lookups that miss: per thread and reset on every miss,
+// so a write through it never leaks into later lookups
+JsonObject& detachedNullObject() {
+    thread_local JsonObject null;
+    null = JsonObject();
+    return null;
+}
+
+} // namespace
+
 // JsonObject implementation
 JsonObject::JsonObject() : m_value(nullptr) {}
 
 JsonObject::JsonObject(const JsonValue& value) : m_value(value) {}
 
+JsonObject::JsonObject(JsonValue&& value) : m_value(std::move(value)) {}
+
 JsonObject::~JsonObject() = default;
 
 JsonObject::JsonObject(const JsonObject& other) : m_value(other.m_value) {}
@@ -105,8 +134,7 @@ JsonObject& JsonObject::operator[](size_t index) {
             return (*arr)[index];
         }
     }
-    static JsonObject nullObj;
-    return nullObj;
+    return detachedNullObject();
 }
 
 const JsonObject& JsonObject::operator[](size_t index) const {
@@ -115,16 +143,14 @@ const JsonObject& JsonObject::operator[](size_t index) const {
             return (*arr)[index];
         }
     }
-    static JsonObject nullObj;
-    return nullObj;
+    return nullObject();
 }
 
 JsonObject& JsonObject::operator[](const std::string& key) {
     if (auto* obj = std::get_if<std::map<std::string, JsonObject>>(&m_value)) {
         return (*obj)[key];
     }
-    static JsonObject nullObj;
-    return nullObj;
+    return detachedNullObject();
 }
 
 const JsonObject& JsonObject::operator[](const std::string& key) const {
@@ -134,8 +160,7 @@ const JsonObject& JsonObject::operator[](const std::string& key) const {
             return it->second;
         }
     }
-    static JsonObject nullObj;
-    return nullObj;
+    return nullObject();
 }
 
 bool JsonObject::hasKey(const std::string& key) const {
@@ -159,23 +184,32 @@ std::vector<std::string> JsonObject::getKeys() const {
 struct JsonLoader::Impl {
     bool initialized = false;
     std::string lastError;
+    ParseStatistics lastParse;
     
-    // Simple JSON parsing state
-    size_t pos = 0;
-    std::string jsonText;
+    bool openFile(const std::string& filePath, MappedFile& file) {
+        if (!file.open(filePath)) {
+            lastError = file.getError();
+            std::cerr << "[IO] " << lastError << std::endl;
+            return false;
+        }
+        return true;
+    }
     
-    void skipWhitespace() {
-        while (pos < jsonText.length() && std::isspace(jsonText[pos])) {
-            pos++;
+    // Flush the writer's tail and report the result
+    bool finishWrite(JsonWriter& writer, const std::string& filePath) {
+        if (!writer.flush()) {
+            lastError = "Could not write file: " + filePath;
+            std::cerr << "[IO] " << lastError << std::endl;
+            return false;
         }
+        std::cout << "[IO] Wrote " << writer.getBytesWritten() / 1024 << " KB" << std::endl;
+        return true;
     }
     
-    JsonObject parseValue();
-    JsonObject parseObject();
-    JsonObject parseArray();
-    JsonObject parseString();
-    JsonObject parseNumber();
-    JsonObject parseLiteral();
+    void logParse() const {
+        std::cout << "[IO] Parsed " << lastParse.bytes / 1024 << " KB in " << lastParse.seconds * 1000.0
+                  << " ms (" << lastParse.megabytesPerSecond() << " MB/s)" << std::endl;
+    }
 };
 
 JsonLoader::JsonLoader() : m_impl(std::make_unique<Impl>()) {
@@ -192,6 +226,8 @@ void JsonLoader::initialize() {
 }
 
 bool JsonLoader::loadFromFile(const std::string& filePath, JsonObject& result) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonLoader::loadFromFile");
+    
     if (!m_impl->initialized) {
         m_impl->lastError = "JsonLoader not initialized";
         return false;
@@ -199,21 +235,55 @@ bool JsonLoader::loadFromFile(const std::string& filePath, JsonObject& result) {
     
     std::cout << "[IO] Loading JSON from: " << filePath << std::endl;
     
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        m_impl->lastError = "Could not open file: " + filePath;
-        std::cerr << "[IO] " << m_impl->lastError << std::endl;
+    MappedFile file;
+    if (!m_impl->openFile(filePath, file)) {
         return false;
     }
     
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string content = buffer.str();
+    if (!parseFromString(file.view(), result)) {
+        return false;
+    }
     
-    return parseFromString(content, result);
+    m_impl->logParse();
+    return true;
+}
+
+bool JsonLoader::loadFromFile(const std::string& filePath, JsonDocument& result) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonLoader::loadFromFile");
+    
+    if (!m_impl->initialized) {
+        m_impl->lastError = "JsonLoader not initialized";
+        return false;
+    }
+    
+    std::cout << "[IO] Loading JSON document from: " << filePath << std::endl;
+    
+    MappedFile file;
+    if (!m_impl->openFile(filePath, file)) {
+        return false;
+    }
+    
+    try {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t bytes = file.size();
+        
+        result.parse(std::move(file));
+        
+        m_impl->lastParse.bytes = bytes;
+        m_impl->lastParse.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } catch (const std::exception& e) {
+        m_impl->lastError = "JSON parsing error: " + std::string(e.what());
+        std::cerr << "[IO] " << m_impl->lastError << std::endl;
+        return false;
+    }
+    
+    m_impl->logParse();
+    return true;
 }
 
 bool JsonLoader::saveToFile(const std::string& filePath, const JsonObject& json, bool pretty) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonLoader::saveToFile");
+    
     if (!m_impl->initialized) {
         m_impl->lastError = "JsonLoader not initialized";
         return false;
@@ -221,30 +291,33 @@ bool JsonLoader::saveToFile(const std::string& filePath, const JsonObject& json,
     
     std::cout << "[IO] Saving JSON to: " << filePath << std::endl;
     
-    std::ofstream file(filePath);
+    std::ofstream file(filePath, std::ios::binary);
     if (!file.is_open()) {
         m_impl->lastError = "Could not create file: " + filePath;
         std::cerr << "[IO] " << m_impl->lastError << std::endl;
         return false;
     }
     
-    std::string jsonString = toString(json, pretty);
-    file << jsonString;
-    
-    return file.good();
+    JsonWriter writer(file, pretty);
+    writer.value(json);
+    return m_impl->finishWrite(writer, filePath);
 }
 
-bool JsonLoader::parseFromString(const std::string& jsonString, JsonObject& result) {
+bool JsonLoader::parseFromString(std::string_view jsonString, JsonObject& result) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonLoader::parseFromString");
+    
     if (!m_impl->initialized) {
         m_impl->lastError = "JsonLoader not initialized";
         return false;
     }
     
     try {
-        m_impl->jsonText = jsonString;
-        m_impl->pos = 0;
+        const auto start = std::chrono::steady_clock::now();
+        
+        result = JsonParser(jsonString).parse();
         
-        result = m_impl->parseValue();
+        m_impl->lastParse.bytes = jsonString.size();
+        m_impl->lastParse.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
         return true;
         
     } catch (const std::exception& e) {
@@ -255,20 +328,9 @@ bool JsonLoader::parseFromString(const std::string& jsonString, JsonObject& resu
 }
 
 std::string JsonLoader::toString(const JsonObject& json, bool pretty) {
-    // TODO: Implement JSON serialization
-    // This is a simplified placeholder implementation
-    (void)pretty; // Suppress unused parameter warning
-    if (json.isNull()) {
-        return "null";
-    } else if (json.isBool()) {
-        return json.asBool() ? "true" : "false";
-    } else if (json.isNumber()) {
-        return std::to_string(json.asDouble());
-    } else if (json.isString()) {
-        return "\"" + json.asString() + "\"";
-    } else {
-        return "{}"; // Placeholder for complex objects
-    }
+    JsonWriter writer(pretty);
+    writer.value(json);
+    return writer.take();
 }
 
 bool JsonLoader::validateFile(const std::string& filePath) {
@@ -280,31 +342,158 @@ std::string JsonLoader::getLastError() const {
     return m_impl->lastError;
 }
 
-bool JsonLoader::loadMapData(const std::string& filePath) {
+JsonLoader::ParseStatistics JsonLoader::getLastParseStatistics() const {
+    return m_impl->lastParse;
+}
+
+bool JsonLoader::loadMapData(const std::string& filePath, Core::MapData& map) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonLoader::loadMapData");
+    
+    if (!m_impl->initialized) {
+        m_impl->lastError = "JsonLoader not initialized";
+        return false;
+    }
+    
     std::cout << "[IO] Loading map data from: " << filePath << std::endl;
     
-    JsonObject mapJson;
-    if (!loadFromFile(filePath, mapJson)) {
+    const auto start = std::chrono::steady_clock::now();
+    if (MapBinary::isBinaryMapFile(filePath)) {
+        MapBinary binary;
+        if (!binary.open(filePath)) {
+            m_impl->lastError = binary.getError();
+            map.clear();
+            return false;
+        }
+        binary.toMapData(map);
+        std::error_code sizeError;
+        const auto bytes = std::filesystem::file_size(filePath, sizeError);
+        m_impl->lastParse.bytes = sizeError ? 0 : static_cast<size_t>(bytes);
+        m_impl->lastParse.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+    
+    map.clear();
+    MapDataHandler handler(map);
+    JsonStreamReader reader;
+    
+    if (!reader.parseFile(filePath, handler)) {
+        m_impl->lastError = reader.getLastError();
+        if (!handler.getError().empty()) m_impl->lastError += " (" + handler.getError() + ")";
+        std::cerr << "[IO] " << m_impl->lastError << std::endl;
+        map.clear();
         return false;
     }
     
-    // TODO: Parse map-specific data
-    // - Nodes (intersections)
-    // - Roads (connections between nodes)
-    // - Traffic lights
-    // - Spawn points
-    // - Map metadata (name, description, etc.)
+    m_impl->lastParse.bytes = reader.getBytesRead();
+    m_impl->lastParse.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     
+    std::cout << "[IO] Loaded map '" << map.name << "': " << map.nodes.size() << " nodes, "
+              << map.roads.size() << " roads, " << map.trafficLights.size() << " traffic lights, "
+              << map.spawnPoints.size() << " spawn points (" << m_impl->lastParse.megabytesPerSecond() << " MB/s)" << std::endl;
     return true;
 }
 
-bool JsonLoader::saveMapData(const std::string& filePath) {
+bool JsonLoader::saveMapData(const std::string& filePath, const Core::MapData& map, bool pretty) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonLoader::saveMapData");
+    
+    if (!m_impl->initialized) {
+        m_impl->lastError = "JsonLoader not initialized";
+        return false;
+    }
+    
     std::cout << "[IO] Saving map data to: " << filePath << std::endl;
     
-    // TODO: Serialize current map data to JSON
-    JsonObject mapJson;
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        m_impl->lastError = "Could not create file: " + filePath;
+        std::cerr << "[IO] " << m_impl->lastError << std::endl;
+        return false;
+    }
+    
+    JsonWriter writer(file, pretty);
+    writer.startObject();
+    writer.key("name");
+    writer.string(map.name);
+    
+    writer.key("nodes");
+    writer.startArray();
+    for (const Core::MapNode& node : map.nodes) {
+        writer.startObject();
+        writer.key("id"); writer.integer(node.id);
+        writer.key("x"); writer.number(node.x);
+        writer.key("y"); writer.number(node.y);
+        writer.endObject();
+    }
+    writer.endArray();
+    
+    writer.key("roads");
+    writer.startArray();
+    for (const Core::MapRoad& road : map.roads) {
+        writer.startObject();
+        writer.key("id"); writer.integer(road.id);
+        writer.key("fromNode"); writer.integer(road.fromNode);
+        writer.key("toNode"); writer.integer(road.toNode);
+        writer.key("lanes"); writer.integer(road.lanes);
+        writer.key("speedLimit"); writer.number(road.speedLimit);
+        writer.key("oneWay"); writer.boolean(road.oneWay);
+        writer.endObject();
+    }
+    writer.endArray();
+    
+    writer.key("trafficLights");
+    writer.startArray();
+    for (const Core::MapTrafficLight& light : map.trafficLights) {
+        writer.startObject();
+        writer.key("nodeId"); writer.integer(light.nodeId);
+        writer.key("cycleTime"); writer.number(light.cycleTime);
+        writer.key("offset"); writer.number(light.offset);
+        writer.endObject();
+    }
+    writer.endArray();
+    
+    writer.key("spawnPoints");
+    writer.startArray();
+    for (const Core::MapSpawnPoint& spawn : map.spawnPoints) {
+        writer.startObject();
+        writer.key("x"); writer.number(spawn.x);
+        writer.key("y"); writer.number(spawn.y);
+        writer.key("type"); writer.string(spawn.type);
+        writer.key("rate"); writer.number(spawn.rate);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+    
+    return m_impl->finishWrite(writer, filePath);
+}
+
+bool JsonLoader::saveMapBinary(const std::string& filePath, const Core::MapData& map) {
+    if (!m_impl->initialized) {
+        m_impl->lastError = "JsonLoader not initialized";
+        return false;
+    }
+    
+    std::cout << "[IO] Saving binary map data to: " << filePath << std::endl;
+    
+    if (!MapBinary::write(filePath, map, m_impl->lastError)) {
+        std::cerr << "[IO] " << m_impl->lastError << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool JsonLoader::convertMapFile(const std::string& inputPath, const std::string& outputPath) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonLoader::convertMapFile");
+    
+    Core::MapData map;
+    if (!loadMapData(inputPath, map)) {
+        return false;
+    }
     
-    return saveToFile(filePath, mapJson);
+    if (std::filesystem::path(outputPath).extension() == ".rsmap") {
+        return saveMapBinary(outputPath, map);
+    }
+    return saveMapData(outputPath, map, true);
 }
 
 bool JsonLoader::loadEntityProfiles(const std::string& filePath) {
@@ -358,120 +547,4 @@ bool JsonLoader::saveScenario(const std::string& filePath) {
     return saveToFile(filePath, scenarioJson);
 }
 
-// Simple JSON parsing implementation
-JsonObject JsonLoader::Impl::parseValue() {
-    skipWhitespace();
-    
-    if (pos >= jsonText.length()) {
-        throw std::runtime_error("Unexpected end of JSON");
-    }
-    
-    char c = jsonText[pos];
-    
-    switch (c) {
-        case '{': return parseObject();
-        case '[': return parseArray();
-        case '"': return parseString();
-        case 't':
-        case 'f':
-        case 'n': return parseLiteral();
-        default:
-            if (c == '-' || std::isdigit(c)) {
-                return parseNumber();
-            }
-            throw std::runtime_error("Unexpected character: " + std::string(1, c));
-    }
-}
-
-JsonObject JsonLoader::Impl::parseObject() {
-    // TODO: Implement object parsing
-    pos++; // Skip '{'
-    skipWhitespace();
-    
-    std::map<std::string, JsonObject> obj;
-    
-    if (pos < jsonText.length() && jsonText[pos] == '}') {
-        pos++; // Skip '}'
-        return JsonObject(obj);
-    }
-    
-    // Simplified: just skip to closing brace
-    while (pos < jsonText.length() && jsonText[pos] != '}') {
-        pos++;
-    }
-    if (pos < jsonText.length()) pos++; // Skip '}'
-    
-    return JsonObject(obj);
-}
-
-JsonObject JsonLoader::Impl::parseArray() {
-    // TODO: Implement array parsing
-    pos++; // Skip '['
-    skipWhitespace();
-    
-    std::vector<JsonObject> arr;
-    
-    if (pos < jsonText.length() && jsonText[pos] == ']') {
-        pos++; // Skip ']'
-        return JsonObject(arr);
-    }
-    
-    // Simplified: just skip to closing bracket
-    while (pos < jsonText.length() && jsonText[pos] != ']') {
-        pos++;
-    }
-    if (pos < jsonText.length()) pos++; // Skip ']'
-    
-    return JsonObject(arr);
-}
-
-JsonObject JsonLoader::Impl::parseString() {
-    pos++; // Skip opening quote
-    
-    std::string str;
-    while (pos < jsonText.length() && jsonText[pos] != '"') {
-        str += jsonText[pos];
-        pos++;
-    }
-    
-    if (pos < jsonText.length()) pos++; // Skip closing quote
-    
-    return JsonObject(str);
-}
-
-JsonObject JsonLoader::Impl::parseNumber() {
-    std::string numStr;
-    
-    while (pos < jsonText.length() && 
-           (std::isdigit(jsonText[pos]) || jsonText[pos] == '.' || 
-            jsonText[pos] == '-' || jsonText[pos] == '+' || 
-            jsonText[pos] == 'e' || jsonText[pos] == 'E')) {
-        numStr += jsonText[pos];
-        pos++;
-    }
-    
-    if (numStr.find('.') != std::string::npos || 
-        numStr.find('e') != std::string::npos || 
-        numStr.find('E') != std::string::npos) {
-        return JsonObject(std::stod(numStr));
-    } else {
-        return JsonObject(static_cast<int64_t>(std::stoll(numStr)));
-    }
-}
-
-JsonObject JsonLoader::Impl::parseLiteral() {
-    if (jsonText.substr(pos, 4) == "true") {
-        pos += 4;
-        return JsonObject(true);
-    } else if (jsonText.substr(pos, 5) == "false") {
-        pos += 5;
-        return JsonObject(false);
-    } else if (jsonText.substr(pos, 4) == "null") {
-        pos += 4;
-        return JsonObject(nullptr);
-    }
-    
-    throw std::runtime_error("Invalid literal");
-}
-
 } // namespace RoadSim::IO
\ No newline at end of file
@@ -1,13 +1,18 @@
 #pragma once
 
+#include "../core/MapData.h"
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <variant>
 
 namespace RoadSim::IO {
 
+class JsonDocument;
+
 // JSON value types
 using JsonValue = std::variant<
     std::nullptr_t,
@@ -27,6 +32,7 @@ class JsonObject {
 public:
     JsonObject();
     JsonObject(const JsonValue& value);
+    JsonObject(JsonValue&& value);
     ~JsonObject();
     
     // Copy and move constructors
@@ -112,6 +118,11 @@ public:
      */
     std::vector<std::string> getKeys() const;
     
+    /**
+     * @brief Get the underlying value (for serialization)
+     */
+    const JsonValue& getValue() const { return m_value; }
+    
 private:
     JsonValue m_value;
 };
@@ -146,8 +157,18 @@ public:
      */
     bool loadFromFile(const std::string& filePath, JsonObject& result);
     
+    /**
+     * @brief Load JSON from file into an arena-backed document
+     * Much cheaper than JsonObject for large files; the document keeps the file text.
+     * @param filePath Path to JSON file
+     * @param result Output document
+     * @return Success status
+     */
+    bool loadFromFile(const std::string& filePath, JsonDocument& result);
+    
     /**
      * @brief Save JSON to file
+     * Streams through JsonWriter; the text is never held in memory whole.
      * @param filePath Path to save file
      * @param json JSON object to save
      * @param pretty Enable pretty printing
@@ -156,15 +177,16 @@ public:
     bool saveToFile(const std::string& filePath, const JsonObject& json, bool pretty = true);
     
     /**
-     * @brief Parse JSON from string
-     * @param jsonString JSON string to parse
+     * @brief Parse JSON from string (RFC 8259)
+     * Errors report line and column through getLastError()
+     * @param jsonString JSON text to parse
      * @param result Output JSON object
      * @return Success status
      */
-    bool parseFromString(const std::string& jsonString, JsonObject& result);
+    bool parseFromString(std::string_view jsonString, JsonObject& result);
     
     /**
-     * @brief Convert JSON object to string
+     * @brief Convert JSON object to string (see JsonWriter)
      * @param json JSON object to convert
      * @param pretty Enable pretty printing
      * @return JSON string
@@ -184,18 +206,59 @@ public:
     std::string getLastError() const;
     
     /**
-     * @brief Load map data from JSON
+     * @brief Size and duration of the most recent parse
+     */
+    struct ParseStatistics {
+        size_t bytes = 0;
+        double seconds = 0.0;
+        
+        double megabytesPerSecond() const {
+            return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+        }
+    };
+    
+    ParseStatistics getLastParseStatistics() const;
+    
+    /**
+     * @brief Load map data from JSON or a binary map (detected by its magic)
+     * Streams the file straight into the map tables without building a DOM.
+     * Expects a root object with "name" and arrays "nodes" {id, x, y},
+     * "roads" {id, fromNode, toNode, lanes, speedLimit, oneWay},
+     * "trafficLights" {nodeId, cycleTime, offset} and
+     * "spawnPoints" {x, y, type, rate}; unknown keys are ignored.
      * @param filePath Path to map JSON file
+     * @param map Output map tables (cleared first)
      * @return Success status
      */
-    bool loadMapData(const std::string& filePath);
+    bool loadMapData(const std::string& filePath, Core::MapData& map);
     
     /**
      * @brief Save map data to JSON
+     * Writes the tables straight to the file in the loadMapData schema.
      * @param filePath Path to save map JSON
+     * @param map Map tables to write
+     * @param pretty Enable pretty printing
+     * @return Success status
+     */
+    bool saveMapData(const std::string& filePath, const Core::MapData& map, bool pretty = true);
+    
+    /**
+     * @brief Save map data as a binary map (see MapBinary)
+     * @param filePath Path to save .rsmap file
+     * @param map Map tables to write
+     * @return Success status
+     */
+    bool saveMapBinary(const std::string& filePath, const Core::MapData& map);
+    
+    /**
+     * @brief Convert a map between JSON and the binary format
+     * The input format is detected from its contents; the output is binary
+     * when its extension is .rsmap and pretty-printed JSON otherwise.
+     * @param inputPath Map to read
+     * @param outputPath Map to write
      * @return Success status
      */
-    bool saveMapData(const std::string& filePath);
+    bool convertMapFile(const std::string& inputPath, const std::string& outputPath);
     
     /**
      * @brief Load entity profiles from JSON
@@ -0,0 +1,181 @@
+#include "JsonParser.h"
+#include "JsonGrammar.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace RoadSim::IO {
+
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Builds the std::map/std::vector JsonObject tree
+struct ObjectBuilder {
+    using Value = JsonObject;
+    using Key = std::string;
+    using ArrayContext = std::vector<JsonObject>;
+    using ObjectContext = std::map<std::string, JsonObject>;
+    
+    Value null() { return JsonObject(nullptr); }
+    Value boolean(bool value) { return JsonObject(value); }
+    Value number(const JsonNumber& number) { return number.isInteger ? JsonObject(number.integer) : JsonObject(number.real); }
+    Value string(std::string_view value) { return JsonObject(std::string(value)); }
+    Key key(std::string_view name) { return std::string(name); }
+    
+    ArrayContext beginArray() { return {}; }
+    void addElement(ArrayContext& array, Value&& value) { array.push_back(std::move(value)); }
+    Value endArray(ArrayContext& array) { return JsonObject(std::move(array)); }
+    
+    ObjectContext beginObject() { return {}; }
+    
+    void addMember(ObjectContext& object, Key&& key, Value&& value) {
+        // Duplicate names: the last one wins
+        object.insert_or_assign(std::move(key), std::move(value));
+    }
+    
+    Value endObject(ObjectContext& object) { return JsonObject(std::move(object)); }
+};
+
+} // namespace
+
+void appendUtf8(std::string& out, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+        out += static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codepoint >> 6));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codepoint >> 12));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codepoint >> 18));
+        out += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+}
+
+size_t utf8SequenceLength(unsigned char lead) {
+    if ((lead & 0x80) == 0x00) return 1;
+    if ((lead & 0xE0) == 0xC0) return 2;
+    if ((lead & 0xF0) == 0xE0) return 3;
+    if ((lead & 0xF8) == 0xF0) return 4;
+    return 0;
+}
+
+bool isValidUtf8Sequence(std::string_view sequence) {
+    static constexpr uint32_t Minimum[] = {0, 0, 0x80, 0x800, 0x10000};
+    
+    const size_t length = sequence.empty() ? 0 : utf8SequenceLength(static_cast<unsigned char>(sequence[0]));
+    if (length == 0 || length != sequence.size()) return false;
+    if (length == 1) return true;
+    
+    uint32_t codepoint = static_cast<unsigned char>(sequence[0]) & (0x7F >> length);
+    for (size_t i = 1; i < length; ++i) {
+        const auto continuation = static_cast<unsigned char>(sequence[i]);
+        if ((continuation & 0xC0) != 0x80) return false;
+        codepoint = (codepoint << 6) | (continuation & 0x3F);
+    }
+    
+    // Reject overlong encodings, UTF-16 surrogates and values past U+10FFFF
+    return codepoint >= Minimum[length] && codepoint <= 0x10FFFF && (codepoint < 0xD800 || codepoint > 0xDFFF);
+}
+
+bool isNumberCharacter(char c) {
+    return isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+const char* parseJsonNumber(std::string_view token, JsonNumber& out) {
+    // Validate the RFC 8259 grammar first; from_chars is more lenient
+    size_t pos = 0;
+    bool negativeExponent = false;
+    out.isInteger = true;
+    
+    auto digitAt = [&token](size_t i) { return i < token.size() && isDigit(token[i]); };
+    
+    if (pos < token.size() && token[pos] == '-') pos++;
+    
+    if (pos < token.size() && token[pos] == '0') {
+        pos++;
+        if (digitAt(pos)) return "Leading zeros are not allowed";
+    } else if (digitAt(pos)) {
+        while (digitAt(pos)) pos++;
+    } else {
+        return "Invalid number";
+    }
+    
+    if (pos < token.size() && token[pos] == '.') {
+        out.isInteger = false;
+        pos++;
+        if (!digitAt(pos)) return "Expected digit after decimal point";
+        while (digitAt(pos)) pos++;
+    }
+    
+    if (pos < token.size() && (token[pos] == 'e' || token[pos] == 'E')) {
+        out.isInteger = false;
+        pos++;
+        if (pos < token.size() && (token[pos] == '+' || token[pos] == '-')) {
+            negativeExponent = token[pos] == '-';
+            pos++;
+        }
+        if (!digitAt(pos)) return "Expected digit in exponent";
+        while (digitAt(pos)) pos++;
+    }
+    
+    if (pos != token.size()) return "Invalid number";
+    
+    const char* first = token.data();
+    const char* last = token.data() + token.size();
+    
+    if (out.isInteger) {
+        auto [ptr, ec] = std::from_chars(first, last, out.integer);
+        if (ec == std::errc() && ptr == last) {
+            return nullptr;
+        }
+        // Too large for int64_t: read as double
+        out.isInteger = false;
+    }
+    
+    auto [ptr, ec] = std::from_chars(first, last, out.real);
+    if (ec == std::errc::result_out_of_range && negativeExponent) {
+        out.real = *first == '-' ? -0.0 : 0.0; // Underflow
+        return nullptr;
+    }
+    if (ec != std::errc() || ptr != last) {
+        return "Number out of range";
+    }
+    return nullptr;
+}
+
+JsonParseError::JsonParseError(const std::string& message, size_t offset, size_t line, size_t column)
+    : std::runtime_error(message + " at line " + std::to_string(line) + ", column " + std::to_string(column))
+    , m_offset(offset), m_line(line), m_column(column) {}
+
+JsonParser::JsonParser(std::string_view text) : m_text(text) {}
+
+JsonObject JsonParser::parse() {
+    ObjectBuilder builder;
+    return JsonGrammar<ObjectBuilder>(m_text, builder).parse();
+}
+
+void JsonParser::locate(std::string_view text, size_t offset, size_t& line, size_t& column) {
+    // Only used on the error path, so a rescan from the start is fine
+    line = 1;
+    size_t lineStart = 0;
+    offset = std::min(offset, text.size());
+    for (size_t i = 0; i < offset; ++i) {
+        if (text[i] == '\n') {
+            line++;
+            lineStart = i + 1;
+        }
+    }
+    column = offset - lineStart + 1;
+}
+
+} // namespace RoadSim::IO
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "JsonLoader.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief JSON syntax error with its position in the source text
+ */
+class JsonParseError : public std::runtime_error {
+public:
+    JsonParseError(const std::string& message, size_t offset, size_t line, size_t column);
+    
+    size_t getOffset() const { return m_offset; }
+    size_t getLine() const { return m_line; }
+    size_t getColumn() const { return m_column; }
+    
+private:
+    size_t m_offset;
+    size_t m_line;
+    size_t m_column;
+};
+
+/**
+ * @brief A JSON number converted with std::from_chars
+ */
+struct JsonNumber {
+    bool isInteger = true;
+    int64_t integer = 0;
+    double real = 0.0;
+};
+
+/**
+ * @brief Validate and convert a complete RFC 8259 number token
+ * Integers that do not fit int64_t are returned as doubles.
+ * @return Error description, or nullptr on success
+ */
+const char* parseJsonNumber(std::string_view token, JsonNumber& out);
+
+/**
+ * @brief Check whether a character can be part of a number token
+ */
+bool isNumberCharacter(char c);
+
+/**
+ * @brief Append a Unicode code point encoded as UTF-8
+ */
+void appendUtf8(std::string& out, uint32_t codepoint);
+
+/**
+ * @brief Length of the UTF-8 sequence starting with a lead byte (0 if invalid)
+ */
+size_t utf8SequenceLength(unsigned char lead);
+
+/**
+ * @brief Check one complete UTF-8 sequence (no overlongs, surrogates or values past U+10FFFF)
+ */
+bool isValidUtf8Sequence(std::string_view sequence);
+
+/**
+ * @brief RFC 8259 JSON parser working in place on a string_view
+ * Strings are copied in runs between escapes rather than per character,
+ * numbers go through std::from_chars, escapes (including surrogate pairs)
+ * are decoded to UTF-8 and raw UTF-8 is validated. Integers that do not fit
+ * int64_t are read as doubles. A leading UTF-8 byte order mark is skipped.
+ */
+class JsonParser {
+public:
+    static constexpr size_t MaxDepth = 512;
+    
+    /**
+     * @brief Create a parser over text that must outlive it
+     */
+    explicit JsonParser(std::string_view text);
+    
+    /**
+     * @brief Parse the whole text as a single JSON value
+     * @throws JsonParseError on malformed input or trailing content
+     */
+    JsonObject parse();
+    
+    /**
+     * @brief Compute 1-based line and column (in bytes) of an offset
+     */
+    static void locate(std::string_view text, size_t offset, size_t& line, size_t& column);
+    
+private:
+    std::string_view m_text;
+};
+
+} // namespace RoadSim::IO
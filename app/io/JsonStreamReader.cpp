@@ -0,0 +1,371 @@
+#include "JsonStreamReader.h"
+#include "JsonParser.h"
+#include "MappedFile.h"
+#include "../core/Trace.h"
+#include <fstream>
+#include <vector>
+
+namespace RoadSim::IO {
+
+struct JsonStreamReader::Impl {
+    std::vector<char> buffer;
+    std::istream* input = nullptr; // Null when parsing an in-memory view
+    const char* window = nullptr;  // The buffer, or the whole in-memory view
+    size_t begin = 0;              // Next unread byte in window
+    size_t end = 0;                // End of valid bytes in window
+    size_t consumedBefore = 0;     // Stream offset of window[0]
+    size_t line = 1;
+    size_t lineStart = 0;          // Stream offset of the current line
+    
+    std::string token;             // Scratch for strings and numbers, reused across tokens
+    std::vector<char> stack;       // Open containers ('{' or '[')
+    std::string lastError;
+    size_t bytesRead = 0;
+    
+    size_t offset() const {
+        return consumedBefore + begin;
+    }
+    
+    bool fill() {
+        consumedBefore += end;
+        begin = 0;
+        end = 0;
+        if (!input || !*input) return false;
+        
+        window = buffer.data();
+        input->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        end = static_cast<size_t>(input->gcount());
+        if (input->bad()) {
+            fail("Read error");
+        }
+        return end > 0;
+    }
+    
+    int peek() {
+        if (begin == end && !fill()) return -1;
+        return static_cast<unsigned char>(window[begin]);
+    }
+    
+    [[noreturn]] void fail(const std::string& message) const {
+        const size_t position = offset();
+        throw JsonParseError(message, position, line, position - lineStart + 1);
+    }
+    
+    void skipWhitespace() {
+        while (true) {
+            if (begin == end && !fill()) return;
+            const char c = window[begin];
+            if (c == '\n') {
+                line++;
+                lineStart = offset() + 1;
+            } else if (c != ' ' && c != '\t' && c != '\r') {
+                return;
+            }
+            begin++;
+        }
+    }
+    
+    void emit(bool keepGoing) const {
+        if (!keepGoing) {
+            fail("Parsing stopped by handler");
+        }
+    }
+    
+    void readLiteral(std::string_view literal) {
+        for (char expected : literal) {
+            if (peek() != static_cast<unsigned char>(expected)) {
+                fail("Invalid literal");
+            }
+            begin++;
+        }
+    }
+    
+    void readNumber() {
+        token.clear();
+        int c = peek();
+        while (c >= 0 && isNumberCharacter(static_cast<char>(c))) {
+            token += static_cast<char>(c);
+            begin++;
+            c = peek();
+        }
+    }
+    
+    uint32_t readHexQuad() {
+        uint32_t value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            const int c = peek();
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+            else fail("Invalid hex digit in \\u escape");
+            begin++;
+        }
+        return value;
+    }
+    
+    void readString() {
+        begin++; // Skip opening quote
+        token.clear();
+        
+        while (true) {
+            if (begin == end && !fill()) {
+                fail("Unterminated string");
+            }
+            
+            // Copy the run of plain ASCII up to the next special byte or the end of the buffer
+            size_t run = begin;
+            while (run < end) {
+                const auto c = static_cast<unsigned char>(window[run]);
+                if (c == '"' || c == '\\' || c < 0x20 || c >= 0x80) break;
+                run++;
+            }
+            token.append(window + begin, run - begin);
+            begin = run;
+            if (begin == end) continue;
+            
+            const auto c = static_cast<unsigned char>(window[begin]);
+            if (c == '"') {
+                begin++;
+                return;
+            }
+            
+            if (c < 0x20) {
+                fail("Unescaped control character in string");
+            }
+            
+            if (c >= 0x80) {
+                // The sequence may straddle two buffer fills
+                const size_t length = utf8SequenceLength(c);
+                if (length == 0) {
+                    fail("Invalid UTF-8 lead byte");
+                }
+                char sequence[4];
+                for (size_t i = 0; i < length; ++i) {
+                    const int byte = peek();
+                    if (byte < 0) {
+                        fail("Truncated UTF-8 sequence");
+                    }
+                    sequence[i] = static_cast<char>(byte);
+                    begin++;
+                }
+                if (!isValidUtf8Sequence(std::string_view(sequence, length))) {
+                    fail("Invalid UTF-8 sequence");
+                }
+                token.append(sequence, length);
+                continue;
+            }
+            
+            // Escape sequence
+            begin++;
+            const int escape = peek();
+            if (escape < 0) {
+                fail("Unterminated escape sequence");
+            }
+            begin++;
+            
+            switch (escape) {
+                case '"': token += '"'; break;
+                case '\\': token += '\\'; break;
+                case '/': token += '/'; break;
+                case 'b': token += '\b'; break;
+                case 'f': token += '\f'; break;
+                case 'n': token += '\n'; break;
+                case 'r': token += '\r'; break;
+                case 't': token += '\t'; break;
+                case 'u': {
+                    uint32_t codepoint = readHexQuad();
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                        if (peek() != '\\') fail("Unpaired high surrogate");
+                        begin++;
+                        if (peek() != 'u') fail("Unpaired high surrogate");
+                        begin++;
+                        const uint32_t low = readHexQuad();
+                        if (low < 0xDC00 || low > 0xDFFF) {
+                            fail("Invalid low surrogate");
+                        }
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+                        fail("Unpaired low surrogate");
+                    }
+                    appendUtf8(token, codepoint);
+                    break;
+                }
+                default:
+                    fail("Invalid escape sequence");
+            }
+        }
+    }
+    
+    // Emits one value; returns true if it opened a container
+    bool readValue(JsonHandler& handler) {
+        skipWhitespace();
+        
+        const int c = peek();
+        if (c < 0) {
+            fail("Unexpected end of JSON");
+        }
+        
+        switch (c) {
+            case '{':
+            case '[':
+                if (stack.size() >= JsonParser::MaxDepth) {
+                    fail("Maximum nesting depth exceeded");
+                }
+                begin++;
+                stack.push_back(static_cast<char>(c));
+                emit(c == '{' ? handler.startObject() : handler.startArray());
+                return true;
+            case '"':
+                readString();
+                emit(handler.string(token));
+                return false;
+            case 't': readLiteral("true"); emit(handler.boolean(true)); return false;
+            case 'f': readLiteral("false"); emit(handler.boolean(false)); return false;
+            case 'n': readLiteral("null"); emit(handler.null()); return false;
+            default:
+                break;
+        }
+        
+        if (c != '-' && (c < '0' || c > '9')) {
+            fail("Unexpected character");
+        }
+        
+        readNumber();
+        JsonNumber number;
+        if (const char* error = parseJsonNumber(token, number)) {
+            fail(error);
+        }
+        emit(number.isInteger ? handler.integer(number.integer) : handler.number(number.real));
+        return false;
+    }
+    
+    void run(JsonHandler& handler) {
+        // Skip a UTF-8 byte order mark
+        if (peek() == 0xEF) {
+            readLiteral("\xEF\xBB\xBF");
+        }
+        
+        bool justOpened = readValue(handler);
+        
+        while (!stack.empty()) {
+            skipWhitespace();
+            
+            const char container = stack.back();
+            const int c = peek();
+            if (c < 0) {
+                fail(container == '{' ? "Unterminated object" : "Unterminated array");
+            }
+            
+            if (c == (container == '{' ? '}' : ']')) {
+                begin++;
+                stack.pop_back();
+                emit(container == '{' ? handler.endObject() : handler.endArray());
+                justOpened = false;
+                continue;
+            }
+            
+            if (!justOpened) {
+                if (c != ',') {
+                    fail(container == '{' ? "Expected ',' or '}' in object" : "Expected ',' or ']' in array");
+                }
+                begin++;
+                skipWhitespace();
+            }
+            
+            if (container == '{') {
+                if (peek() != '"') {
+                    fail("Expected object key");
+                }
+                readString();
+                emit(handler.key(token));
+                
+                skipWhitespace();
+                if (peek() != ':') {
+                    fail("Expected ':' after object key");
+                }
+                begin++;
+            }
+            
+            justOpened = readValue(handler);
+        }
+        
+        skipWhitespace();
+        if (peek() >= 0) {
+            fail("Unexpected content after JSON value");
+        }
+    }
+};
+
+JsonStreamReader::JsonStreamReader(size_t bufferSize) : m_impl(std::make_unique<Impl>()) {
+    m_impl->buffer.resize(bufferSize > 0 ? bufferSize : DefaultBufferSize);
+}
+
+JsonStreamReader::~JsonStreamReader() = default;
+
+bool JsonStreamReader::parse(std::istream& input, JsonHandler& handler) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonStreamReader::parse");
+    
+    m_impl->input = &input;
+    m_impl->window = m_impl->buffer.data();
+    m_impl->end = 0;
+    return run(handler);
+}
+
+bool JsonStreamReader::parse(std::string_view text, JsonHandler& handler) {
+    ROADSIM_TRACE_SCOPE("IO", "JsonStreamReader::parse");
+    
+    // The text is the window: no buffering and no copy
+    m_impl->input = nullptr;
+    m_impl->window = text.data();
+    m_impl->end = text.size();
+    return run(handler);
+}
+
+bool JsonStreamReader::run(JsonHandler& handler) {
+    Impl& impl = *m_impl;
+    impl.begin = 0;
+    impl.consumedBefore = 0;
+    impl.line = 1;
+    impl.lineStart = 0;
+    impl.stack.clear();
+    impl.lastError.clear();
+    
+    bool success = true;
+    try {
+        impl.run(handler);
+    } catch (const JsonParseError& e) {
+        impl.lastError = "JSON parsing error: " + std::string(e.what());
+        success = false;
+    }
+    
+    impl.bytesRead = impl.offset();
+    impl.input = nullptr;
+    impl.window = nullptr;
+    return success;
+}
+
+bool JsonStreamReader::parseFile(const std::string& filePath, JsonHandler& handler) {
+    // Parse a mapping in place; only unmappable files go through the buffer
+    MappedFile mapped;
+    if (mapped.open(filePath, false)) {
+        return parse(mapped.view(), handler);
+    }
+    
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        m_impl->lastError = "Could not open file: " + filePath;
+        return false;
+    }
+    return parse(file, handler);
+}
+
+std::string JsonStreamReader::getLastError() const {
+    return m_impl->lastError;
+}
+
+size_t JsonStreamReader::getBytesRead() const {
+    return m_impl->bytesRead;
+}
+
+} // namespace RoadSim::IO
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief Receives events from JsonStreamReader
+ * String views are only valid during the call. Returning false stops parsing.
+ */
+class JsonHandler {
+public:
+    virtual ~JsonHandler() = default;
+    
+    virtual bool startObject() { return true; }
+    virtual bool endObject() { return true; }
+    virtual bool startArray() { return true; }
+    virtual bool endArray() { return true; }
+    virtual bool key(std::string_view name) { (void)name; return true; }
+    virtual bool null() { return true; }
+    virtual bool boolean(bool value) { (void)value; return true; }
+    virtual bool integer(int64_t value) { (void)value; return true; }
+    virtual bool number(double value) { (void)value; return true; }
+    virtual bool string(std::string_view value) { (void)value; return true; }
+};
+
+/**
+ * @brief Event-driven (SAX-style) JSON reader for files too large for a DOM
+ * Reads streams through a fixed-size buffer and keeps no document in memory:
+ * memory use is the buffer plus the longest string or number token. Accepts
+ * the same RFC 8259 grammar as JsonParser.
+ */
+class JsonStreamReader {
+public:
+    static constexpr size_t DefaultBufferSize = 64 * 1024;
+    
+    explicit JsonStreamReader(size_t bufferSize = DefaultBufferSize);
+    ~JsonStreamReader();
+    
+    // Non-copyable
+    JsonStreamReader(const JsonStreamReader&) = delete;
+    JsonStreamReader& operator=(const JsonStreamReader&) = delete;
+    
+    /**
+     * @brief Parse one JSON document from a stream
+     * @param input Source stream (read in binary chunks)
+     * @param handler Event receiver
+     * @return Success status (see getLastError)
+     */
+    bool parse(std::istream& input, JsonHandler& handler);
+    
+    /**
+     * @brief Parse one JSON document held in memory (e.g. a MappedFile view)
+     */
+    bool parse(std::string_view text, JsonHandler& handler);
+    
+    /**
+     * @brief Parse one JSON document from a file
+     * Memory-mapped files are parsed in place; others are streamed through the buffer.
+     */
+    bool parseFile(const std::string& filePath, JsonHandler& handler);
+    
+    /**
+     * @brief Get last error message, with line and column for syntax errors
+     */
+    std::string getLastError() const;
+    
+    /**
+     * @brief Bytes consumed by the last parse
+     */
+    size_t getBytesRead() const;
+    
+private:
+    bool run(JsonHandler& handler);
+    
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::IO
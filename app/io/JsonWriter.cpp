@@ -0,0 +1,238 @@
+#include "JsonWriter.h"
+#include "JsonDocument.h"
+#include "JsonLoader.h"
+#include <charconv>
+#include <cmath>
+#include <type_traits>
+
+namespace RoadSim::IO {
+
+namespace {
+
+// Append a finite floating-point value, keeping it recognisable as a double
+template <typename Real>
+void appendReal(std::string& out, Real value) {
+    char text[32];
+    const auto result = std::to_chars(text, text + sizeof(text), value);
+    const std::string_view digits(text, static_cast<size_t>(result.ptr - text));
+    out.append(digits);
+    if (digits.find_first_of(".e") == std::string_view::npos) {
+        out.append(".0");
+    }
+}
+
+} // namespace
+
+JsonWriter::JsonWriter(bool pretty) : m_pretty(pretty) {}
+
+JsonWriter::JsonWriter(std::ostream& output, bool pretty, size_t flushThreshold)
+    : m_output(&output), m_flushThreshold(flushThreshold), m_pretty(pretty) {
+    m_buffer.reserve(flushThreshold + flushThreshold / 4);
+}
+
+bool JsonWriter::startObject() {
+    beforeValue();
+    m_buffer += '{';
+    m_hasElements.push_back(false);
+    return afterWrite();
+}
+
+bool JsonWriter::endObject() {
+    const bool hadElements = m_hasElements.back();
+    m_hasElements.pop_back();
+    if (hadElements) newline();
+    m_buffer += '}';
+    return afterWrite();
+}
+
+bool JsonWriter::startArray() {
+    beforeValue();
+    m_buffer += '[';
+    m_hasElements.push_back(false);
+    return afterWrite();
+}
+
+bool JsonWriter::endArray() {
+    const bool hadElements = m_hasElements.back();
+    m_hasElements.pop_back();
+    if (hadElements) newline();
+    m_buffer += ']';
+    return afterWrite();
+}
+
+bool JsonWriter::key(std::string_view name) {
+    beforeValue();
+    writeEscaped(name);
+    m_buffer += m_pretty ? ": " : ":";
+    m_afterKey = true;
+    return true;
+}
+
+bool JsonWriter::null() {
+    beforeValue();
+    m_buffer.append("null");
+    return afterWrite();
+}
+
+bool JsonWriter::boolean(bool value) {
+    beforeValue();
+    m_buffer.append(value ? "true" : "false");
+    return afterWrite();
+}
+
+bool JsonWriter::integer(int64_t value) {
+    beforeValue();
+    char text[24];
+    const auto result = std::to_chars(text, text + sizeof(text), value);
+    m_buffer.append(text, static_cast<size_t>(result.ptr - text));
+    return afterWrite();
+}
+
+bool JsonWriter::number(double value) {
+    if (!std::isfinite(value)) return null();
+    beforeValue();
+    appendReal(m_buffer, value);
+    return afterWrite();
+}
+
+bool JsonWriter::number(float value) {
+    if (!std::isfinite(value)) return null();
+    beforeValue();
+    appendReal(m_buffer, value);
+    return afterWrite();
+}
+
+bool JsonWriter::string(std::string_view value) {
+    beforeValue();
+    writeEscaped(value);
+    return afterWrite();
+}
+
+bool JsonWriter::value(const JsonObject& json) {
+    return std::visit([this](const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            return null();
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return boolean(value);
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            return integer(value);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return number(value);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return string(value);
+        } else if constexpr (std::is_same_v<T, std::vector<JsonObject>>) {
+            startArray();
+            for (const JsonObject& element : value) {
+                if (!this->value(element)) return false;
+            }
+            return endArray();
+        } else {
+            startObject();
+            for (const auto& [name, member] : value) {
+                key(name);
+                if (!this->value(member)) return false;
+            }
+            return endObject();
+        }
+    }, json.getValue());
+}
+
+bool JsonWriter::value(const JsonNode& node) {
+    switch (node.getType()) {
+        case JsonNode::Type::Null: return null();
+        case JsonNode::Type::Bool: return boolean(node.asBool());
+        case JsonNode::Type::Integer: return integer(node.asInt());
+        case JsonNode::Type::Double: return number(node.asDouble());
+        case JsonNode::Type::String: return string(node.asString());
+        case JsonNode::Type::Array:
+            startArray();
+            for (size_t i = 0; i < node.size(); ++i) {
+                if (!value(node[i])) return false;
+            }
+            return endArray();
+        case JsonNode::Type::Object:
+            startObject();
+            for (const JsonMember* it = node.membersBegin(); it != node.membersEnd(); ++it) {
+                key(it->key);
+                if (!value(it->value)) return false;
+            }
+            return endObject();
+    }
+    return false;
+}
+
+bool JsonWriter::flush() {
+    if (!m_output) return true;
+    if (!m_buffer.empty()) {
+        m_output->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_flushed += m_buffer.size();
+        m_buffer.clear();
+    }
+    return m_output->good();
+}
+
+std::string JsonWriter::take() {
+    m_flushed += m_buffer.size();
+    std::string result = std::move(m_buffer);
+    m_buffer.clear();
+    return result;
+}
+
+void JsonWriter::beforeValue() {
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+    if (m_hasElements.empty()) return;
+    
+    if (m_hasElements.back()) m_buffer += ',';
+    m_hasElements.back() = true;
+    newline();
+}
+
+void JsonWriter::newline() {
+    if (!m_pretty) return;
+    m_buffer += '\n';
+    m_buffer.append(m_hasElements.size() * 2, ' ');
+}
+
+void JsonWriter::writeEscaped(std::string_view text) {
+    static constexpr char Hex[] = "0123456789abcdef";
+    
+    m_buffer += '"';
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        
+        // Copy the plain run in one go, then the escape
+        m_buffer.append(text.data() + runStart, i - runStart);
+        runStart = i + 1;
+        switch (c) {
+            case '"': m_buffer.append("\\\""); break;
+            case '\\': m_buffer.append("\\\\"); break;
+            case '\b': m_buffer.append("\\b"); break;
+            case '\f': m_buffer.append("\\f"); break;
+            case '\n': m_buffer.append("\\n"); break;
+            case '\r': m_buffer.append("\\r"); break;
+            case '\t': m_buffer.append("\\t"); break;
+            default: {
+                const char escape[] = {'\\', 'u', '0', '0', Hex[c >> 4], Hex[c & 0xF]};
+                m_buffer.append(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+    m_buffer.append(text.data() + runStart, text.size() - runStart);
+    m_buffer += '"';
+}
+
+bool JsonWriter::afterWrite() {
+    if (m_output && m_buffer.size() >= m_flushThreshold) {
+        return flush();
+    }
+    return true;
+}
+
+} // namespace RoadSim::IO
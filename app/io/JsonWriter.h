@@ -0,0 +1,105 @@
+#pragma once
+
+#include "JsonStreamReader.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RoadSim::IO {
+
+class JsonObject;
+class JsonNode;
+
+/**
+ * @brief Event-driven JSON serializer writing into a growable buffer
+ * Numbers are formatted with std::to_chars (shortest round-trip, locale
+ * independent); doubles always keep a fraction or exponent so they read
+ * back as doubles, and NaN/infinity become null. Strings are escaped in
+ * runs between special characters. When constructed on a stream, the
+ * buffer is flushed whenever it passes the flush threshold, so large
+ * outputs never exist in memory at once. Being a JsonHandler, a writer can
+ * be fed directly by JsonStreamReader to reformat a file.
+ */
+class JsonWriter : public JsonHandler {
+public:
+    static constexpr size_t DefaultFlushThreshold = 64 * 1024;
+    
+    /**
+     * @brief Write into the in-memory buffer (see str/take)
+     */
+    explicit JsonWriter(bool pretty = false);
+    
+    /**
+     * @brief Stream to an output, flushing every flushThreshold bytes
+     */
+    JsonWriter(std::ostream& output, bool pretty = false, size_t flushThreshold = DefaultFlushThreshold);
+    
+    // Non-copyable
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+    
+    bool startObject() override;
+    bool endObject() override;
+    bool startArray() override;
+    bool endArray() override;
+    bool key(std::string_view name) override;
+    bool null() override;
+    bool boolean(bool value) override;
+    bool integer(int64_t value) override;
+    bool number(double value) override;
+    
+    /**
+     * @brief Write a float with the shortest digits that round-trip as float
+     */
+    bool number(float value);
+    
+    bool string(std::string_view value) override;
+    
+    /**
+     * @brief Write a whole value tree
+     */
+    bool value(const JsonObject& json);
+    bool value(const JsonNode& node);
+    
+    /**
+     * @brief Write buffered output to the stream (no-op for in-memory writers)
+     * @return False once the stream has failed
+     */
+    bool flush();
+    
+    /**
+     * @brief Buffered output (everything, for in-memory writers)
+     */
+    const std::string& str() const { return m_buffer; }
+    
+    /**
+     * @brief Move the buffered output out, leaving the writer empty
+     */
+    std::string take();
+    
+    /**
+     * @brief Total bytes produced, including flushed output
+     */
+    size_t getBytesWritten() const { return m_flushed + m_buffer.size(); }
+    
+private:
+    void beforeValue();
+    void newline();
+    void writeEscaped(std::string_view text);
+    bool afterWrite();
+    
+    std::ostream* m_output = nullptr;
+    size_t m_flushThreshold = DefaultFlushThreshold;
+    bool m_pretty = false;
+    
+    std::string m_buffer;
+    size_t m_flushed = 0;
+    
+    // One entry per open container: whether it has any element yet
+    std::vector<bool> m_hasElements;
+    bool m_afterKey = false;
+};
+
+} // namespace RoadSim::IO
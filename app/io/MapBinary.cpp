@@ -0,0 +1,601 @@
+#include "MapBinary.h"
+#include "MappedFile.h"
+#include "../core/Trace.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace RoadSim::IO {
+
+namespace {
+
+// Write a new file and flush it to the device before returning
+bool writeDurably(const std::string& path, const std::string& bytes, std::string& error) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "Could not create file: " + path;
+        return false;
+    }
+    
+    size_t written = 0;
+    bool ok = true;
+    while (ok && written < bytes.size()) {
+        DWORD count = 0;
+        const auto chunk = static_cast<DWORD>(std::min<size_t>(bytes.size() - written, 1u << 30));
+        ok = WriteFile(file, bytes.data() + written, chunk, &count, nullptr) && count > 0;
+        written += count;
+    }
+    ok = ok && FlushFileBuffers(file);
+    CloseHandle(file);
+    if (!ok) error = "Could not write file: " + path;
+    return ok;
+#else
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        error = "Could not create file: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    
+    size_t written = 0;
+    while (written < bytes.size()) {
+        const ssize_t count = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+        written += static_cast<size_t>(count);
+    }
+    
+    // Without fsync the rename can reach the disk before the data does
+    const bool ok = written == bytes.size() && ::fsync(fd) == 0;
+    if (!ok) error = "Could not write file: " + path + " (" + std::strerror(errno) + ")";
+    if (::close(fd) != 0 && ok) {
+        error = "Could not write file: " + path + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    return ok;
+#endif
+}
+
+// Rename over the target and make the new directory entry durable
+bool replaceDurably(const std::string& from, const std::string& to, std::string& error) {
+#ifdef _WIN32
+    if (!MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        // Typically because the target is still mapped by a MapBinary view
+        error = "Could not replace " + to + " (error " + std::to_string(GetLastError()) + "; is it still open?)";
+        return false;
+    }
+    return true;
+#else
+    if (::rename(from.c_str(), to.c_str()) != 0) {
+        error = "Could not replace " + to + ": " + std::strerror(errno);
+        return false;
+    }
+    
+    std::string directory = std::filesystem::path(to).parent_path().string();
+    if (directory.empty()) directory = ".";
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0 || ::fsync(fd) != 0) {
+        error = "Could not sync directory " + directory + ": " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    ::close(fd);
+    return true;
+#endif
+}
+
+// XXH64 primes
+constexpr uint64_t Prime1 = 11400714785074694791ULL;
+constexpr uint64_t Prime2 = 14029467366897019727ULL;
+constexpr uint64_t Prime3 = 1609587929392839161ULL;
+constexpr uint64_t Prime4 = 9650029242287828579ULL;
+constexpr uint64_t Prime5 = 2870177450012600261ULL;
+
+inline uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t read64(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t read32(const unsigned char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t round64(uint64_t acc, uint64_t input) {
+    acc += input * Prime2;
+    acc = rotl(acc, 31);
+    return acc * Prime1;
+}
+
+inline uint64_t mergeRound(uint64_t acc, uint64_t value) {
+    acc ^= round64(0, value);
+    return acc * Prime1 + Prime4;
+}
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Lanes run from -> to unless the road is two-way and the lane is in the back half
+int8_t laneDirection(const Core::MapRoad& road, int32_t lane) {
+    if (road.oneWay) return 1;
+    return lane < (road.lanes + 1) / 2 ? 1 : -1;
+}
+
+/**
+ * @brief Lays out sections in one buffer, 64-byte aligned
+ */
+class SectionBuilder {
+public:
+    explicit SectionBuilder(size_t sectionCount) {
+        m_sections.reserve(sectionCount);
+        m_buffer.resize(alignUp(sizeof(MapBinaryHeader) + sectionCount * sizeof(MapBinarySection), MapBinary::SectionAlignment));
+    }
+    
+    // Declare a table; returns its index for table() once all are declared
+    template <typename Record>
+    size_t add(MapBinarySectionKind kind, size_t count) {
+        const size_t offset = m_buffer.size();
+        m_buffer.resize(alignUp(offset + count * sizeof(Record), MapBinary::SectionAlignment));
+        m_sections.push_back({kind, static_cast<uint32_t>(sizeof(Record)), offset, count});
+        return m_sections.size() - 1;
+    }
+    
+    // Zeroed storage of a declared table (stable once no more are added)
+    template <typename Record>
+    Record* table(size_t section) {
+        return reinterpret_cast<Record*>(m_buffer.data() + m_sections[section].offset);
+    }
+    
+    // Close the file: section table, header and checksum
+    std::string& finish(const MapBinaryHeader& fields) {
+        std::memcpy(m_buffer.data() + sizeof(MapBinaryHeader), m_sections.data(), m_sections.size() * sizeof(MapBinarySection));
+        
+        MapBinaryHeader header = fields;
+        std::memcpy(header.magic, MapBinary::Magic, sizeof(header.magic));
+        header.version = MapBinary::FormatVersion;
+        header.byteOrder = MapBinary::ByteOrderMark;
+        header.fileSize = m_buffer.size();
+        header.sectionCount = static_cast<uint32_t>(m_sections.size());
+        header.headerSize = sizeof(MapBinaryHeader);
+        header.checksum = MapBinary::checksum(m_buffer.data() + sizeof(MapBinaryHeader), m_buffer.size() - sizeof(MapBinaryHeader));
+        std::memcpy(m_buffer.data(), &header, sizeof(header));
+        return m_buffer;
+    }
+    
+private:
+    std::string m_buffer;
+    std::vector<MapBinarySection> m_sections;
+};
+
+} // namespace
+
+struct MapBinary::Impl {
+    MappedFile file;
+    std::string error;
+    std::string_view name;
+    std::string_view strings;
+    std::span<const MapBinaryNode> nodes;
+    std::span<const MapBinaryRoad> roads;
+    std::span<const MapBinaryLane> lanes;
+    std::span<const MapBinaryTrafficLight> trafficLights;
+    std::span<const MapBinarySpawnPoint> spawnPoints;
+    
+    void reset() {
+        file.close();
+        name = {};
+        strings = {};
+        nodes = {};
+        roads = {};
+        lanes = {};
+        trafficLights = {};
+        spawnPoints = {};
+    }
+    
+    bool fail(const std::string& message) {
+        error = message;
+        std::cerr << "[IO] " << error << std::endl;
+        reset();
+        return false;
+    }
+    
+    // Point a span at a section once its bounds and stride are known to be sound
+    template <typename Record>
+    bool bindSection(std::span<const Record>& table, const MapBinarySection& section, std::string_view data) {
+        if (section.stride != sizeof(Record)) {
+            error = "section " + std::to_string(static_cast<uint32_t>(section.kind)) + " has record size "
+                + std::to_string(section.stride) + ", expected " + std::to_string(sizeof(Record));
+            return false;
+        }
+        if (section.offset % alignof(Record) != 0 || section.offset > data.size() ||
+            section.count > (data.size() - section.offset) / sizeof(Record)) {
+            error = "section " + std::to_string(static_cast<uint32_t>(section.kind)) + " lies outside the file";
+            return false;
+        }
+        table = {reinterpret_cast<const Record*>(data.data() + section.offset), static_cast<size_t>(section.count)};
+        return true;
+    }
+    
+    bool validString(uint32_t offset, uint32_t length) const {
+        return offset <= strings.size() && length <= strings.size() - offset;
+    }
+    
+    bool validIndex(uint32_t index, size_t count) const {
+        return index == InvalidIndex || index < count;
+    }
+    
+    // Every index and string reference, so accessors never need checks
+    bool validateReferences() {
+        for (const MapBinaryRoad& road : roads) {
+            if (!validIndex(road.fromIndex, nodes.size()) || !validIndex(road.toIndex, nodes.size()) ||
+                road.firstLane > lanes.size() || road.laneCount > lanes.size() - road.firstLane) {
+                error = "road " + std::to_string(road.id) + " references data outside the file";
+                return false;
+            }
+        }
+        for (const MapBinaryLane& lane : lanes) {
+            if (lane.road >= roads.size()) {
+                error = "lane references road index " + std::to_string(lane.road) + " outside the file";
+                return false;
+            }
+        }
+        for (const MapBinaryTrafficLight& light : trafficLights) {
+            if (!validIndex(light.nodeIndex, nodes.size())) {
+                error = "traffic light at node " + std::to_string(light.nodeId) + " references data outside the file";
+                return false;
+            }
+        }
+        for (const MapBinarySpawnPoint& spawn : spawnPoints) {
+            if (!validString(spawn.typeOffset, spawn.typeLength)) {
+                error = "spawn point type lies outside the string section";
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+MapBinary::MapBinary() : m_impl(std::make_unique<Impl>()) {}
+
+MapBinary::~MapBinary() = default;
+
+MapBinary::MapBinary(MapBinary&&) noexcept = default;
+
+MapBinary& MapBinary::operator=(MapBinary&&) noexcept = default;
+
+bool MapBinary::open(const std::string& filePath, bool verifyChecksum) {
+    ROADSIM_TRACE_SCOPE("IO", "MapBinary::open");
+    
+    if (!m_impl) m_impl = std::make_unique<Impl>();
+    Impl& impl = *m_impl;
+    impl.reset();
+    
+    if (!impl.file.open(filePath)) {
+        return impl.fail(impl.file.getError());
+    }
+    
+    const std::string_view data = impl.file.view();
+    const std::string prefix = "Invalid binary map " + filePath + ": ";
+    if (reinterpret_cast<uintptr_t>(data.data()) % alignof(MapBinaryHeader) != 0) {
+        return impl.fail(prefix + "mapping is misaligned");
+    }
+    if (data.size() < sizeof(MapBinaryHeader)) {
+        return impl.fail(prefix + "file too small");
+    }
+    
+    MapBinaryHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        return impl.fail(prefix + "bad magic");
+    }
+    if (header.byteOrder != ByteOrderMark) {
+        return impl.fail(prefix + "written with a different byte order");
+    }
+    if (header.version != FormatVersion) {
+        return impl.fail(prefix + "format version " + std::to_string(header.version) + " (supported: "
+            + std::to_string(FormatVersion) + ")");
+    }
+    if (header.headerSize != sizeof(MapBinaryHeader) || header.fileSize != data.size()) {
+        return impl.fail(prefix + "truncated or resized");
+    }
+    if (header.sectionCount > (data.size() - sizeof(MapBinaryHeader)) / sizeof(MapBinarySection)) {
+        return impl.fail(prefix + "section table lies outside the file");
+    }
+    
+    if (verifyChecksum) {
+        ROADSIM_TRACE_SCOPE("IO", "MapBinary::checksum");
+        const uint64_t actual = checksum(data.data() + sizeof(MapBinaryHeader), data.size() - sizeof(MapBinaryHeader));
+        if (actual != header.checksum) {
+            return impl.fail(prefix + "checksum mismatch");
+        }
+    }
+    
+    const auto* sections = reinterpret_cast<const MapBinarySection*>(data.data() + sizeof(MapBinaryHeader));
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        const MapBinarySection& section = sections[i];
+        bool bound = true;
+        switch (section.kind) {
+            case MapBinarySectionKind::Strings: {
+                std::span<const char> strings;
+                bound = impl.bindSection(strings, section, data);
+                impl.strings = std::string_view(strings.data(), strings.size());
+                break;
+            }
+            case MapBinarySectionKind::Nodes: bound = impl.bindSection(impl.nodes, section, data); break;
+            case MapBinarySectionKind::Roads: bound = impl.bindSection(impl.roads, section, data); break;
+            case MapBinarySectionKind::Lanes: bound = impl.bindSection(impl.lanes, section, data); break;
+            case MapBinarySectionKind::TrafficLights: bound = impl.bindSection(impl.trafficLights, section, data); break;
+            case MapBinarySectionKind::SpawnPoints: bound = impl.bindSection(impl.spawnPoints, section, data); break;
+            default: break; // Newer optional section
+        }
+        if (!bound) return impl.fail(prefix + impl.error);
+    }
+    
+    if (!impl.validString(header.nameOffset, header.nameLength)) {
+        return impl.fail(prefix + "map name lies outside the string section");
+    }
+    if (!impl.validateReferences()) {
+        return impl.fail(prefix + impl.error);
+    }
+    impl.name = impl.strings.substr(header.nameOffset, header.nameLength);
+    impl.error.clear();
+    
+    std::cout << "[IO] Mapped binary map '" << impl.name << "': " << impl.nodes.size() << " nodes, "
+              << impl.roads.size() << " roads, " << impl.lanes.size() << " lanes ("
+              << data.size() / 1024 << " KB" << (impl.file.isMapped() ? "" : ", read into memory") << ")" << std::endl;
+    return true;
+}
+
+void MapBinary::close() {
+    if (m_impl) m_impl->reset();
+}
+
+bool MapBinary::isOpen() const {
+    return m_impl && m_impl->file.size() > 0;
+}
+
+std::string_view MapBinary::getName() const {
+    return m_impl->name;
+}
+
+std::span<const MapBinaryNode> MapBinary::getNodes() const {
+    return m_impl->nodes;
+}
+
+std::span<const MapBinaryRoad> MapBinary::getRoads() const {
+    return m_impl->roads;
+}
+
+std::span<const MapBinaryLane> MapBinary::getLanes() const {
+    return m_impl->lanes;
+}
+
+std::span<const MapBinaryTrafficLight> MapBinary::getTrafficLights() const {
+    return m_impl->trafficLights;
+}
+
+std::span<const MapBinarySpawnPoint> MapBinary::getSpawnPoints() const {
+    return m_impl->spawnPoints;
+}
+
+std::string_view MapBinary::getSpawnType(const MapBinarySpawnPoint& spawn) const {
+    return m_impl->strings.substr(spawn.typeOffset, spawn.typeLength);
+}
+
+std::span<const MapBinaryLane> MapBinary::getRoadLanes(const MapBinaryRoad& road) const {
+    return m_impl->lanes.subspan(road.firstLane, road.laneCount);
+}
+
+void MapBinary::toMapData(Core::MapData& map) const {
+    map.clear();
+    map.name = std::string(getName());
+    
+    map.nodes.reserve(m_impl->nodes.size());
+    for (const MapBinaryNode& node : m_impl->nodes) {
+        map.nodes.push_back({node.id, node.x, node.y});
+    }
+    
+    map.roads.reserve(m_impl->roads.size());
+    for (const MapBinaryRoad& road : m_impl->roads) {
+        map.roads.push_back({road.id, road.fromNode, road.toNode, static_cast<int32_t>(road.laneCount),
+                             road.speedLimit, (road.flags & MapBinaryRoad::OneWay) != 0});
+    }
+    
+    map.trafficLights.reserve(m_impl->trafficLights.size());
+    for (const MapBinaryTrafficLight& light : m_impl->trafficLights) {
+        map.trafficLights.push_back({light.nodeId, light.cycleTime, light.offset});
+    }
+    
+    map.spawnPoints.reserve(m_impl->spawnPoints.size());
+    for (const MapBinarySpawnPoint& spawn : m_impl->spawnPoints) {
+        map.spawnPoints.push_back({spawn.x, spawn.y, std::string(getSpawnType(spawn)), spawn.rate});
+    }
+}
+
+const std::string& MapBinary::getError() const {
+    return m_impl->error;
+}
+
+bool MapBinary::write(const std::string& filePath, const Core::MapData& map, std::string& error) {
+    ROADSIM_TRACE_SCOPE("IO", "MapBinary::write");
+    
+    // Node ids to table indices
+    std::unordered_map<int32_t, uint32_t> nodeIndex;
+    nodeIndex.reserve(map.nodes.size());
+    for (size_t i = 0; i < map.nodes.size(); ++i) {
+        nodeIndex.emplace(map.nodes[i].id, static_cast<uint32_t>(i));
+    }
+    const auto findNode = [&](int32_t id) {
+        const auto it = nodeIndex.find(id);
+        return it != nodeIndex.end() ? it->second : InvalidIndex;
+    };
+    
+    size_t laneCount = 0;
+    for (const Core::MapRoad& road : map.roads) {
+        if (road.lanes > 0xFFFF) {
+            error = "Road " + std::to_string(road.id) + " has too many lanes for the binary format";
+            return false;
+        }
+        laneCount += static_cast<size_t>(std::max(road.lanes, 0));
+    }
+    if (laneCount >= InvalidIndex || map.roads.size() >= InvalidIndex || map.nodes.size() >= InvalidIndex) {
+        error = "Map too large for the binary format";
+        return false;
+    }
+    
+    // String section: map name, then each distinct spawn type once
+    std::string strings = map.name;
+    std::unordered_map<std::string_view, uint32_t> stringOffsets;
+    std::vector<uint32_t> spawnTypeOffsets;
+    spawnTypeOffsets.reserve(map.spawnPoints.size());
+    for (const Core::MapSpawnPoint& spawn : map.spawnPoints) {
+        const auto [it, inserted] = stringOffsets.try_emplace(spawn.type, static_cast<uint32_t>(strings.size()));
+        if (inserted) strings += spawn.type;
+        spawnTypeOffsets.push_back(it->second);
+    }
+    if (strings.size() >= InvalidIndex) {
+        error = "String table too large for the binary format";
+        return false;
+    }
+    
+    SectionBuilder builder(6);
+    const size_t stringSection = builder.add<char>(MapBinarySectionKind::Strings, strings.size());
+    const size_t nodeSection = builder.add<MapBinaryNode>(MapBinarySectionKind::Nodes, map.nodes.size());
+    const size_t roadSection = builder.add<MapBinaryRoad>(MapBinarySectionKind::Roads, map.roads.size());
+    const size_t laneSection = builder.add<MapBinaryLane>(MapBinarySectionKind::Lanes, laneCount);
+    const size_t lightSection = builder.add<MapBinaryTrafficLight>(MapBinarySectionKind::TrafficLights, map.trafficLights.size());
+    const size_t spawnSection = builder.add<MapBinarySpawnPoint>(MapBinarySectionKind::SpawnPoints, map.spawnPoints.size());
+    
+    std::memcpy(builder.table<char>(stringSection), strings.data(), strings.size());
+    
+    auto* nodes = builder.table<MapBinaryNode>(nodeSection);
+    for (const Core::MapNode& node : map.nodes) {
+        *nodes++ = {node.id, node.x, node.y};
+    }
+    
+    auto* roads = builder.table<MapBinaryRoad>(roadSection);
+    auto* lanes = builder.table<MapBinaryLane>(laneSection);
+    uint32_t nextLane = 0;
+    for (size_t i = 0; i < map.roads.size(); ++i) {
+        const Core::MapRoad& road = map.roads[i];
+        const uint32_t roadLanes = static_cast<uint32_t>(std::max(road.lanes, 0));
+        roads[i] = {road.id, road.fromNode, road.toNode, findNode(road.fromNode), findNode(road.toNode),
+                    nextLane, roadLanes, road.speedLimit, road.oneWay ? MapBinaryRoad::OneWay : 0u};
+        for (uint32_t lane = 0; lane < roadLanes; ++lane) {
+            *lanes++ = {static_cast<uint32_t>(i), static_cast<uint16_t>(lane),
+                        laneDirection(road, static_cast<int32_t>(lane)), 0};
+        }
+        nextLane += roadLanes;
+    }
+    
+    auto* lights = builder.table<MapBinaryTrafficLight>(lightSection);
+    for (const Core::MapTrafficLight& light : map.trafficLights) {
+        *lights++ = {light.nodeId, findNode(light.nodeId), light.cycleTime, light.offset};
+    }
+    
+    auto* spawns = builder.table<MapBinarySpawnPoint>(spawnSection);
+    for (size_t i = 0; i < map.spawnPoints.size(); ++i) {
+        const Core::MapSpawnPoint& spawn = map.spawnPoints[i];
+        spawns[i] = {spawn.x, spawn.y, spawnTypeOffsets[i], static_cast<uint32_t>(spawn.type.size()), spawn.rate};
+    }
+    
+    MapBinaryHeader fields{};
+    fields.nameOffset = 0;
+    fields.nameLength = static_cast<uint32_t>(map.name.size());
+    const std::string& bytes = builder.finish(fields);
+    
+    // Write beside the target, sync, rename and sync the directory: mapped
+    // readers keep the old file, and after a crash the path holds either the
+    // old file or the complete new one
+    const std::string tempPath = filePath + ".tmp";
+    if (!writeDurably(tempPath, bytes, error) || !replaceDurably(tempPath, filePath, error)) {
+        std::error_code removeError;
+        std::filesystem::remove(tempPath, removeError);
+        return false;
+    }
+    
+    std::cout << "[IO] Wrote binary map " << filePath << " (" << bytes.size() / 1024 << " KB, "
+              << laneCount << " lanes)" << std::endl;
+    return true;
+}
+
+bool MapBinary::isBinaryMapFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    char magic[sizeof(Magic)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+uint64_t MapBinary::checksum(const void* data, size_t size, uint64_t seed) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + size;
+    uint64_t hash;
+    
+    if (size >= 32) {
+        // Four independent lanes over 32-byte stripes
+        uint64_t v1 = seed + Prime1 + Prime2;
+        uint64_t v2 = seed + Prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - Prime1;
+        const unsigned char* const limit = end - 32;
+        do {
+            v1 = round64(v1, read64(p));
+            v2 = round64(v2, read64(p + 8));
+            v3 = round64(v3, read64(p + 16));
+            v4 = round64(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        
+        hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = seed + Prime5;
+    }
+    
+    hash += static_cast<uint64_t>(size);
+    
+    for (; p + 8 <= end; p += 8) {
+        hash ^= round64(0, read64(p));
+        hash = rotl(hash, 27) * Prime1 + Prime4;
+    }
+    if (p + 4 <= end) {
+        hash ^= static_cast<uint64_t>(read32(p)) * Prime1;
+        hash = rotl(hash, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        hash ^= static_cast<uint64_t>(*p) * Prime5;
+        hash = rotl(hash, 11) * Prime1;
+    }
+    
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace RoadSim::IO
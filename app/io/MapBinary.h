@@ -0,0 +1,210 @@
+#pragma once
+
+#include "../core/MapData.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace RoadSim::IO {
+
+/*
+ * Binary map format (.rsmap), version 1
+ *
+ * A 64-byte header, then a table of section descriptors, then the sections.
+ * Every section is a flat array of fixed-size little-endian records starting
+ * on a 64-byte boundary; offsets are relative to the start of the file, so
+ * the file can be memory-mapped and the tables used in place. References
+ * between tables are stored as indices (resolved at write time), strings as
+ * offset/length pairs into the string section.
+ *
+ * The header checksum is XXH64 over everything after the header.
+ */
+
+/**
+ * @brief Section kinds; readers skip kinds they do not know
+ */
+enum class MapBinarySectionKind : uint32_t {
+    Strings = 1,
+    Nodes = 2,
+    Roads = 3,
+    Lanes = 4,
+    TrafficLights = 5,
+    SpawnPoints = 6
+};
+
+struct MapBinaryHeader {
+    char magic[8];          // "RSIMMAP\0"
+    uint32_t version;
+    uint32_t byteOrder;     // MapBinary::ByteOrderMark as written by the producer
+    uint64_t fileSize;
+    uint64_t checksum;      // XXH64 of bytes [sizeof(MapBinaryHeader), fileSize)
+    uint32_t sectionCount;  // Descriptors directly after the header
+    uint32_t headerSize;
+    uint32_t nameOffset;    // Map name in the string section
+    uint32_t nameLength;
+    uint32_t reserved[4];
+};
+
+struct MapBinarySection {
+    MapBinarySectionKind kind;
+    uint32_t stride;        // Record size, checked against the reader's
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct MapBinaryNode {
+    int32_t id;
+    float x;
+    float y;
+};
+
+struct MapBinaryRoad {
+    static constexpr uint32_t OneWay = 1u << 0;
+    
+    int32_t id;
+    int32_t fromNode;
+    int32_t toNode;
+    uint32_t fromIndex;     // Into the node table, MapBinary::InvalidIndex when unknown
+    uint32_t toIndex;
+    uint32_t firstLane;     // Lanes of this road are [firstLane, firstLane + laneCount)
+    uint32_t laneCount;
+    float speedLimit;       // m/s
+    uint32_t flags;
+};
+
+struct MapBinaryLane {
+    uint32_t road;          // Index into the road table
+    uint16_t index;         // Position across the road, 0 = rightmost forward lane
+    int8_t direction;       // +1 from -> to, -1 to -> from
+    uint8_t reserved;
+};
+
+struct MapBinaryTrafficLight {
+    int32_t nodeId;
+    uint32_t nodeIndex;     // MapBinary::InvalidIndex when the node is unknown
+    float cycleTime;        // Seconds
+    float offset;           // Seconds into the cycle at t=0
+};
+
+struct MapBinarySpawnPoint {
+    float x;
+    float y;
+    uint32_t typeOffset;    // In the string section
+    uint32_t typeLength;
+    float rate;             // Entities per second
+};
+
+static_assert(sizeof(MapBinaryHeader) == 64);
+static_assert(sizeof(MapBinarySection) == 24);
+static_assert(sizeof(MapBinaryNode) == 12);
+static_assert(sizeof(MapBinaryRoad) == 36);
+static_assert(sizeof(MapBinaryLane) == 8);
+static_assert(sizeof(MapBinaryTrafficLight) == 16);
+static_assert(sizeof(MapBinarySpawnPoint) == 20);
+
+/**
+ * @brief Read-only, memory-mapped view of a binary map file
+ * open() maps the file, validates the header, the section table and every
+ * cross-table index, and optionally the checksum; after that the tables are
+ * plain spans over the mapping and need no bounds checks. Nothing is copied,
+ * so load time is dominated by the page faults of whatever is touched.
+ *
+ * Files are written to a temporary name and renamed into place. On POSIX,
+ * views of the previous version stay intact while a new one is saved. On
+ * Windows a file that is still mapped cannot be replaced, so close every
+ * MapBinary view of a path before writing to it; otherwise write() fails and
+ * the previous file is kept.
+ */
+class MapBinary {
+public:
+    static constexpr char Magic[8] = {'R', 'S', 'I', 'M', 'M', 'A', 'P', '\0'};
+    static constexpr uint32_t FormatVersion = 1;
+    static constexpr uint32_t ByteOrderMark = 0x01020304;
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+    static constexpr size_t SectionAlignment = 64;
+    
+    MapBinary();
+    ~MapBinary();
+    
+    // Non-copyable
+    MapBinary(const MapBinary&) = delete;
+    MapBinary& operator=(const MapBinary&) = delete;
+    
+    // Movable (the spans stay valid)
+    MapBinary(MapBinary&&) noexcept;
+    MapBinary& operator=(MapBinary&&) noexcept;
+    
+    /**
+     * @brief Map and validate a binary map file, replacing any previous one
+     * @param filePath Path to .rsmap file
+     * @param verifyChecksum Hash the whole file (a few ms per 100 MB)
+     * @return Success status (see getError)
+     */
+    bool open(const std::string& filePath, bool verifyChecksum = true);
+    
+    /**
+     * @brief Unmap the file; invalidates all spans and views
+     */
+    void close();
+    
+    bool isOpen() const;
+    
+    std::string_view getName() const;
+    std::span<const MapBinaryNode> getNodes() const;
+    std::span<const MapBinaryRoad> getRoads() const;
+    std::span<const MapBinaryLane> getLanes() const;
+    std::span<const MapBinaryTrafficLight> getTrafficLights() const;
+    std::span<const MapBinarySpawnPoint> getSpawnPoints() const;
+    
+    /**
+     * @brief Spawn type string (view into the mapping)
+     */
+    std::string_view getSpawnType(const MapBinarySpawnPoint& spawn) const;
+    
+    /**
+     * @brief Lanes belonging to one road
+     */
+    std::span<const MapBinaryLane> getRoadLanes(const MapBinaryRoad& road) const;
+    
+    /**
+     * @brief Copy the tables into editable map data
+     * @param map Output map tables (cleared first)
+     */
+    void toMapData(Core::MapData& map) const;
+    
+    const std::string& getError() const;
+    
+    /**
+     * @brief Write map data as a binary map file
+     * Lanes are expanded from the road lane counts; on two-way roads the
+     * first half (rounded up) runs from -> to and the rest to -> from.
+     * The file is written to <filePath>.tmp, flushed to disk and renamed over
+     * filePath, and the directory is then synced, so a crash leaves either
+     * the previous file or the new one. On Windows this fails while filePath
+     * is mapped (see the class comment).
+     * @param filePath Path to save .rsmap file
+     * @param map Map tables to write
+     * @param error Receives the reason on failure
+     * @return Success status
+     */
+    static bool write(const std::string& filePath, const Core::MapData& map, std::string& error);
+    
+    /**
+     * @brief Check whether a file starts with the binary map magic
+     */
+    static bool isBinaryMapFile(const std::string& filePath);
+    
+    /**
+     * @brief XXH64 of a byte range, as stored in the header
+     */
+    static uint64_t checksum(const void* data, size_t size, uint64_t seed = 0);
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::IO
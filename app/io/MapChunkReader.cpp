@@ -0,0 +1,292 @@
+#include "MapChunkReader.h"
+#include "JsonStreamReader.h"
+#include "MapDataHandler.h"
+#include "MappedFile.h"
+#include "../core/Trace.h"
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace RoadSim::IO {
+
+namespace {
+
+// Characters the structural pass stops at
+constexpr auto StructuralCharacters = [] {
+    std::array<bool, 256> table{};
+    for (const char c : std::string_view("\"[]{},:")) table[static_cast<unsigned char>(c)] = true;
+    return table;
+}();
+
+// Index of the quote closing a string whose contents start at begin (npos if none)
+size_t findClosingQuote(std::string_view text, size_t begin) {
+    while (true) {
+        const void* found = std::memchr(text.data() + begin, '"', text.size() - begin);
+        if (!found) return std::string_view::npos;
+        const size_t quote = static_cast<size_t>(static_cast<const char*>(found) - text.data());
+        
+        // Escaped when preceded by an odd number of backslashes
+        size_t backslashes = 0;
+        while (quote - backslashes > begin && text[quote - backslashes - 1] == '\\') ++backslashes;
+        if (backslashes % 2 == 0) return quote;
+        begin = quote + 1;
+    }
+}
+
+bool isTableKey(std::string_view key) {
+    return key == "nodes" || key == "roads" || key == "trafficLights" || key == "spawnPoints";
+}
+
+// Append the records of one chunk to the merged table
+template <typename Record>
+void appendTable(std::vector<Record>& to, std::vector<Record>& from) {
+    to.insert(to.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+    from.clear();
+    from.shrink_to_fit();
+}
+
+} // namespace
+
+struct MapChunkReader::Impl {
+    /**
+     * @brief Records [begin, end) of one table array, or the skeleton for chunk 0
+     */
+    struct Chunk {
+        std::string_view table;
+        size_t begin = 0;
+        size_t end = 0;
+        Core::MapData partial;
+        std::string error;
+        bool parsed = false;
+    };
+    
+    MappedFile file;
+    std::string filePath;
+    std::string skeleton; // The document with its table arrays emptied
+    std::vector<Chunk> chunks;
+    std::string error;
+    
+    /**
+     * @brief Record the slice [begin, end) of a table array
+     * Only a whole array may be blank ("[]"). A blank slice after a split comma
+     * is a trailing or doubled comma, which JsonLoader::loadMapData rejects too.
+     * @param wholeArray The slice runs from '[' to ']' with no split inside
+     * @return False (with error set) for a blank slice that is not a whole array
+     */
+    bool addSlice(std::string_view text, std::string_view table, size_t begin, size_t end, bool wholeArray) {
+        const size_t first = text.find_first_not_of(" \t\r\n", begin);
+        if (first == std::string_view::npos || first >= end) {
+            if (wholeArray) return true;
+            error = "expected a value before byte " + std::to_string(end) + " in " + std::string(table);
+            return false;
+        }
+        
+        Chunk& chunk = chunks.emplace_back();
+        chunk.table = table;
+        chunk.begin = begin;
+        chunk.end = end;
+        return true;
+    }
+    
+    // Structural pass: track strings and nesting, cut table arrays at record commas
+    bool plan(size_t chunkBytes) {
+        const std::string_view text = file.view();
+        chunks.clear();
+        chunks.emplace_back();
+        skeleton.clear();
+        
+        int depth = 0;
+        bool inTable = false;
+        std::string_view lastString;
+        std::string_view currentKey;
+        std::string_view table;
+        size_t sliceStart = 0;
+        bool split = false;
+        size_t copiedUpTo = 0;
+        
+        for (size_t i = 0; i < text.size(); ++i) {
+            if (!StructuralCharacters[static_cast<unsigned char>(text[i])]) continue;
+            
+            switch (text[i]) {
+                case '"': {
+                    const size_t start = i + 1;
+                    i = findClosingQuote(text, start);
+                    if (i == std::string_view::npos) {
+                        error = "unterminated string";
+                        return false;
+                    }
+                    if (depth == 1) lastString = text.substr(start, i - start);
+                    break;
+                }
+                case ':':
+                    if (depth == 1) currentKey = lastString;
+                    break;
+                case '[':
+                    if (++depth == 2 && isTableKey(currentKey)) {
+                        skeleton.append(text.substr(copiedUpTo, i + 1 - copiedUpTo));
+                        inTable = true;
+                        table = currentKey;
+                        sliceStart = i + 1;
+                        split = false;
+                    }
+                    break;
+                case '{':
+                    ++depth;
+                    break;
+                case ']':
+                    if (depth == 2 && inTable) {
+                        if (!addSlice(text, table, sliceStart, i, !split)) return false;
+                        inTable = false;
+                        copiedUpTo = i;
+                    }
+                    [[fallthrough]];
+                case '}':
+                    if (--depth < 0) {
+                        error = "unbalanced brackets at byte " + std::to_string(i);
+                        return false;
+                    }
+                    break;
+                case ',':
+                    if (inTable && depth == 2 && i - sliceStart >= chunkBytes) {
+                        if (!addSlice(text, table, sliceStart, i, false)) return false;
+                        sliceStart = i + 1;
+                        split = true;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        
+        if (depth != 0) {
+            error = "unexpected end of input";
+            return false;
+        }
+        skeleton.append(text.substr(copiedUpTo));
+        return true;
+    }
+};
+
+MapChunkReader::MapChunkReader() : m_impl(std::make_unique<Impl>()) {}
+
+MapChunkReader::~MapChunkReader() = default;
+
+bool MapChunkReader::open(const std::string& filePath, size_t chunkBytes) {
+    ROADSIM_TRACE_SCOPE("IO", "MapChunkReader::open");
+    
+    Impl& impl = *m_impl;
+    impl.chunks.clear();
+    impl.skeleton.clear();
+    impl.filePath = filePath;
+    impl.error.clear();
+    
+    if (!impl.file.open(filePath)) {
+        impl.error = impl.file.getError();
+        std::cerr << "[IO] " << impl.error << std::endl;
+        return false;
+    }
+    
+    if (!impl.plan(chunkBytes > 0 ? chunkBytes : DefaultChunkBytes)) {
+        impl.error = "JSON parse error in " + filePath + ": " + impl.error;
+        std::cerr << "[IO] " << impl.error << std::endl;
+        impl.chunks.clear();
+        return false;
+    }
+    
+    std::cout << "[IO] Split map " << filePath << " (" << impl.file.size() / 1024 << " KB) into "
+              << impl.chunks.size() << " chunks" << std::endl;
+    return true;
+}
+
+size_t MapChunkReader::getChunkCount() const {
+    return m_impl->chunks.size();
+}
+
+size_t MapChunkReader::getChunkSize(size_t index) const {
+    if (index == 0) return m_impl->skeleton.size();
+    const Impl::Chunk& chunk = m_impl->chunks[index];
+    return chunk.end - chunk.begin;
+}
+
+size_t MapChunkReader::getFileSize() const {
+    return m_impl->file.size();
+}
+
+bool MapChunkReader::parseChunk(size_t index) {
+    ROADSIM_TRACE_SCOPE("IO", "MapChunkReader::parseChunk");
+    
+    Impl::Chunk& chunk = m_impl->chunks[index];
+    chunk.partial.clear();
+    chunk.parsed = false;
+    
+    // Records are parsed as a one-table document, so MapDataHandler sees the usual layout
+    std::string wrapped;
+    std::string_view input = m_impl->skeleton;
+    if (index > 0) {
+        const std::string_view records = m_impl->file.view().substr(chunk.begin, chunk.end - chunk.begin);
+        wrapped.reserve(records.size() + chunk.table.size() + 8);
+        wrapped.append("{\"").append(chunk.table).append("\":[").append(records).append("]}");
+        input = wrapped;
+    }
+    
+    MapDataHandler handler(chunk.partial);
+    JsonStreamReader reader;
+    if (!reader.parse(input, handler)) {
+        chunk.error = reader.getLastError();
+        if (!handler.getError().empty()) chunk.error += " (" + handler.getError() + ")";
+        if (index > 0) {
+            chunk.error = "in " + std::string(chunk.table) + " records at byte " + std::to_string(chunk.begin) + ": " + chunk.error;
+        }
+        chunk.partial.clear();
+        return false;
+    }
+    
+    chunk.parsed = true;
+    return true;
+}
+
+bool MapChunkReader::merge(Core::MapData& map) {
+    ROADSIM_TRACE_SCOPE("IO", "MapChunkReader::merge");
+    
+    map.clear();
+    
+    size_t nodes = 0, roads = 0, lights = 0, spawns = 0;
+    for (const Impl::Chunk& chunk : m_impl->chunks) {
+        if (!chunk.parsed) {
+            m_impl->error = "Failed to load map " + m_impl->filePath + ": "
+                + (chunk.error.empty() ? std::string("chunk not parsed") : chunk.error);
+            std::cerr << "[IO] " << m_impl->error << std::endl;
+            return false;
+        }
+        nodes += chunk.partial.nodes.size();
+        roads += chunk.partial.roads.size();
+        lights += chunk.partial.trafficLights.size();
+        spawns += chunk.partial.spawnPoints.size();
+    }
+    
+    map.nodes.reserve(nodes);
+    map.roads.reserve(roads);
+    map.trafficLights.reserve(lights);
+    map.spawnPoints.reserve(spawns);
+    for (Impl::Chunk& chunk : m_impl->chunks) {
+        if (!chunk.partial.name.empty()) map.name = std::move(chunk.partial.name);
+        appendTable(map.nodes, chunk.partial.nodes);
+        appendTable(map.roads, chunk.partial.roads);
+        appendTable(map.trafficLights, chunk.partial.trafficLights);
+        appendTable(map.spawnPoints, chunk.partial.spawnPoints);
+        chunk.parsed = false;
+    }
+    
+    std::cout << "[IO] Loaded map '" << map.name << "': " << map.nodes.size() << " nodes, "
+              << map.roads.size() << " roads, " << map.trafficLights.size() << " traffic lights, "
+              << map.spawnPoints.size() << " spawn points from " << m_impl->chunks.size() << " chunks" << std::endl;
+    return true;
+}
+
+const std::string& MapChunkReader::getError() const {
+    return m_impl->error;
+}
+
+} // namespace RoadSim::IO
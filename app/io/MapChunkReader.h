@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../core/MapData.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief Splits a JSON map into chunks that can be parsed in parallel
+ * open() maps the file and makes one structural pass over it (strings and
+ * nesting only) to find the nodes, roads, trafficLights and spawnPoints
+ * arrays and cut them into chunks of whole records. Chunk 0 is the rest of
+ * the document with those arrays emptied. parseChunk() may run on any
+ * thread for distinct indices; merge() then concatenates the results in
+ * file order, giving the same tables as JsonLoader::loadMapData.
+ *
+ * Only JSON maps are chunked; binary maps need no parsing (see MapBinary).
+ */
+class MapChunkReader {
+public:
+    static constexpr size_t DefaultChunkBytes = 1024 * 1024;
+    
+    MapChunkReader();
+    ~MapChunkReader();
+    
+    // Non-copyable
+    MapChunkReader(const MapChunkReader&) = delete;
+    MapChunkReader& operator=(const MapChunkReader&) = delete;
+    
+    /**
+     * @brief Map the file and plan its chunks, replacing any previous file
+     * @param filePath Path to map JSON file
+     * @param chunkBytes Target chunk size; records are never split
+     * @return Success status (see getError)
+     */
+    bool open(const std::string& filePath, size_t chunkBytes = DefaultChunkBytes);
+    
+    size_t getChunkCount() const;
+    
+    /**
+     * @brief Bytes of the file covered by a chunk
+     */
+    size_t getChunkSize(size_t index) const;
+    
+    size_t getFileSize() const;
+    
+    /**
+     * @brief Parse one chunk into its own partial tables
+     * Thread-safe for distinct indices.
+     * @return Success status
+     */
+    bool parseChunk(size_t index);
+    
+    /**
+     * @brief Concatenate all parsed chunks in file order
+     * @param map Output map tables (cleared first)
+     * @return False if any chunk failed or was not parsed (see getError)
+     */
+    bool merge(Core::MapData& map);
+    
+    const std::string& getError() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::IO
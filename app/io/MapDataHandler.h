@@ -0,0 +1,195 @@
+#pragma once
+
+#include "JsonStreamReader.h"
+#include "../core/MapData.h"
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief Fills MapData tables from JsonStreamReader events
+ * Root keys select a table; each object inside its array is one record.
+ * Shared by JsonLoader::loadMapData and MapChunkReader.
+ */
+class MapDataHandler : public JsonHandler {
+public:
+    explicit MapDataHandler(Core::MapData& map) : m_map(map) {}
+    
+    bool startObject() override {
+        m_depth++;
+        if (m_depth == TableDepth) m_table = Table::None; // Tables must be arrays
+        if (m_depth == RecordDepth) resetRecord();
+        return true;
+    }
+    
+    bool endObject() override {
+        if (m_depth == RecordDepth) commitRecord();
+        m_depth--;
+        return true;
+    }
+    
+    bool startArray() override {
+        m_depth++;
+        return true;
+    }
+    
+    bool endArray() override {
+        m_depth--;
+        return true;
+    }
+    
+    bool key(std::string_view name) override {
+        if (m_depth == 1) {
+            m_rootKey = name;
+            m_table = tableFor(name);
+        } else if (m_depth == RecordDepth) {
+            m_field = name;
+        }
+        return true;
+    }
+    
+    bool integer(int64_t value) override { return numberField(static_cast<double>(value)); }
+    bool number(double value) override { return numberField(value); }
+    
+    bool boolean(bool value) override {
+        if (m_depth == RecordDepth && m_table == Table::Roads && m_field == "oneWay") m_road.oneWay = value;
+        return true;
+    }
+    
+    bool string(std::string_view value) override {
+        if (m_depth == 1 && m_rootKey == "name") {
+            m_map.name = value;
+        } else if (m_depth == RecordDepth && m_table == Table::SpawnPoints && m_field == "type") {
+            m_spawnPoint.type = value;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Why the handler stopped the parse (empty when it did not)
+     */
+    const std::string& getError() const { return m_error; }
+    
+private:
+    enum class Table { None, Nodes, Roads, TrafficLights, SpawnPoints };
+    static constexpr int TableDepth = 2;
+    static constexpr int RecordDepth = 3;
+    
+    static Table tableFor(std::string_view name) {
+        if (name == "nodes") return Table::Nodes;
+        if (name == "roads") return Table::Roads;
+        if (name == "trafficLights") return Table::TrafficLights;
+        if (name == "spawnPoints") return Table::SpawnPoints;
+        return Table::None;
+    }
+    
+    void resetRecord() {
+        m_field.clear();
+        m_node = {};
+        m_road = {};
+        m_trafficLight = {};
+        m_spawnPoint = {};
+    }
+    
+    void commitRecord() {
+        switch (m_table) {
+            case Table::Nodes: m_map.nodes.push_back(m_node); break;
+            case Table::Roads: m_map.roads.push_back(m_road); break;
+            case Table::TrafficLights: m_map.trafficLights.push_back(m_trafficLight); break;
+            case Table::SpawnPoints: m_map.spawnPoints.push_back(std::move(m_spawnPoint)); break;
+            case Table::None: break;
+        }
+    }
+    
+    bool numberField(double value) {
+        if (m_depth != RecordDepth) return true;
+        
+        if (int32_t* target = integerField()) {
+            // Casting an out-of-range double to int32_t is undefined, so reject it
+            if (!(value >= static_cast<double>(std::numeric_limits<int32_t>::min()) &&
+                  value <= static_cast<double>(std::numeric_limits<int32_t>::max())) || std::trunc(value) != value) {
+                std::ostringstream message;
+                message << std::setprecision(15) << "Field '" << m_field << "' of a " << m_rootKey << " record is not a 32-bit integer: " << value;
+                m_error = message.str();
+                return false;
+            }
+            *target = static_cast<int32_t>(value);
+        } else if (float* target = realField()) {
+            // Narrowing a double outside the float range is undefined as well
+            if (!(std::abs(value) <= static_cast<double>(std::numeric_limits<float>::max()))) {
+                std::ostringstream message;
+                message << std::setprecision(15) << "Field '" << m_field << "' of a " << m_rootKey << " record is out of float range: " << value;
+                m_error = message.str();
+                return false;
+            }
+            *target = static_cast<float>(value);
+        }
+        return true;
+    }
+    
+    int32_t* integerField() {
+        switch (m_table) {
+            case Table::Nodes:
+                if (m_field == "id") return &m_node.id;
+                break;
+            case Table::Roads:
+                if (m_field == "id") return &m_road.id;
+                if (m_field == "fromNode") return &m_road.fromNode;
+                if (m_field == "toNode") return &m_road.toNode;
+                if (m_field == "lanes") return &m_road.lanes;
+                break;
+            case Table::TrafficLights:
+                if (m_field == "nodeId") return &m_trafficLight.nodeId;
+                break;
+            case Table::SpawnPoints:
+            case Table::None:
+                break;
+        }
+        return nullptr;
+    }
+    
+    float* realField() {
+        switch (m_table) {
+            case Table::Nodes:
+                if (m_field == "x") return &m_node.x;
+                if (m_field == "y") return &m_node.y;
+                break;
+            case Table::Roads:
+                if (m_field == "speedLimit") return &m_road.speedLimit;
+                break;
+            case Table::TrafficLights:
+                if (m_field == "cycleTime") return &m_trafficLight.cycleTime;
+                if (m_field == "offset") return &m_trafficLight.offset;
+                break;
+            case Table::SpawnPoints:
+                if (m_field == "x") return &m_spawnPoint.x;
+                if (m_field == "y") return &m_spawnPoint.y;
+                if (m_field == "rate") return &m_spawnPoint.rate;
+                break;
+            case Table::None:
+                break;
+        }
+        return nullptr;
+    }
+    
+    Core::MapData& m_map;
+    int m_depth = 0;
+    Table m_table = Table::None;
+    std::string m_rootKey;
+    std::string m_field;
+    std::string m_error;
+    
+    // Record being filled
+    Core::MapNode m_node;
+    Core::MapRoad m_road;
+    Core::MapTrafficLight m_trafficLight;
+    Core::MapSpawnPoint m_spawnPoint;
+};
+
+} // namespace RoadSim::IO
@@ -0,0 +1,221 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace RoadSim::IO {
+
+struct MappedFile::Impl {
+    const char* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::string fallback; // Contents when the file could not be mapped
+    std::string error;
+    
+    void unmap() {
+        if (mapped && data) {
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+#else
+            munmap(const_cast<char*>(data), size);
+#endif
+        }
+        data = nullptr;
+        size = 0;
+        mapped = false;
+        fallback.clear();
+        fallback.shrink_to_fit();
+    }
+    
+#ifndef _WIN32
+    // Read fd until EOF into the fallback buffer
+    bool readAll(int fd, const std::string& filePath) {
+        char chunk[64 * 1024];
+        while (true) {
+            const ssize_t count = ::read(fd, chunk, sizeof(chunk));
+            if (count == 0) break;
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                fallback.clear();
+                error = "Could not read file: " + filePath + " (" + std::strerror(errno) + ")";
+                return false;
+            }
+            fallback.append(chunk, static_cast<size_t>(count));
+        }
+        data = fallback.data();
+        size = fallback.size();
+        return true;
+    }
+#endif
+};
+
+MappedFile::MappedFile() : m_impl(std::make_unique<Impl>()) {}
+
+MappedFile::~MappedFile() {
+    if (m_impl) m_impl->unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept = default;
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        if (m_impl) m_impl->unmap();
+        m_impl = std::move(other.m_impl);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filePath, bool allowReadFallback) {
+    if (!m_impl) m_impl = std::make_unique<Impl>();
+    Impl& impl = *m_impl;
+    impl.unmap();
+    impl.error.clear();
+    
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        impl.error = "Could not open file: " + filePath;
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize{};
+    GetFileSizeEx(file, &fileSize);
+    const auto size = static_cast<size_t>(fileSize.QuadPart);
+    
+    if (size > 0) {
+        if (HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+            // The view keeps the mapping alive after both handles are closed
+            impl.data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+        impl.mapped = impl.data != nullptr;
+    }
+    
+    if (!impl.mapped && size > 0) {
+        if (!allowReadFallback) {
+            CloseHandle(file);
+            impl.data = nullptr;
+            impl.error = "Could not map file: " + filePath;
+            return false;
+        }
+        impl.fallback.resize(size);
+        DWORD bytesRead = 0;
+        if (!ReadFile(file, impl.fallback.data(), static_cast<DWORD>(size), &bytesRead, nullptr)) {
+            CloseHandle(file);
+            impl.fallback.clear();
+            impl.error = "Could not read file: " + filePath;
+            return false;
+        }
+        impl.fallback.resize(bytesRead);
+        impl.data = impl.fallback.data();
+    }
+    
+    CloseHandle(file);
+    impl.size = impl.mapped ? size : impl.fallback.size();
+#else
+    const int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        impl.error = "Could not open file: " + filePath + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    
+    struct stat info {};
+    const bool regular = fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+    
+    if (regular && info.st_size > 0) {
+        void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            impl.data = static_cast<const char*>(address);
+            impl.size = static_cast<size_t>(info.st_size);
+            impl.mapped = true;
+        }
+    }
+    
+    if (!impl.mapped && !(regular && info.st_size == 0)) {
+        if (!allowReadFallback) {
+            ::close(fd);
+            impl.error = "Could not map file: " + filePath;
+            return false;
+        }
+        
+        // Pipes and special files report no useful size: read until EOF
+        if (!impl.readAll(fd, filePath)) {
+            ::close(fd);
+            return false;
+        }
+    }
+    
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+#endif
+    
+    return true;
+}
+
+bool MappedFile::read(const std::string& filePath) {
+    if (!m_impl) m_impl = std::make_unique<Impl>();
+    Impl& impl = *m_impl;
+    impl.unmap();
+    impl.error.clear();
+    
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        impl.error = "Could not open file: " + filePath;
+        return false;
+    }
+    
+    char chunk[64 * 1024];
+    DWORD bytesRead = 0;
+    while (ReadFile(file, chunk, sizeof(chunk), &bytesRead, nullptr) && bytesRead > 0) {
+        impl.fallback.append(chunk, bytesRead);
+    }
+    CloseHandle(file);
+    impl.data = impl.fallback.data();
+    impl.size = impl.fallback.size();
+    return true;
+#else
+    const int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        impl.error = "Could not open file: " + filePath + " (" + std::strerror(errno) + ")";
+        return false;
+    }
+    
+    const bool read = impl.readAll(fd, filePath);
+    ::close(fd);
+    return read;
+#endif
+}
+
+void MappedFile::close() {
+    if (m_impl) m_impl->unmap();
+}
+
+std::string_view MappedFile::view() const {
+    if (!m_impl || !m_impl->data) return {};
+    return std::string_view(m_impl->data, m_impl->size);
+}
+
+bool MappedFile::isMapped() const {
+    return m_impl && m_impl->mapped;
+}
+
+const std::string& MappedFile::getError() const {
+    static const std::string none;
+    return m_impl ? m_impl->error : none;
+}
+
+} // namespace RoadSim::IO
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped when possible
+ * Mapped pages come straight from the page cache, so there is no copy and
+ * processes loading the same file share the memory. Uses mmap with
+ * MADV_SEQUENTIAL on POSIX and a file mapping on Windows; when mapping is
+ * not possible (pipes, special files) the file is read into an owned buffer.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    // Movable (the view stays valid)
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    /**
+     * @brief Open and map a file, replacing any previous one
+     * @param filePath Path to file
+     * @param allowReadFallback Read into memory when the file cannot be mapped
+     * @return Success status (see getError)
+     */
+    bool open(const std::string& filePath, bool allowReadFallback = true);
+    
+    /**
+     * @brief Read a file into an owned buffer without mapping it
+     * For small files that other programs rewrite in place, such as config
+     * files open in an editor: a mapped file truncated mid-parse raises SIGBUS.
+     * @param filePath Path to file
+     * @return Success status (see getError)
+     */
+    bool read(const std::string& filePath);
+    
+    /**
+     * @brief Unmap the file; invalidates the view
+     */
+    void close();
+    
+    /**
+     * @brief File contents (empty when closed)
+     */
+    std::string_view view() const;
+    
+    size_t size() const { return view().size(); }
+    
+    /**
+     * @brief Check whether the contents are mapped rather than copied
+     */
+    bool isMapped() const;
+    
+    const std::string& getError() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::IO
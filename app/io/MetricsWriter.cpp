@@ -0,0 +1,483 @@
+#include "MetricsWriter.h"
+#include "MappedFile.h"
+#include "../core/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace RoadSim::IO {
+
+namespace {
+
+constexpr char ColumnarMagic[8] = {'R', 'S', 'M', 'E', 'T', 'R', 'I', 'C'};
+constexpr uint32_t ColumnarVersion = 2;
+constexpr uint32_t ColumnCount = 7;
+constexpr size_t WriteThreshold = 1024 * 1024;
+constexpr auto IdleSleep = std::chrono::milliseconds(2);
+constexpr std::string_view CsvHeader = "time,lane,vehicles,throughput,meanWait,meanSpeed,occupancy\n";
+
+void appendU32(std::string& out, uint32_t value) {
+    const char bytes[] = {static_cast<char>(value), static_cast<char>(value >> 8),
+                          static_cast<char>(value >> 16), static_cast<char>(value >> 24)};
+    out.append(bytes, sizeof(bytes));
+}
+
+void patchU32(std::string& out, size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out[offset + i] = static_cast<char>(value >> (8 * i));
+}
+
+void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// XOR residues keep their differing bits high and zeros low: store the
+// trailing zero count plus one, then the odd part (a lone 0 for no change).
+// The odd part may use all 64 bits, so the two never share a varint.
+void appendXor(std::string& out, uint64_t residue) {
+    if (residue == 0) {
+        appendVarint(out, 0);
+        return;
+    }
+    const int zeros = std::countr_zero(residue);
+    appendVarint(out, static_cast<uint64_t>(zeros) + 1);
+    appendVarint(out, residue >> zeros);
+}
+
+template <typename Number>
+void appendNumber(std::string& out, Number value) {
+    char text[32];
+    const auto result = std::to_chars(text, text + sizeof(text), value);
+    out.append(text, static_cast<size_t>(result.ptr - text));
+}
+
+/**
+ * @brief Sequential reader over a columnar file
+ */
+class ColumnReader {
+public:
+    explicit ColumnReader(std::string_view data) : m_data(data) {}
+    
+    bool u32(uint32_t& value) {
+        if (m_data.size() - m_offset < 4) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(static_cast<unsigned char>(m_data[m_offset + i])) << (8 * i);
+        m_offset += 4;
+        return true;
+    }
+    
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && m_offset < m_data.size(); shift += 7) {
+            const auto byte = static_cast<unsigned char>(m_data[m_offset++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+    
+    // Inverse of appendXor; fails when the residue does not fit in bits
+    bool xorResidue(uint64_t& residue, int bits) {
+        uint64_t zeros = 0;
+        if (!varint(zeros)) return false;
+        if (zeros == 0) {
+            residue = 0;
+            return true;
+        }
+        
+        uint64_t odd = 0;
+        if (zeros > static_cast<uint64_t>(bits) || !varint(odd) || !(odd & 1)) return false;
+        const int shift = static_cast<int>(zeros - 1);
+        if (static_cast<int>(std::bit_width(odd)) + shift > bits) return false;
+        residue = odd << shift;
+        return true;
+    }
+    
+    bool bytes(size_t count, std::string_view& out) {
+        if (m_data.size() - m_offset < count) return false;
+        out = m_data.substr(m_offset, count);
+        m_offset += count;
+        return true;
+    }
+    
+    bool atEnd() const { return m_offset == m_data.size(); }
+    size_t remaining() const { return m_data.size() - m_offset; }
+    
+private:
+    std::string_view m_data;
+    size_t m_offset = 0;
+};
+
+} // namespace
+
+struct MetricsWriter::Impl {
+    Options options;
+    std::string filePath;
+    std::ofstream file;
+    std::string error;
+    std::thread thread;
+    std::atomic<bool> open{false};
+    std::atomic<bool> stopRequested{false};
+    
+    // Single-producer, single-consumer ring; positions only ever grow
+    std::vector<MetricRecord> ring;
+    size_t mask = 0;
+    alignas(64) std::atomic<uint64_t> tail{0}; // Written by the producer
+    uint64_t cachedHead = 0;                   // Producer's last view of head
+    alignas(64) std::atomic<uint64_t> head{0}; // Written by the consumer
+    
+    std::atomic<uint64_t> recordsQueued{0};
+    std::atomic<uint64_t> recordsDropped{0};
+    std::atomic<uint64_t> recordsWritten{0};
+    std::atomic<uint64_t> bytesWritten{0};
+    
+    // Consumer state
+    std::string buffer;
+    uint64_t bufferedRecords = 0;    // Records encoded into buffer, counted as written once it reaches the file
+    std::vector<MetricRecord> block; // Columnar records awaiting their block
+    
+    size_t reserve(size_t wanted) {
+        const uint64_t position = tail.load(std::memory_order_relaxed);
+        size_t available = ring.size() - static_cast<size_t>(position - cachedHead);
+        if (available < wanted) {
+            cachedHead = head.load(std::memory_order_acquire);
+            available = ring.size() - static_cast<size_t>(position - cachedHead);
+        }
+        return std::min(available, wanted);
+    }
+    
+    void writeBuffer(bool force) {
+        if (buffer.empty() || (!force && buffer.size() < WriteThreshold)) return;
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (file) {
+            bytesWritten.fetch_add(buffer.size(), std::memory_order_relaxed);
+            recordsWritten.fetch_add(bufferedRecords, std::memory_order_relaxed);
+        }
+        buffer.clear();
+        bufferedRecords = 0;
+    }
+    
+    // Unmeasured values (NaN) are left empty
+    void appendMeasure(float value) {
+        if (!std::isnan(value)) appendNumber(buffer, value);
+    }
+    
+    void formatCsv(const MetricRecord& record) {
+        appendNumber(buffer, record.time);
+        buffer += ',';
+        if (record.laneId != MetricRecord::NetworkWide) appendNumber(buffer, record.laneId);
+        buffer += ',';
+        appendNumber(buffer, record.vehicles);
+        buffer += ',';
+        appendMeasure(record.throughput);
+        buffer += ',';
+        appendMeasure(record.meanWait);
+        buffer += ',';
+        appendMeasure(record.meanSpeed);
+        buffer += ',';
+        appendMeasure(record.occupancy);
+        buffer += '\n';
+        bufferedRecords++;
+    }
+    
+    // One column: delta/XOR against the previous record, as varints
+    template <typename Encode>
+    void encodeColumn(Encode&& encode) {
+        const size_t sizeOffset = buffer.size();
+        appendU32(buffer, 0);
+        for (size_t i = 0; i < block.size(); ++i) {
+            encode(buffer, block[i], i > 0 ? &block[i - 1] : nullptr);
+        }
+        patchU32(buffer, sizeOffset, static_cast<uint32_t>(buffer.size() - sizeOffset - 4));
+    }
+    
+    static void xorFloat(std::string& out, float value, const float* previous) {
+        appendXor(out, std::bit_cast<uint32_t>(value) ^ (previous ? std::bit_cast<uint32_t>(*previous) : 0u));
+    }
+    
+    void writeBlock() {
+        if (block.empty()) return;
+        ROADSIM_TRACE_SCOPE("IO", "MetricsWriter::writeBlock");
+        
+        appendU32(buffer, static_cast<uint32_t>(block.size()));
+        encodeColumn([](std::string& out, const MetricRecord& r, const MetricRecord* p) {
+            appendXor(out, std::bit_cast<uint64_t>(r.time) ^ (p ? std::bit_cast<uint64_t>(p->time) : uint64_t{0}));
+        });
+        encodeColumn([](std::string& out, const MetricRecord& r, const MetricRecord* p) {
+            appendVarint(out, zigzag(static_cast<int64_t>(r.laneId) - (p ? static_cast<int64_t>(p->laneId) : 0)));
+        });
+        encodeColumn([](std::string& out, const MetricRecord& r, const MetricRecord* p) {
+            appendVarint(out, zigzag(static_cast<int64_t>(r.vehicles) - (p ? static_cast<int64_t>(p->vehicles) : 0)));
+        });
+        encodeColumn([](std::string& out, const MetricRecord& r, const MetricRecord* p) { xorFloat(out, r.throughput, p ? &p->throughput : nullptr); });
+        encodeColumn([](std::string& out, const MetricRecord& r, const MetricRecord* p) { xorFloat(out, r.meanWait, p ? &p->meanWait : nullptr); });
+        encodeColumn([](std::string& out, const MetricRecord& r, const MetricRecord* p) { xorFloat(out, r.meanSpeed, p ? &p->meanSpeed : nullptr); });
+        encodeColumn([](std::string& out, const MetricRecord& r, const MetricRecord* p) { xorFloat(out, r.occupancy, p ? &p->occupancy : nullptr); });
+        bufferedRecords += block.size();
+        block.clear();
+    }
+    
+    // Format everything currently queued; false when the ring was empty
+    bool drain() {
+        const uint64_t start = head.load(std::memory_order_relaxed);
+        const uint64_t end = tail.load(std::memory_order_acquire);
+        if (start == end) return false;
+        
+        ROADSIM_TRACE_SCOPE("IO", "MetricsWriter::drain");
+        for (uint64_t position = start; position != end; ++position) {
+            const MetricRecord& record = ring[static_cast<size_t>(position) & mask];
+            if (options.format == Format::Csv) {
+                formatCsv(record);
+            } else {
+                block.push_back(record);
+                if (block.size() >= options.blockRecords) writeBlock();
+            }
+            
+            // Hand slots back in steps so a long drain does not starve the producer
+            if (((position + 1) & 4095) == 0) {
+                head.store(position + 1, std::memory_order_release);
+                writeBuffer(false);
+            }
+        }
+        head.store(end, std::memory_order_release);
+        writeBuffer(false);
+        return true;
+    }
+    
+    void run() {
+        while (!stopRequested.load(std::memory_order_acquire)) {
+            if (!drain()) {
+                std::this_thread::sleep_for(IdleSleep);
+            }
+        }
+        
+        // Producer has stopped: take the rest
+        drain();
+        writeBlock();
+        writeBuffer(true);
+        file.flush();
+    }
+};
+
+MetricsWriter::MetricsWriter() : m_impl(std::make_unique<Impl>()) {}
+
+MetricsWriter::~MetricsWriter() {
+    close();
+}
+
+bool MetricsWriter::open(const std::string& filePath) {
+    return open(filePath, Options{});
+}
+
+bool MetricsWriter::open(const std::string& filePath, const Options& options) {
+    close();
+    Impl& impl = *m_impl;
+    
+    impl.file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!impl.file.is_open()) {
+        impl.error = "Could not create metrics file: " + filePath;
+        std::cerr << "[IO] " << impl.error << std::endl;
+        return false;
+    }
+    
+    impl.options = options;
+    impl.options.blockRecords = std::max<size_t>(options.blockRecords, 1);
+    impl.filePath = filePath;
+    impl.error.clear();
+    impl.ring.assign(std::bit_ceil(std::max<size_t>(options.queueCapacity, 2)), MetricRecord{});
+    impl.mask = impl.ring.size() - 1;
+    impl.head = 0;
+    impl.tail = 0;
+    impl.cachedHead = 0;
+    impl.recordsQueued = 0;
+    impl.recordsDropped = 0;
+    impl.recordsWritten = 0;
+    impl.bytesWritten = 0;
+    impl.buffer.clear();
+    impl.bufferedRecords = 0;
+    impl.buffer.reserve(WriteThreshold + WriteThreshold / 4);
+    impl.block.clear();
+    
+    if (options.format == Format::Csv) {
+        impl.buffer.append(CsvHeader);
+    } else {
+        impl.buffer.append(ColumnarMagic, sizeof(ColumnarMagic));
+        appendU32(impl.buffer, ColumnarVersion);
+        appendU32(impl.buffer, ColumnCount);
+        impl.block.reserve(impl.options.blockRecords);
+    }
+    
+    impl.stopRequested = false;
+    impl.open.store(true, std::memory_order_release);
+    impl.thread = std::thread([this] { m_impl->run(); });
+    
+    std::cout << "[IO] Writing " << (options.format == Format::Csv ? "CSV" : "columnar") << " metrics to "
+              << filePath << " (" << impl.ring.size() << " record queue)" << std::endl;
+    return true;
+}
+
+void MetricsWriter::close() {
+    Impl& impl = *m_impl;
+    if (!impl.thread.joinable()) return;
+    
+    impl.open.store(false, std::memory_order_release);
+    impl.stopRequested.store(true, std::memory_order_release);
+    impl.thread.join();
+    impl.file.close();
+    
+    const Statistics stats = getStatistics();
+    std::cout << "[IO] Closed metrics file " << impl.filePath << ": " << stats.recordsWritten << " records, "
+              << stats.bytesWritten / 1024 << " KB, " << stats.recordsDropped << " dropped" << std::endl;
+}
+
+bool MetricsWriter::isOpen() const {
+    return m_impl->open.load(std::memory_order_acquire);
+}
+
+bool MetricsWriter::push(const MetricRecord& record) {
+    return push(std::span<const MetricRecord>(&record, 1)) == 1;
+}
+
+size_t MetricsWriter::push(std::span<const MetricRecord> records) {
+    Impl& impl = *m_impl;
+    if (!impl.open.load(std::memory_order_relaxed)) {
+        impl.recordsDropped.fetch_add(records.size(), std::memory_order_relaxed);
+        return 0;
+    }
+    
+    const size_t count = impl.reserve(records.size());
+    const uint64_t position = impl.tail.load(std::memory_order_relaxed);
+    
+    // At most two copies: up to the end of the ring, then from its start
+    const size_t first = static_cast<size_t>(position) & impl.mask;
+    const size_t untilWrap = std::min(count, impl.ring.size() - first);
+    std::copy_n(records.data(), untilWrap, impl.ring.data() + first);
+    std::copy_n(records.data() + untilWrap, count - untilWrap, impl.ring.data());
+    impl.tail.store(position + count, std::memory_order_release);
+    
+    impl.recordsQueued.fetch_add(count, std::memory_order_relaxed);
+    if (count < records.size()) {
+        impl.recordsDropped.fetch_add(records.size() - count, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+MetricsWriter::Statistics MetricsWriter::getStatistics() const {
+    Statistics stats;
+    stats.recordsQueued = m_impl->recordsQueued.load(std::memory_order_relaxed);
+    stats.recordsDropped = m_impl->recordsDropped.load(std::memory_order_relaxed);
+    stats.recordsWritten = m_impl->recordsWritten.load(std::memory_order_relaxed);
+    stats.bytesWritten = m_impl->bytesWritten.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const std::string& MetricsWriter::getError() const {
+    return m_impl->error;
+}
+
+bool MetricsWriter::readColumnar(const std::string& filePath, std::vector<MetricRecord>& records, std::string& error) {
+    MappedFile file;
+    if (!file.open(filePath)) {
+        error = file.getError();
+        return false;
+    }
+    
+    ColumnReader reader(file.view());
+    std::string_view magic;
+    uint32_t version = 0;
+    uint32_t columns = 0;
+    if (!reader.bytes(sizeof(ColumnarMagic), magic) || magic != std::string_view(ColumnarMagic, sizeof(ColumnarMagic)) ||
+        !reader.u32(version) || !reader.u32(columns)) {
+        error = "Not a columnar metrics file: " + filePath;
+        return false;
+    }
+    if (version != ColumnarVersion || columns != ColumnCount) {
+        error = "Unsupported columnar metrics version " + std::to_string(version) + " in " + filePath;
+        return false;
+    }
+    
+    while (!reader.atEnd()) {
+        uint32_t count = 0;
+        if (!reader.u32(count)) {
+            error = "Truncated block header in " + filePath;
+            return false;
+        }
+        
+        // Each column has a length and at least a byte per value, which bounds the
+        // count before it sizes the allocation
+        const size_t perColumn = reader.remaining() / ColumnCount;
+        if (perColumn < 4 || count > perColumn - 4) {
+            error = "Corrupt block header in " + filePath;
+            return false;
+        }
+        
+        const size_t first = records.size();
+        records.resize(first + count);
+        MetricRecord* block = records.data() + first;
+        
+        for (uint32_t column = 0; column < ColumnCount; ++column) {
+            uint32_t length = 0;
+            std::string_view bytes;
+            if (!reader.u32(length) || !reader.bytes(length, bytes)) {
+                error = "Truncated column in " + filePath;
+                return false;
+            }
+            
+            // Lane and vehicle columns are zigzag deltas; the others are XOR residues
+            const bool integerColumn = column == 1 || column == 2;
+            const int residueBits = column == 0 ? 64 : 32;
+            
+            ColumnReader values(bytes);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint64_t value = 0;
+                if (!(integerColumn ? values.varint(value) : values.xorResidue(value, residueBits))) {
+                    error = "Corrupt column in " + filePath;
+                    return false;
+                }
+                
+                MetricRecord& record = block[i];
+                const MetricRecord* previous = i > 0 ? &block[i - 1] : nullptr;
+                const auto previousFloat = [&](float MetricRecord::*field) {
+                    return previous ? std::bit_cast<uint32_t>(previous->*field) : 0u;
+                };
+                const auto residue = static_cast<uint32_t>(value);
+                switch (column) {
+                    case 0:
+                        record.time = std::bit_cast<double>(value ^ (previous ? std::bit_cast<uint64_t>(previous->time) : uint64_t{0}));
+                        break;
+                    case 1:
+                        record.laneId = static_cast<uint32_t>(unzigzag(value) + (previous ? static_cast<int64_t>(previous->laneId) : 0));
+                        break;
+                    case 2:
+                        record.vehicles = static_cast<uint32_t>(unzigzag(value) + (previous ? static_cast<int64_t>(previous->vehicles) : 0));
+                        break;
+                    case 3: record.throughput = std::bit_cast<float>(residue ^ previousFloat(&MetricRecord::throughput)); break;
+                    case 4: record.meanWait = std::bit_cast<float>(residue ^ previousFloat(&MetricRecord::meanWait)); break;
+                    case 5: record.meanSpeed = std::bit_cast<float>(residue ^ previousFloat(&MetricRecord::meanSpeed)); break;
+                    case 6: record.occupancy = std::bit_cast<float>(residue ^ previousFloat(&MetricRecord::occupancy)); break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace RoadSim::IO
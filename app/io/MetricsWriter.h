@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief One metrics sample: a lane (or the whole network) at a point in time
+ * Measures the simulation does not provide stay NotMeasured and are written
+ * as empty CSV cells.
+ */
+struct MetricRecord {
+    static constexpr uint32_t NetworkWide = 0xFFFFFFFFu;
+    static constexpr float NotMeasured = std::numeric_limits<float>::quiet_NaN();
+    
+    double time = 0.0;                  // Simulation time, seconds
+    uint32_t laneId = NetworkWide;      // Lane index, or NetworkWide for totals
+    uint32_t vehicles = 0;              // Vehicles present at sample time
+    float throughput = NotMeasured;     // Vehicles leaving per second
+    float meanWait = NotMeasured;       // Mean waiting time of stopped vehicles, seconds
+    float meanSpeed = NotMeasured;      // m/s
+    float occupancy = NotMeasured;      // Occupied fraction of the lane length (0-1)
+};
+
+static_assert(sizeof(MetricRecord) == 32);
+
+/**
+ * @brief Streams metric records to metrics.csv or a columnar file off the simulation thread
+ * The simulation thread pushes records into a single-producer ring buffer
+ * (one release store per push, no locks, no allocation). A background thread
+ * drains it in batches, formats with std::to_chars and writes large blocks.
+ * When the ring is full, records are dropped and counted instead of
+ * blocking the producer, so Simulator::step never waits on the disk.
+ *
+ * Columnar files hold blocks of up to blockRecords samples, one column after
+ * another. Integer columns are delta-coded; floating-point columns are XORed
+ * with the previous value and stored as the residue's trailing zero count
+ * followed by its odd part. Everything is written as LEB128 varints, so
+ * unchanged values take a byte and slowly changing ones a few more.
+ */
+class MetricsWriter {
+public:
+    enum class Format {
+        Csv,
+        Columnar
+    };
+    
+    struct Options {
+        Format format = Format::Csv;
+        size_t queueCapacity = 1u << 20;    // Records (rounded up to a power of two)
+        size_t blockRecords = 64 * 1024;    // Records per columnar block
+    };
+    
+    MetricsWriter();
+    
+    /**
+     * @brief Flushes and closes the file
+     */
+    ~MetricsWriter();
+    
+    // Non-copyable
+    MetricsWriter(const MetricsWriter&) = delete;
+    MetricsWriter& operator=(const MetricsWriter&) = delete;
+    
+    /**
+     * @brief Create the output file and start the writer thread
+     * @param filePath Output path (replaced if it exists)
+     * @param options Format and buffer sizes
+     * @return Success status (see getError)
+     */
+    bool open(const std::string& filePath);
+    bool open(const std::string& filePath, const Options& options);
+    
+    /**
+     * @brief Write everything still queued, then close the file
+     */
+    void close();
+    
+    bool isOpen() const;
+    
+    /**
+     * @brief Queue one record; producer thread only
+     * @return False if the ring was full (or closed) and the record dropped
+     */
+    bool push(const MetricRecord& record);
+    
+    /**
+     * @brief Queue a batch of records with a single publish; producer thread only
+     * @return Number of records queued; the rest were dropped
+     */
+    size_t push(std::span<const MetricRecord> records);
+    
+    struct Statistics {
+        uint64_t recordsQueued = 0;
+        uint64_t recordsDropped = 0;
+        uint64_t recordsWritten = 0;    // Records whose bytes reached the file
+        uint64_t bytesWritten = 0;
+    };
+    
+    /**
+     * @brief Counters; safe to call from any thread
+     */
+    Statistics getStatistics() const;
+    
+    const std::string& getError() const;
+    
+    /**
+     * @brief Decode a columnar metrics file
+     * @param filePath Path to file written with Format::Columnar
+     * @param records Output records (appended)
+     * @param error Receives the reason on failure
+     * @return Success status
+     */
+    static bool readColumnar(const std::string& filePath, std::vector<MetricRecord>& records, std::string& error);
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::IO
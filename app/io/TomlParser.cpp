@@ -0,0 +1,857 @@
+#include "TomlParser.h"
+#include "JsonParser.h"
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace RoadSim::IO {
+
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isHexDigit(char c) {
+    return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool isOctalDigit(char c) {
+    return c >= '0' && c <= '7';
+}
+
+bool isBinaryDigit(char c) {
+    return c == '0' || c == '1';
+}
+
+bool isBareKeyCharacter(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || isDigit(c) || c == '_' || c == '-';
+}
+
+// Characters that can appear in a number token (validated afterwards)
+bool isNumberTokenCharacter(char c) {
+    return isBareKeyCharacter(c) || c == '.' || c == '+';
+}
+
+/**
+ * @brief Table, array or value while the document is being built
+ * The flags enforce TOML's rules on where a table may be defined or extended.
+ */
+struct TomlNode {
+    enum class Kind : uint8_t { Value, Table, Array };
+    
+    Kind kind = Kind::Table;
+    bool headerDefined = false; // Opened by a [table] header
+    bool dotted = false;        // Created by a dotted key
+    bool frozen = false;        // Inline table or static array: closed to extension
+    bool arrayOfTables = false; // Created by [[array]] headers
+    
+    JsonObject value;
+    std::map<std::string, TomlNode> table;
+    std::vector<TomlNode> array;
+    
+    static TomlNode makeValue(JsonObject&& value) {
+        TomlNode node;
+        node.kind = Kind::Value;
+        node.value = std::move(value);
+        return node;
+    }
+    
+    static TomlNode makeTable() {
+        return TomlNode();
+    }
+    
+    void freeze() {
+        frozen = true;
+        for (auto& [name, child] : table) {
+            child.freeze();
+        }
+    }
+    
+    JsonObject toJsonObject() && {
+        switch (kind) {
+            case Kind::Value:
+                return std::move(value);
+            case Kind::Array: {
+                std::vector<JsonObject> elements;
+                elements.reserve(array.size());
+                for (TomlNode& element : array) {
+                    elements.push_back(std::move(element).toJsonObject());
+                }
+                return JsonObject(std::move(elements));
+            }
+            case Kind::Table: {
+                std::map<std::string, JsonObject> members;
+                for (auto& [name, child] : table) {
+                    members.emplace_hint(members.end(), name, std::move(child).toJsonObject());
+                }
+                return JsonObject(std::move(members));
+            }
+        }
+        return JsonObject();
+    }
+};
+
+class TomlGrammar {
+public:
+    explicit TomlGrammar(std::string_view text) : m_text(text) {}
+    
+    JsonObject parse() {
+        m_pos = 0;
+        if (m_text.substr(0, 3) == "\xEF\xBB\xBF") {
+            m_pos = 3;
+        }
+        
+        TomlNode root;
+        TomlNode* current = &root;
+        
+        while (true) {
+            skipWhitespace();
+            if (atEnd()) break;
+            
+            const char c = m_text[m_pos];
+            if (c == '[') {
+                current = parseHeader(root);
+            } else if (c != '#' && c != '\n' && c != '\r') {
+                parseKeyValue(*current, 0);
+            }
+            expectLineEnd();
+        }
+        
+        return std::move(root).toJsonObject();
+    }
+    
+private:
+    [[noreturn]] void fail(const std::string& message) const {
+        size_t line = 0;
+        size_t column = 0;
+        JsonParser::locate(m_text, m_pos, line, column);
+        throw TomlParseError(message, m_pos, line, column);
+    }
+    
+    bool atEnd() const {
+        return m_pos >= m_text.size();
+    }
+    
+    bool peek(char c) const {
+        return m_pos < m_text.size() && m_text[m_pos] == c;
+    }
+    
+    bool atNewline() const {
+        return peek('\n') || (peek('\r') && m_pos + 1 < m_text.size() && m_text[m_pos + 1] == '\n');
+    }
+    
+    void skipNewline() {
+        m_pos += m_text[m_pos] == '\r' ? 2 : 1;
+    }
+    
+    void skipWhitespace() {
+        while (peek(' ') || peek('\t')) m_pos++;
+    }
+    
+    // Whitespace, comments and newlines, as allowed between array elements
+    void skipWhitespaceAndComments() {
+        while (true) {
+            skipWhitespace();
+            if (peek('#')) {
+                skipComment();
+            } else if (atNewline()) {
+                skipNewline();
+            } else {
+                return;
+            }
+        }
+    }
+    
+    void skipComment() {
+        m_pos++; // Skip '#'
+        while (!atEnd() && !atNewline()) {
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if ((c < 0x20 && c != '\t') || c == 0x7F) {
+                fail("Control character in comment");
+            }
+            if (c >= 0x80) {
+                validateUtf8Sequence();
+            } else {
+                m_pos++;
+            }
+        }
+    }
+    
+    void expectLineEnd() {
+        skipWhitespace();
+        if (peek('#')) {
+            skipComment();
+        }
+        if (atEnd()) return;
+        if (!atNewline()) {
+            fail("Expected end of line");
+        }
+        skipNewline();
+    }
+    
+    // Keys
+    
+    std::vector<std::string> parseKey() {
+        std::vector<std::string> keys;
+        while (true) {
+            skipWhitespace();
+            keys.push_back(parseSimpleKey());
+            skipWhitespace();
+            if (!peek('.')) return keys;
+            m_pos++;
+        }
+    }
+    
+    std::string parseSimpleKey() {
+        if (peek('"')) {
+            if (m_text.substr(m_pos, 3) == "\"\"\"") fail("Multi-line strings cannot be keys");
+            return parseBasicString();
+        }
+        if (peek('\'')) {
+            if (m_text.substr(m_pos, 3) == "'''") fail("Multi-line strings cannot be keys");
+            return parseLiteralString();
+        }
+        
+        const size_t start = m_pos;
+        while (!atEnd() && isBareKeyCharacter(m_text[m_pos])) m_pos++;
+        if (m_pos == start) {
+            fail("Expected key");
+        }
+        return std::string(m_text.substr(start, m_pos - start));
+    }
+    
+    static std::string joinKey(const std::vector<std::string>& keys, size_t count) {
+        std::string joined;
+        for (size_t i = 0; i < count; ++i) {
+            if (i > 0) joined += '.';
+            joined += keys[i];
+        }
+        return joined;
+    }
+    
+    // Tables and key/value pairs
+    
+    TomlNode* parseHeader(TomlNode& root) {
+        const bool arrayOfTables = m_text.substr(m_pos, 2) == "[[";
+        m_pos += arrayOfTables ? 2 : 1;
+        
+        const size_t keyStart = m_pos;
+        const std::vector<std::string> keys = parseKey();
+        
+        if (arrayOfTables ? m_text.substr(m_pos, 2) != "]]" : !peek(']')) {
+            fail(arrayOfTables ? "Expected ']]' after array of tables name" : "Expected ']' after table name");
+        }
+        const size_t headerEnd = m_pos + (arrayOfTables ? 2 : 1);
+        m_pos = keyStart; // Report semantic errors at the name
+        
+        // Walk to the parent, creating implicit tables; [[array]] parents resolve to their last table
+        TomlNode* node = &root;
+        for (size_t i = 0; i + 1 < keys.size(); ++i) {
+            auto [it, inserted] = node->table.try_emplace(keys[i]);
+            TomlNode& child = it->second;
+            if (child.kind == TomlNode::Kind::Table && !child.frozen) {
+                node = &child;
+            } else if (child.kind == TomlNode::Kind::Array && child.arrayOfTables) {
+                node = &child.array.back();
+            } else {
+                fail("Key '" + joinKey(keys, i + 1) + "' is not a table");
+            }
+        }
+        
+        const std::string name = joinKey(keys, keys.size());
+        auto [it, inserted] = node->table.try_emplace(keys.back());
+        TomlNode& target = it->second;
+        
+        if (arrayOfTables) {
+            if (inserted) {
+                target.kind = TomlNode::Kind::Array;
+                target.arrayOfTables = true;
+            } else if (target.kind != TomlNode::Kind::Array || !target.arrayOfTables) {
+                fail("Cannot append to '" + name + "': it is not an array of tables");
+            }
+            target.array.push_back(TomlNode::makeTable());
+            m_pos = headerEnd;
+            return &target.array.back();
+        }
+        
+        if (!inserted && (target.kind != TomlNode::Kind::Table || target.headerDefined || target.dotted || target.frozen)) {
+            fail("Table '" + name + "' is already defined");
+        }
+        target.headerDefined = true;
+        m_pos = headerEnd;
+        return &target;
+    }
+    
+    void parseKeyValue(TomlNode& table, size_t depth) {
+        const size_t keyStart = m_pos;
+        const std::vector<std::string> keys = parseKey();
+        
+        if (!peek('=')) {
+            fail("Expected '=' after key");
+        }
+        const size_t valueStart = m_pos + 1;
+        m_pos = keyStart;
+        
+        // Dotted keys create tables, but may only extend tables created the same way
+        TomlNode* node = &table;
+        for (size_t i = 0; i + 1 < keys.size(); ++i) {
+            auto [it, inserted] = node->table.try_emplace(keys[i]);
+            TomlNode& child = it->second;
+            if (inserted) {
+                child.dotted = true;
+            } else if (child.kind != TomlNode::Kind::Table || !child.dotted || child.frozen) {
+                fail("Cannot define '" + joinKey(keys, keys.size()) + "': '" + joinKey(keys, i + 1) + "' is already defined");
+            }
+            node = &child;
+        }
+        
+        if (node->table.count(keys.back()) > 0) {
+            fail("Duplicate key '" + joinKey(keys, keys.size()) + "'");
+        }
+        
+        m_pos = valueStart;
+        skipWhitespace();
+        TomlNode value = parseValue(depth);
+        node->table.emplace(keys.back(), std::move(value));
+    }
+    
+    // Values
+    
+    TomlNode parseValue(size_t depth) {
+        if (atEnd()) {
+            fail("Expected value");
+        }
+        
+        const char c = m_text[m_pos];
+        switch (c) {
+            case '"':
+                return TomlNode::makeValue(JsonObject(m_text.substr(m_pos, 3) == "\"\"\"" ? parseMultilineBasicString() : parseBasicString()));
+            case '\'':
+                return TomlNode::makeValue(JsonObject(m_text.substr(m_pos, 3) == "'''" ? parseMultilineLiteralString() : parseLiteralString()));
+            case '[':
+                return parseArray(depth + 1);
+            case '{':
+                return parseInlineTable(depth + 1);
+            case 't':
+                parseLiteral("true");
+                return TomlNode::makeValue(JsonObject(true));
+            case 'f':
+                parseLiteral("false");
+                return TomlNode::makeValue(JsonObject(false));
+            default:
+                if (isDigit(c) || c == '+' || c == '-' || c == 'i' || c == 'n') {
+                    return TomlNode::makeValue(parseNumberOrDateTime());
+                }
+                fail("Invalid value");
+        }
+    }
+    
+    void parseLiteral(std::string_view literal) {
+        if (m_text.substr(m_pos, literal.size()) != literal) {
+            fail("Invalid value");
+        }
+        m_pos += literal.size();
+    }
+    
+    TomlNode parseArray(size_t depth) {
+        if (depth > TomlParser::MaxDepth) {
+            fail("Maximum nesting depth exceeded");
+        }
+        
+        m_pos++; // Skip '['
+        TomlNode node;
+        node.kind = TomlNode::Kind::Array;
+        node.frozen = true;
+        
+        while (true) {
+            skipWhitespaceAndComments();
+            if (peek(']')) break;
+            
+            node.array.push_back(parseValue(depth));
+            
+            skipWhitespaceAndComments();
+            if (peek(',')) {
+                m_pos++;
+                continue;
+            }
+            if (!peek(']')) {
+                fail("Expected ',' or ']' in array");
+            }
+            break;
+        }
+        
+        m_pos++; // Skip ']'
+        return node;
+    }
+    
+    TomlNode parseInlineTable(size_t depth) {
+        if (depth > TomlParser::MaxDepth) {
+            fail("Maximum nesting depth exceeded");
+        }
+        
+        m_pos++; // Skip '{'
+        TomlNode node = TomlNode::makeTable();
+        
+        skipWhitespace();
+        if (!peek('}')) {
+            while (true) {
+                parseKeyValue(node, depth);
+                skipWhitespace();
+                if (peek(',')) {
+                    m_pos++;
+                    continue;
+                }
+                if (!peek('}')) {
+                    fail("Expected ',' or '}' in inline table");
+                }
+                break;
+            }
+        }
+        
+        m_pos++; // Skip '}'
+        node.freeze();
+        return node;
+    }
+    
+    // Strings
+    
+    void appendEscape(std::string& out) {
+        m_pos++; // Skip '\'
+        if (atEnd()) {
+            fail("Unterminated escape sequence");
+        }
+        
+        switch (m_text[m_pos++]) {
+            case 'b': out += '\b'; break;
+            case 't': out += '\t'; break;
+            case 'n': out += '\n'; break;
+            case 'f': out += '\f'; break;
+            case 'r': out += '\r'; break;
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case 'u': appendUtf8(out, parseUnicodeEscape(4)); break;
+            case 'U': appendUtf8(out, parseUnicodeEscape(8)); break;
+            default:
+                m_pos--;
+                fail("Invalid escape sequence");
+        }
+    }
+    
+    uint32_t parseUnicodeEscape(size_t digits) {
+        const size_t start = m_pos;
+        uint32_t codepoint = 0;
+        for (size_t i = 0; i < digits; ++i) {
+            if (atEnd() || !isHexDigit(m_text[m_pos])) {
+                fail("Invalid hex digit in unicode escape");
+            }
+            const char c = m_text[m_pos++];
+            codepoint = (codepoint << 4) | static_cast<uint32_t>(isDigit(c) ? c - '0' : (c | 0x20) - 'a' + 10);
+        }
+        if (codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+            m_pos = start;
+            fail("Unicode escape is not a scalar value");
+        }
+        return codepoint;
+    }
+    
+    // Copy one character that needs no decoding, rejecting control characters
+    void appendPlain(std::string& out) {
+        const auto c = static_cast<unsigned char>(m_text[m_pos]);
+        if ((c < 0x20 && c != '\t') || c == 0x7F) {
+            fail("Control character in string");
+        }
+        if (c >= 0x80) {
+            const size_t start = m_pos;
+            validateUtf8Sequence();
+            out.append(m_text.data() + start, m_pos - start);
+        } else {
+            out += static_cast<char>(c);
+            m_pos++;
+        }
+    }
+    
+    std::string parseBasicString() {
+        m_pos++; // Skip '"'
+        std::string out;
+        while (true) {
+            // Copy plain ASCII runs in one go
+            const size_t runStart = m_pos;
+            while (!atEnd()) {
+                const auto c = static_cast<unsigned char>(m_text[m_pos]);
+                if (c == '"' || c == '\\' || c < 0x20 || c >= 0x7F) break;
+                m_pos++;
+            }
+            out.append(m_text.data() + runStart, m_pos - runStart);
+            
+            if (atEnd() || atNewline() || peek('\r')) {
+                fail("Unterminated string");
+            }
+            if (peek('"')) {
+                m_pos++;
+                return out;
+            }
+            if (peek('\\')) {
+                appendEscape(out);
+            } else {
+                appendPlain(out);
+            }
+        }
+    }
+    
+    std::string parseMultilineBasicString() {
+        m_pos += 3;
+        if (atNewline()) skipNewline(); // A newline right after the delimiter is trimmed
+        
+        std::string out;
+        while (true) {
+            if (atEnd()) {
+                fail("Unterminated multi-line string");
+            }
+            
+            if (peek('"')) {
+                if (closeMultiline('"', out)) return out;
+            } else if (peek('\\')) {
+                // Line-ending backslash: drop the newline and the whitespace that follows
+                size_t lookahead = m_pos + 1;
+                while (lookahead < m_text.size() && (m_text[lookahead] == ' ' || m_text[lookahead] == '\t')) lookahead++;
+                const size_t backslash = m_pos;
+                m_pos = lookahead;
+                if (atNewline()) {
+                    skipWhitespaceAndNewlines();
+                } else {
+                    m_pos = backslash;
+                    appendEscape(out);
+                }
+            } else if (atNewline()) {
+                skipNewline();
+                out += '\n';
+            } else {
+                appendPlain(out);
+            }
+        }
+    }
+    
+    std::string parseLiteralString() {
+        m_pos++; // Skip '\''
+        std::string out;
+        while (true) {
+            if (atEnd() || atNewline() || peek('\r')) {
+                fail("Unterminated string");
+            }
+            if (peek('\'')) {
+                m_pos++;
+                return out;
+            }
+            appendPlain(out);
+        }
+    }
+    
+    std::string parseMultilineLiteralString() {
+        m_pos += 3;
+        if (atNewline()) skipNewline();
+        
+        std::string out;
+        while (true) {
+            if (atEnd()) {
+                fail("Unterminated multi-line string");
+            }
+            if (peek('\'')) {
+                if (closeMultiline('\'', out)) return out;
+            } else if (atNewline()) {
+                skipNewline();
+                out += '\n';
+            } else {
+                appendPlain(out);
+            }
+        }
+    }
+    
+    // Handle a run of quotes inside a multi-line string; up to two may precede the closing delimiter
+    bool closeMultiline(char quote, std::string& out) {
+        size_t count = 0;
+        while (m_pos + count < m_text.size() && m_text[m_pos + count] == quote) count++;
+        
+        if (count > 5) {
+            m_pos += 5;
+            fail("Too many quotes at end of multi-line string");
+        }
+        
+        m_pos += count;
+        if (count >= 3) {
+            out.append(count - 3, quote);
+            return true;
+        }
+        out.append(count, quote);
+        return false;
+    }
+    
+    void skipWhitespaceAndNewlines() {
+        while (peek(' ') || peek('\t') || atNewline()) {
+            if (atNewline()) skipNewline();
+            else m_pos++;
+        }
+    }
+    
+    void validateUtf8Sequence() {
+        const size_t length = utf8SequenceLength(static_cast<unsigned char>(m_text[m_pos]));
+        if (length == 0 || m_pos + length > m_text.size() || !isValidUtf8Sequence(m_text.substr(m_pos, length))) {
+            fail("Invalid UTF-8 sequence");
+        }
+        m_pos += length;
+    }
+    
+    // Numbers and datetimes
+    
+    JsonObject parseNumberOrDateTime() {
+        const std::string_view rest = m_text.substr(m_pos);
+        auto digitsAt = [&rest](size_t first, size_t count) {
+            for (size_t i = first; i < first + count; ++i) {
+                if (i >= rest.size() || !isDigit(rest[i])) return false;
+            }
+            return true;
+        };
+        
+        if (digitsAt(0, 4) && rest.size() > 4 && rest[4] == '-') {
+            return JsonObject(parseDateTime());
+        }
+        if (digitsAt(0, 2) && rest.size() > 2 && rest[2] == ':') {
+            return JsonObject(parseTime());
+        }
+        
+        const size_t start = m_pos;
+        while (!atEnd() && isNumberTokenCharacter(m_text[m_pos])) {
+            // A sign inside the token is only valid in an exponent
+            const char c = m_text[m_pos];
+            if ((c == '+' || c == '-') && m_pos > start) {
+                const char previous = m_text[m_pos - 1];
+                if (previous != 'e' && previous != 'E') break;
+            }
+            m_pos++;
+        }
+        
+        const std::string_view token = m_text.substr(start, m_pos - start);
+        m_pos = start;
+        JsonObject number = parseNumber(token);
+        m_pos = start + token.size();
+        return number;
+    }
+    
+    // Read digits separated by single underscores, appending the digits to out
+    static bool readDigits(std::string_view token, size_t& pos, bool (*isValidDigit)(char), std::string& out) {
+        const size_t start = pos;
+        while (pos < token.size()) {
+            if (isValidDigit(token[pos])) {
+                out += token[pos++];
+            } else if (token[pos] == '_' && pos > start && pos + 1 < token.size() && isValidDigit(token[pos + 1])) {
+                pos++;
+            } else {
+                break;
+            }
+        }
+        return pos > start;
+    }
+    
+    JsonObject parseNumber(std::string_view token) {
+        size_t pos = 0;
+        bool negative = false;
+        const bool hasSign = !token.empty() && (token[0] == '+' || token[0] == '-');
+        if (hasSign) {
+            negative = token[0] == '-';
+            pos++;
+        }
+        
+        const std::string_view body = token.substr(pos);
+        if (body == "inf") {
+            return JsonObject(negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity());
+        }
+        if (body == "nan") {
+            return JsonObject(negative ? -std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::quiet_NaN());
+        }
+        
+        std::string digits;
+        
+        // Hexadecimal, octal and binary integers
+        if (body.size() >= 2 && body[0] == '0' && (body[1] == 'x' || body[1] == 'o' || body[1] == 'b')) {
+            if (hasSign) fail("Sign not allowed on hexadecimal, octal or binary integers");
+            
+            const int base = body[1] == 'x' ? 16 : (body[1] == 'o' ? 8 : 2);
+            bool (*isValidDigit)(char) = base == 16 ? isHexDigit : (base == 8 ? isOctalDigit : isBinaryDigit);
+            pos += 2;
+            if (!readDigits(token, pos, isValidDigit, digits) || pos != token.size()) {
+                fail("Invalid integer");
+            }
+            
+            int64_t value = 0;
+            const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value, base);
+            if (ec != std::errc() || ptr != digits.data() + digits.size()) {
+                fail("Integer out of range");
+            }
+            return JsonObject(value);
+        }
+        
+        if (negative) digits += '-';
+        
+        // Decimal integer part: no leading zeros
+        const size_t integerStart = pos;
+        if (!readDigits(token, pos, isDigit, digits)) {
+            fail("Invalid number");
+        }
+        if (token[integerStart] == '0' && pos - integerStart > 1) {
+            fail("Leading zeros are not allowed");
+        }
+        
+        bool isFloat = false;
+        if (pos < token.size() && token[pos] == '.') {
+            isFloat = true;
+            digits += token[pos++];
+            if (!readDigits(token, pos, isDigit, digits)) {
+                fail("Expected digit after decimal point");
+            }
+        }
+        
+        if (pos < token.size() && (token[pos] == 'e' || token[pos] == 'E')) {
+            isFloat = true;
+            digits += token[pos++];
+            if (pos < token.size() && (token[pos] == '+' || token[pos] == '-')) {
+                digits += token[pos++];
+            }
+            if (!readDigits(token, pos, isDigit, digits)) {
+                fail("Expected digit in exponent");
+            }
+        }
+        
+        if (pos != token.size()) {
+            fail("Invalid number");
+        }
+        
+        const char* first = digits.data();
+        const char* last = digits.data() + digits.size();
+        
+        if (!isFloat) {
+            int64_t value = 0;
+            const auto [ptr, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc() || ptr != last) {
+                fail("Integer out of range");
+            }
+            return JsonObject(value);
+        }
+        
+        double value = 0.0;
+        const auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec == std::errc::result_out_of_range && digits.find_first_of("eE") != std::string::npos && digits.find('-', 1) != std::string::npos) {
+            return JsonObject(negative ? -0.0 : 0.0); // Underflow
+        }
+        if (ec != std::errc() || ptr != last) {
+            fail("Float out of range");
+        }
+        return JsonObject(value);
+    }
+    
+    int readFixedDigits(size_t count) {
+        int value = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (atEnd() || !isDigit(m_text[m_pos])) {
+                fail("Invalid date or time");
+            }
+            value = value * 10 + (m_text[m_pos++] - '0');
+        }
+        return value;
+    }
+    
+    void expectCharacter(char c) {
+        if (!peek(c)) {
+            fail("Invalid date or time");
+        }
+        m_pos++;
+    }
+    
+    // Local time: HH:MM:SS[.fraction]
+    std::string parseTime() {
+        const size_t start = m_pos;
+        const int hour = readFixedDigits(2);
+        expectCharacter(':');
+        const int minute = readFixedDigits(2);
+        expectCharacter(':');
+        const int second = readFixedDigits(2);
+        
+        if (peek('.')) {
+            m_pos++;
+            const size_t fraction = m_pos;
+            while (!atEnd() && isDigit(m_text[m_pos])) m_pos++;
+            if (m_pos == fraction) {
+                fail("Expected digit in fractional seconds");
+            }
+        }
+        
+        if (hour > 23 || minute > 59 || second > 60) {
+            m_pos = start;
+            fail("Time out of range");
+        }
+        return std::string(m_text.substr(start, m_pos - start));
+    }
+    
+    // Local date, local date-time or offset date-time
+    std::string parseDateTime() {
+        static constexpr int DaysInMonth[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        
+        const size_t start = m_pos;
+        const int year = readFixedDigits(4);
+        expectCharacter('-');
+        const int month = readFixedDigits(2);
+        expectCharacter('-');
+        const int day = readFixedDigits(2);
+        
+        const bool leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        if (month < 1 || month > 12 || day < 1 || day > DaysInMonth[month - 1] || (month == 2 && day == 29 && !leapYear)) {
+            m_pos = start;
+            fail("Date out of range");
+        }
+        
+        std::string result(m_text.substr(start, m_pos - start));
+        
+        // The time may follow a 'T' or a space (only when a digit comes next)
+        const bool hasTime = (peek('T') || peek('t') || peek(' ')) && m_pos + 1 < m_text.size() && isDigit(m_text[m_pos + 1]);
+        if (!hasTime) {
+            return result;
+        }
+        m_pos++;
+        result += 'T';
+        result += parseTime();
+        
+        if (peek('Z') || peek('z')) {
+            m_pos++;
+            result += 'Z';
+        } else if (peek('+') || peek('-')) {
+            const size_t offsetStart = m_pos++;
+            const int hours = readFixedDigits(2);
+            expectCharacter(':');
+            const int minutes = readFixedDigits(2);
+            if (hours > 23 || minutes > 59) {
+                m_pos = offsetStart;
+                fail("Time offset out of range");
+            }
+            result += m_text.substr(offsetStart, m_pos - offsetStart);
+        }
+        return result;
+    }
+    
+    std::string_view m_text;
+    size_t m_pos = 0;
+};
+
+} // namespace
+
+TomlParseError::TomlParseError(const std::string& message, size_t offset, size_t line, size_t column)
+    : std::runtime_error(message + " at line " + std::to_string(line) + ", column " + std::to_string(column))
+    , m_offset(offset), m_line(line), m_column(column) {}
+
+TomlParser::TomlParser(std::string_view text) : m_text(text) {}
+
+JsonObject TomlParser::parse() {
+    return TomlGrammar(m_text).parse();
+}
+
+} // namespace RoadSim::IO
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "JsonLoader.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace RoadSim::IO {
+
+/**
+ * @brief TOML syntax or semantic error with its position in the source text
+ */
+class TomlParseError : public std::runtime_error {
+public:
+    TomlParseError(const std::string& message, size_t offset, size_t line, size_t column);
+    
+    size_t getOffset() const { return m_offset; }
+    size_t getLine() const { return m_line; }
+    size_t getColumn() const { return m_column; }
+    
+private:
+    size_t m_offset;
+    size_t m_line;
+    size_t m_column;
+};
+
+/**
+ * @brief TOML 1.0 parser producing the same JsonObject tree as JsonParser
+ * Supports bare, quoted and dotted keys, [tables] and [[arrays of tables]],
+ * inline tables, arrays, basic/literal strings (single and multi-line),
+ * decimal/hex/octal/binary integers, floats including inf and nan, and
+ * booleans. Datetimes are validated and kept as RFC 3339 strings, since
+ * JsonObject has no date type. Table redefinition, duplicate keys and
+ * extending inline tables or static arrays are rejected as the spec requires.
+ */
+class TomlParser {
+public:
+    static constexpr size_t MaxDepth = 512;
+    
+    /**
+     * @brief Create a parser over text that must outlive it
+     */
+    explicit TomlParser(std::string_view text);
+    
+    /**
+     * @brief Parse the whole document into a root table
+     * @throws TomlParseError on malformed input
+     */
+    JsonObject parse();
+    
+private:
+    std::string_view m_text;
+};
+
+} // namespace RoadSim::IO
@@ -0,0 +1,215 @@
+#include "DensityOverlay.h"
+#include "../core/MapData.h"
+#include "../core/MapSpatialIndex.h"
+#include "../core/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace RoadSim::Render {
+
+namespace {
+
+// Below this many agents the counting is cheaper than waking workers
+constexpr size_t ParallelThreshold = 8192;
+
+const sf::Color EmptyColor(90, 90, 95);
+const sf::Color LowColor(60, 200, 90);
+const sf::Color MediumColor(230, 200, 40);
+const sf::Color HighColor(220, 50, 40);
+
+sf::Color blend(const sf::Color& a, const sf::Color& b, float t) {
+    auto channel = [t](sf::Uint8 from, sf::Uint8 to) {
+        return static_cast<sf::Uint8>(static_cast<float>(from) + (static_cast<float>(to) - static_cast<float>(from)) * t);
+    };
+    return sf::Color(channel(a.r, b.r), channel(a.g, b.g), channel(a.b, b.b));
+}
+
+sf::Color occupancyColor(float occupancy) {
+    if (occupancy <= 0.0f) return EmptyColor;
+    if (occupancy < 0.5f) return blend(LowColor, MediumColor, occupancy * 2.0f);
+    return blend(MediumColor, HighColor, std::min(occupancy, 1.0f) * 2.0f - 1.0f);
+}
+
+} // namespace
+
+struct DensityOverlay::Impl {
+    // Two vertices per line, grouped by tile; a road longer than a tile is
+    // drawn as several lines so each stays within about a tile of its own
+    std::vector<sf::Vertex> vertices;
+    std::vector<uint32_t> tileStart;
+    float tileMargin = 0.0f;
+    
+    // Lines of map road r are lineSlots[lineStart[r] .. lineStart[r + 1])
+    std::vector<uint32_t> lineStart;
+    std::vector<uint32_t> lineSlots;
+    size_t roadCount = 0;
+    
+    // Per map road: capacity in vehicles and agents counted this pass
+    std::vector<float> capacity;
+    std::vector<uint32_t> counts;
+    
+    // Next agent of the counting pass in progress
+    size_t cursor = 0;
+    
+    void count(std::span<const AgentInstance> agents, const Core::MapSpatialIndex& index, size_t begin, size_t end, bool shared) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t road = index.findNearestRoad(agents[i].position, MaxSnapDistance);
+            if (road == Core::MapSpatialIndex::NoItem || road >= counts.size()) continue;
+            
+            if (shared) {
+                std::atomic_ref<uint32_t>(counts[road]).fetch_add(1, std::memory_order_relaxed);
+            } else {
+                ++counts[road];
+            }
+        }
+    }
+};
+
+DensityOverlay::DensityOverlay() : m_impl(std::make_unique<Impl>()) {}
+
+DensityOverlay::~DensityOverlay() = default;
+
+void DensityOverlay::build(const Core::MapData& map, const Core::MapSpatialIndex& index) {
+    ROADSIM_TRACE_SCOPE("Render", "DensityOverlay::build");
+    clear();
+    if (index.isEmpty()) return;
+    
+    Impl& impl = *m_impl;
+    const size_t tileCount = static_cast<size_t>(index.getCellCount());
+    impl.lineStart.assign(map.roads.size() + 1, 0);
+    impl.capacity.assign(map.roads.size(), 1.0f);
+    impl.counts.assign(map.roads.size(), 0);
+    impl.cursor = 0;
+    
+    // Cut the roads into lines no longer than a tile, then counting sort the
+    // lines by the tile of their midpoint
+    const float maxLineLength = index.getCellSize();
+    std::vector<sf::Vector2f> lineEnds;
+    std::vector<int> tileOfLine;
+    impl.tileStart.assign(tileCount + 1, 0);
+    for (uint32_t road = 0; road < map.roads.size(); ++road) {
+        impl.lineStart[road] = static_cast<uint32_t>(tileOfLine.size());
+        if (!index.isRoadIndexed(road)) continue;
+        
+        const sf::Vector2f start = index.getRoadStart(road);
+        const sf::Vector2f end = index.getRoadEnd(road);
+        const sf::Vector2f delta = end - start;
+        const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+        const float lanes = static_cast<float>(std::max(map.roads[road].lanes, 1));
+        impl.capacity[road] = std::max(1.0f, length * lanes / VehicleSpacing);
+        ++impl.roadCount;
+        
+        const size_t lines = std::max<size_t>(1, static_cast<size_t>(std::ceil(length / maxLineLength)));
+        impl.tileMargin = std::max(impl.tileMargin, 0.5f * length / static_cast<float>(lines));
+        for (size_t line = 0; line < lines; ++line) {
+            const sf::Vector2f from = line == 0 ? start : start + delta * (static_cast<float>(line) / static_cast<float>(lines));
+            const sf::Vector2f to = line + 1 == lines ? end : start + delta * (static_cast<float>(line + 1) / static_cast<float>(lines));
+            lineEnds.push_back(from);
+            lineEnds.push_back(to);
+            tileOfLine.push_back(index.getCellIndex(from + (to - from) * 0.5f));
+            impl.tileStart[static_cast<size_t>(tileOfLine.back()) + 1]++;
+        }
+    }
+    impl.lineStart[map.roads.size()] = static_cast<uint32_t>(tileOfLine.size());
+    for (size_t tile = 1; tile < impl.tileStart.size(); ++tile) impl.tileStart[tile] += impl.tileStart[tile - 1];
+    
+    std::vector<uint32_t> next(impl.tileStart.begin(), impl.tileStart.end() - 1);
+    impl.lineSlots.resize(tileOfLine.size());
+    impl.vertices.resize(tileOfLine.size() * 2);
+    for (size_t line = 0; line < tileOfLine.size(); ++line) {
+        const uint32_t slot = next[static_cast<size_t>(tileOfLine[line])]++;
+        impl.lineSlots[line] = slot;
+        impl.vertices[slot * 2].position = lineEnds[line * 2];
+        impl.vertices[slot * 2 + 1].position = lineEnds[line * 2 + 1];
+        impl.vertices[slot * 2].color = EmptyColor;
+        impl.vertices[slot * 2 + 1].color = EmptyColor;
+    }
+    
+    // Tile offsets count vertices from here on
+    for (uint32_t& start : impl.tileStart) start *= 2;
+}
+
+void DensityOverlay::clear() {
+    m_impl->vertices.clear();
+    m_impl->tileStart.clear();
+    m_impl->lineStart.clear();
+    m_impl->lineSlots.clear();
+    m_impl->roadCount = 0;
+    m_impl->capacity.clear();
+    m_impl->counts.clear();
+    m_impl->cursor = 0;
+    m_impl->tileMargin = 0.0f;
+}
+
+void DensityOverlay::update(std::span<const AgentInstance> agents, const Core::MapSpatialIndex& index,
+                            const EntityBatch::ParallelFor& parallelFor) {
+    ROADSIM_TRACE_SCOPE("Render", "DensityOverlay::update");
+    
+    Impl& impl = *m_impl;
+    if (impl.vertices.empty()) return;
+    
+    // Count the next slice of the snapshot; the colours change once a pass completes
+    if (impl.cursor > agents.size()) impl.cursor = agents.size();
+    const size_t begin = impl.cursor;
+    const size_t end = std::min(agents.size(), begin + AgentsPerUpdate);
+    if (parallelFor && end - begin >= ParallelThreshold) {
+        parallelFor(end - begin, [&impl, &index, agents, begin](size_t first, size_t last) {
+            impl.count(agents, index, begin + first, begin + last, true);
+        });
+    } else {
+        impl.count(agents, index, begin, end, false);
+    }
+    impl.cursor = end;
+    if (impl.cursor < agents.size()) return;
+    
+    impl.cursor = 0;
+    for (size_t road = 0; road < impl.counts.size(); ++road) {
+        const sf::Color color = occupancyColor(static_cast<float>(impl.counts[road]) / impl.capacity[road]);
+        for (uint32_t line = impl.lineStart[road]; line < impl.lineStart[road + 1]; ++line) {
+            const uint32_t slot = impl.lineSlots[line];
+            impl.vertices[slot * 2].color = color;
+            impl.vertices[slot * 2 + 1].color = color;
+        }
+    }
+    std::fill(impl.counts.begin(), impl.counts.end(), 0);
+}
+
+size_t DensityOverlay::drawVisible(sf::RenderTarget& target, const sf::RenderStates& states, const Core::MapSpatialIndex& index,
+                                   const sf::FloatRect& area) const {
+    const Impl& impl = *m_impl;
+    if (impl.vertices.empty() || impl.tileStart.size() != static_cast<size_t>(index.getCellCount()) + 1) return 0;
+    
+    const float margin = impl.tileMargin;
+    const sf::FloatRect widened(area.left - margin, area.top - margin, area.width + 2.0f * margin, area.height + 2.0f * margin);
+    
+    size_t drawCalls = 0;
+    auto drawRange = [&](size_t first, size_t end) {
+        if (end <= first) return;
+        target.draw(impl.vertices.data() + first, end - first, sf::Lines, states);
+        ++drawCalls;
+    };
+    
+    // Runs touching end to end are merged into one call
+    size_t runFirst = 0, runEnd = 0;
+    index.forEachCellRun(widened, [&](int firstCell, int lastCell) {
+        const size_t first = impl.tileStart[static_cast<size_t>(firstCell)];
+        const size_t end = impl.tileStart[static_cast<size_t>(lastCell) + 1];
+        if (first == runEnd) {
+            runEnd = end;
+            return;
+        }
+        drawRange(runFirst, runEnd);
+        runFirst = first;
+        runEnd = end;
+    });
+    drawRange(runFirst, runEnd);
+    return drawCalls;
+}
+
+size_t DensityOverlay::getRoadCount() const {
+    return m_impl->roadCount;
+}
+
+} // namespace RoadSim::Render
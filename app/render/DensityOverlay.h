@@ -0,0 +1,85 @@
+#pragma once
+
+#include "EntityBatch.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace RoadSim::Core {
+    struct MapData;
+    class MapSpatialIndex;
+}
+
+namespace RoadSim::Render {
+
+/**
+ * @brief Roads coloured by how full they are, for views too far out to show agents
+ * Each indexed road is drawn as lines no longer than a spatial index cell,
+ * sorted by cell like RoadMesh, so drawVisible() culls them the same way.
+ * update() assigns agents to their nearest road and recolours the lines
+ * from grey (empty) through green and yellow to red (at capacity).
+ *
+ * A frame counts at most AgentsPerUpdate agents, so large snapshots are
+ * counted over several frames and the colours refresh when a pass over the
+ * whole snapshot completes. The per-frame cost stays bounded however many
+ * agents the view covers.
+ */
+class DensityOverlay {
+public:
+    /**
+     * @brief Road length one vehicle occupies in a lane, used for capacity (metres)
+     */
+    static constexpr float VehicleSpacing = 7.5f;
+    
+    /**
+     * @brief Agents further than this from every road centre line are not counted
+     */
+    static constexpr float MaxSnapDistance = 8.0f;
+    
+    /**
+     * @brief Agents assigned to roads per update() call
+     */
+    static constexpr size_t AgentsPerUpdate = 8192;
+    
+    DensityOverlay();
+    ~DensityOverlay();
+    
+    // Non-copyable
+    DensityOverlay(const DensityOverlay&) = delete;
+    DensityOverlay& operator=(const DensityOverlay&) = delete;
+    
+    /**
+     * @brief Lay out the lines of every road of the map
+     * @param index Spatial index already built from map
+     */
+    void build(const Core::MapData& map, const Core::MapSpatialIndex& index);
+    
+    void clear();
+    
+    /**
+     * @brief Count the next slice of agents per road; recolour the lines after a full pass
+     * @param parallelFor Splits the counting across threads when set
+     */
+    void update(std::span<const AgentInstance> agents, const Core::MapSpatialIndex& index,
+                const EntityBatch::ParallelFor& parallelFor);
+    
+    /**
+     * @brief Draw the roads of the cells overlapping area
+     * @return Number of draw calls issued
+     */
+    size_t drawVisible(sf::RenderTarget& target, const sf::RenderStates& states, const Core::MapSpatialIndex& index,
+                       const sf::FloatRect& area) const;
+    
+    /**
+     * @brief Roads drawn (a road may span several lines)
+     */
+    size_t getRoadCount() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::Render
@@ -0,0 +1,173 @@
+#include "EntityBatch.h"
+#include "../core/Trace.h"
+#include <algorithm>
+#include <vector>
+
+namespace RoadSim::Render {
+
+namespace {
+
+// Below this many agents the fill is cheaper than waking workers
+constexpr size_t ParallelThreshold = 8192;
+
+// Agents per block of the view test; blocks are counted, then filled, in parallel
+constexpr size_t CullBlock = 4096;
+
+} // namespace
+
+struct EntityBatch::Impl {
+    std::array<KindStyle, KindCount> styles = {{
+        {sf::Vector2f(4.5f, 1.8f), sf::Color(220, 60, 50), sf::IntRect(0, 0, 32, 16)},
+        {sf::Vector2f(0.6f, 0.6f), sf::Color(240, 220, 80), sf::IntRect(32, 0, 16, 16)},
+        {sf::Vector2f(1.8f, 0.7f), sf::Color(70, 170, 230), sf::IntRect(48, 0, 16, 16)}
+    }};
+    const sf::Texture* texture = nullptr;
+    ParallelFor parallelFor;
+    
+    // Four vertices per agent; only grows, so steady frames do not allocate
+    sf::VertexArray vertices{sf::Quads};
+    size_t agentCount = 0;
+    
+    // First output quad of each view-test block (blocks + 1 entries); reused between frames
+    std::vector<size_t> blockStart;
+    
+    void fill(std::span<const AgentInstance> agents, sf::Vertex* out, size_t begin, size_t end) const {
+        for (size_t i = begin; i < end; ++i) fillQuad(agents[i], out + i * 4);
+    }
+    
+    void fillQuad(const AgentInstance& agent, sf::Vertex* quad) const {
+        const size_t kind = static_cast<size_t>(agent.kind) < KindCount ? static_cast<size_t>(agent.kind) : 0;
+        const KindStyle& style = styles[kind];
+        
+        const sf::Vector2f along = agent.direction * (0.5f * style.size.x);
+        const sf::Vector2f across = sf::Vector2f(-agent.direction.y, agent.direction.x) * (0.5f * style.size.y);
+        const sf::IntRect& cell = style.textureRect;
+        const float left = static_cast<float>(cell.left);
+        const float top = static_cast<float>(cell.top);
+        const float right = static_cast<float>(cell.left + cell.width);
+        const float bottom = static_cast<float>(cell.top + cell.height);
+        
+        // Plain field stores: sf::Vertex's constructors are not inline
+        quad[0].position = agent.position - along - across;
+        quad[1].position = agent.position + along - across;
+        quad[2].position = agent.position + along + across;
+        quad[3].position = agent.position - along + across;
+        quad[0].texCoords = sf::Vector2f(left, top);
+        quad[1].texCoords = sf::Vector2f(right, top);
+        quad[2].texCoords = sf::Vector2f(right, bottom);
+        quad[3].texCoords = sf::Vector2f(left, bottom);
+        for (int corner = 0; corner < 4; ++corner) quad[corner].color = style.color;
+    }
+};
+
+EntityBatch::EntityBatch() : m_impl(std::make_unique<Impl>()) {}
+
+EntityBatch::~EntityBatch() = default;
+
+void EntityBatch::setKindStyle(AgentKind kind, const KindStyle& style) {
+    if (kind == AgentKind::Count) return;
+    m_impl->styles[static_cast<size_t>(kind)] = style;
+}
+
+const EntityBatch::KindStyle& EntityBatch::getKindStyle(AgentKind kind) const {
+    return m_impl->styles[kind == AgentKind::Count ? 0 : static_cast<size_t>(kind)];
+}
+
+void EntityBatch::setTexture(const sf::Texture* atlas) {
+    m_impl->texture = atlas;
+}
+
+void EntityBatch::setParallelFor(ParallelFor parallelFor) {
+    m_impl->parallelFor = std::move(parallelFor);
+}
+
+void EntityBatch::update(std::span<const AgentInstance> agents) {
+    ROADSIM_TRACE_SCOPE("Render", "EntityBatch::update");
+    
+    Impl& impl = *m_impl;
+    impl.agentCount = agents.size();
+    if (impl.vertices.getVertexCount() < agents.size() * 4) {
+        impl.vertices.resize(agents.size() * 4);
+    }
+    if (agents.empty()) return;
+    
+    // Each range writes its own quads, so the ranges need no synchronisation
+    sf::Vertex* out = &impl.vertices[0];
+    if (impl.parallelFor && agents.size() >= ParallelThreshold) {
+        impl.parallelFor(agents.size(), [&impl, agents, out](size_t begin, size_t end) {
+            impl.fill(agents, out, begin, end);
+        });
+    } else {
+        impl.fill(agents, out, 0, agents.size());
+    }
+}
+
+void EntityBatch::update(std::span<const AgentInstance> agents, const sf::FloatRect& visibleArea) {
+    ROADSIM_TRACE_SCOPE("Render", "EntityBatch::cull");
+    
+    Impl& impl = *m_impl;
+    
+    // Widen by the largest agent so quads straddling the edge stay visible
+    float margin = 0.0f;
+    for (const KindStyle& style : impl.styles) margin = std::max({margin, style.size.x, style.size.y});
+    const float left = visibleArea.left - margin;
+    const float top = visibleArea.top - margin;
+    const float right = visibleArea.left + visibleArea.width + margin;
+    const float bottom = visibleArea.top + visibleArea.height + margin;
+    auto inView = [=](const AgentInstance& agent) {
+        return agent.position.x >= left && agent.position.x <= right && agent.position.y >= top && agent.position.y <= bottom;
+    };
+    
+    const size_t blocks = (agents.size() + CullBlock - 1) / CullBlock;
+    auto forEachBlock = [&](const std::function<void(size_t, size_t)>& body) {
+        if (impl.parallelFor && agents.size() >= ParallelThreshold) {
+            impl.parallelFor(blocks, body);
+        } else {
+            body(0, blocks);
+        }
+    };
+    
+    // Count the agents in view per block, then place the blocks with a prefix sum
+    impl.blockStart.assign(blocks + 1, 0);
+    forEachBlock([&impl, &inView, agents](size_t first, size_t last) {
+        for (size_t block = first; block < last; ++block) {
+            const size_t end = std::min(agents.size(), (block + 1) * CullBlock);
+            size_t count = 0;
+            for (size_t i = block * CullBlock; i < end; ++i) count += inView(agents[i]) ? 1 : 0;
+            impl.blockStart[block + 1] = count;
+        }
+    });
+    for (size_t block = 0; block < blocks; ++block) impl.blockStart[block + 1] += impl.blockStart[block];
+    
+    impl.agentCount = impl.blockStart[blocks];
+    if (impl.vertices.getVertexCount() < impl.agentCount * 4) {
+        impl.vertices.resize(impl.agentCount * 4);
+    }
+    if (impl.agentCount == 0) return;
+    
+    // Test again while filling; each block writes only its own quads
+    sf::Vertex* out = &impl.vertices[0];
+    forEachBlock([&impl, &inView, agents, out](size_t first, size_t last) {
+        for (size_t block = first; block < last; ++block) {
+            const size_t end = std::min(agents.size(), (block + 1) * CullBlock);
+            size_t slot = impl.blockStart[block];
+            for (size_t i = block * CullBlock; i < end; ++i) {
+                if (inView(agents[i])) impl.fillQuad(agents[i], out + slot++ * 4);
+            }
+        }
+    });
+}
+
+size_t EntityBatch::getAgentCount() const {
+    return m_impl->agentCount;
+}
+
+void EntityBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (m_impl->agentCount == 0) return;
+    
+    // The array may be larger than this frame's snapshot; draw only the live quads
+    states.texture = m_impl->texture;
+    target.draw(&m_impl->vertices[0], m_impl->agentCount * 4, sf::Quads, states);
+}
+
+} // namespace RoadSim::Render
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace RoadSim::Render {
+
+/**
+ * @brief Kind of moving agent, selecting its size, colour and atlas cell
+ */
+enum class AgentKind : uint8_t {
+    Vehicle,
+    Pedestrian,
+    Cyclist,
+    Count
+};
+
+/**
+ * @brief Render snapshot of one agent
+ */
+struct AgentInstance {
+    sf::Vector2f position;
+    sf::Vector2f direction{1.0f, 0.0f}; // Unit heading (cos, sin)
+    AgentKind kind = AgentKind::Vehicle;
+};
+
+/**
+ * @brief Draws every agent as one textured quad from a single vertex array
+ * update() rewrites a streaming sf::VertexArray from the agents' snapshot,
+ * splitting the work across threads when a ParallelFor is set, and draw()
+ * submits it with one draw call. Per-kind colours and texture atlas cells
+ * are baked into the vertices, so vehicles, pedestrians and cyclists share
+ * the batch.
+ */
+class EntityBatch : public sf::Drawable {
+public:
+    static constexpr size_t KindCount = static_cast<size_t>(AgentKind::Count);
+    
+    /**
+     * @brief Runs body(begin, end) over [0, count) in parallel and returns when all ranges are done
+     */
+    using ParallelFor = std::function<void(size_t count, const std::function<void(size_t, size_t)>& body)>;
+    
+    /**
+     * @brief Appearance of one agent kind
+     */
+    struct KindStyle {
+        sf::Vector2f size;          // Length along the heading, width across (world units)
+        sf::Color color;
+        sf::IntRect textureRect;    // Atlas cell; ignored without a texture
+    };
+    
+    EntityBatch();
+    ~EntityBatch() override;
+    
+    // Non-copyable
+    EntityBatch(const EntityBatch&) = delete;
+    EntityBatch& operator=(const EntityBatch&) = delete;
+    
+    void setKindStyle(AgentKind kind, const KindStyle& style);
+    const KindStyle& getKindStyle(AgentKind kind) const;
+    
+    /**
+     * @brief Texture atlas sampled by all agents (nullptr for flat colours)
+     */
+    void setTexture(const sf::Texture* atlas);
+    
+    /**
+     * @brief Parallel loop used by update() for large snapshots (unset = single-threaded)
+     */
+    void setParallelFor(ParallelFor parallelFor);
+    
+    /**
+     * @brief Rebuild the vertices from this frame's snapshot
+     * @param agents Agents to draw; not retained
+     */
+    void update(std::span<const AgentInstance> agents);
+    
+    /**
+     * @brief Rebuild the vertices from the agents overlapping visibleArea only
+     * The view test runs in blocks of agents on the ParallelFor, like the fill:
+     * one pass counts the agents in view per block, a prefix sum places the
+     * blocks, and a second pass writes their quads in snapshot order.
+     * @param agents Agents to draw; not retained
+     * @param visibleArea World-space area shown by the view
+     */
+    void update(std::span<const AgentInstance> agents, const sf::FloatRect& visibleArea);
+    
+    size_t getAgentCount() const;
+    
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::Render
@@ -1,20 +1,83 @@
 #include "Renderer.h"
+#include "DensityOverlay.h"
+#include "RoadMesh.h"
+#include "../core/MapSpatialIndex.h"
+#include <chrono>
 #include <iostream>
 
 namespace RoadSim::Render {
 
+namespace {
+
+// How long the map revision must stay unchanged before the geometry is rebuilt
+constexpr std::chrono::milliseconds MapSettleTime(250);
+
+} // namespace
+
 struct Renderer::Impl {
     sf::RenderTarget* renderTarget = nullptr;
     sf::View camera;
     sf::Font font;
     bool debugMode = false;
+    std::string metricsText;
     bool initialized = false;
     
     // Rendering resources
     sf::CircleShape nodeShape;
-    sf::RectangleShape roadShape;
-    sf::CircleShape vehicleShape;
     sf::Text debugText;
+    sf::VertexArray debugGrid{sf::Quads};
+    
+    // Static road geometry, rebuilt once the map revision settles; the
+    // mesh and the density lines are tiled by the cells of the index
+    Core::MapSpatialIndex spatialIndex;
+    RoadMesh roadMesh;
+    DensityOverlay density;
+    uint64_t roadMeshRevision = 0;
+    bool roadMeshBuilt = false;
+    
+    // Newest revision seen but not built yet, and when it first appeared
+    uint64_t pendingRevision = 0;
+    std::chrono::steady_clock::time_point pendingSince;
+    
+    // All visible agents as quads in one streaming vertex array
+    EntityBatch entities;
+    EntityBatch::ParallelFor parallelFor;
+    
+    LodThresholds lodThresholds;
+    Statistics statistics;
+    
+    sf::FloatRect visibleArea() const {
+        const sf::Vector2f size = camera.getSize();
+        const sf::Vector2f center = camera.getCenter();
+        return sf::FloatRect(center.x - size.x / 2.0f, center.y - size.y / 2.0f, size.x, size.y);
+    }
+    
+    DetailLevel detailLevel() const {
+        if (!renderTarget || camera.getSize().y <= 0.0f) return DetailLevel::Detail;
+        
+        const float pixelsPerUnit = static_cast<float>(renderTarget->getSize().y) / camera.getSize().y;
+        if (pixelsPerUnit >= lodThresholds.markings) return DetailLevel::Detail;
+        if (pixelsPerUnit >= lodThresholds.agents) return DetailLevel::Standard;
+        return DetailLevel::Overview;
+    }
+    
+    void drawMesh(uint32_t materials) {
+        statistics.drawCalls += roadMesh.drawVisible(*renderTarget, sf::RenderStates::Default, spatialIndex, visibleArea(), materials);
+    }
+    
+    void buildDebugGrid() {
+        const sf::Color color(64, 64, 64);
+        auto addLine = [&](float x, float y, float width, float height) {
+            debugGrid.append(sf::Vertex(sf::Vector2f(x, y), color));
+            debugGrid.append(sf::Vertex(sf::Vector2f(x + width, y), color));
+            debugGrid.append(sf::Vertex(sf::Vector2f(x + width, y + height), color));
+            debugGrid.append(sf::Vertex(sf::Vector2f(x, y + height), color));
+        };
+        
+        debugGrid.clear();
+        for (int x = 0; x < 1200; x += 50) addLine(static_cast<float>(x), 0.0f, 2.0f, 600.0f);
+        for (int y = 0; y < 800; y += 50) addLine(0.0f, static_cast<float>(y), 1200.0f, 2.0f);
+    }
 };
 
 Renderer::Renderer() : m_impl(std::make_unique<Impl>()) {
@@ -42,11 +105,7 @@ void Renderer::initialize(sf::RenderTarget* target) {
     m_impl->nodeShape.setFillColor(sf::Color::White);
     m_impl->nodeShape.setOrigin(5.0f, 5.0f);
     
-    m_impl->roadShape.setFillColor(sf::Color(128, 128, 128));
-    
-    m_impl->vehicleShape.setRadius(3.0f);
-    m_impl->vehicleShape.setFillColor(sf::Color::Red);
-    m_impl->vehicleShape.setOrigin(3.0f, 3.0f);
+    m_impl->buildDebugGrid();
     
     // TODO: Load font for text rendering
     // if (!m_impl->font.loadFromFile("assets/fonts/default.ttf")) {
@@ -62,6 +121,11 @@ void Renderer::beginFrame() {
     
     // Set camera view
     m_impl->renderTarget->setView(m_impl->camera);
+    
+    const size_t agentsDrawn = m_impl->statistics.agentsDrawn;
+    m_impl->statistics = Statistics();
+    m_impl->statistics.agentsDrawn = agentsDrawn;
+    m_impl->statistics.level = m_impl->detailLevel();
 }
 
 void Renderer::endFrame() {
@@ -80,55 +144,89 @@ void Renderer::clear(const sf::Color& color) {
 void Renderer::renderRoads() {
     if (!m_impl->initialized || !m_impl->renderTarget) return;
     
-    // TODO: Render actual road network
-    // - Draw road segments as rectangles
-    // - Draw lane markings
-    // - Draw intersections
-    
-    // Placeholder: Draw a simple grid
     if (m_impl->debugMode) {
-        sf::RectangleShape gridLine(sf::Vector2f(2.0f, 600.0f));
-        gridLine.setFillColor(sf::Color(64, 64, 64));
-        
-        for (int x = 0; x < 1200; x += 50) {
-            gridLine.setPosition(static_cast<float>(x), 0);
-            m_impl->renderTarget->draw(gridLine);
-        }
-        
-        gridLine.setSize(sf::Vector2f(1200.0f, 2.0f));
-        for (int y = 0; y < 800; y += 50) {
-            gridLine.setPosition(0, static_cast<float>(y));
-            m_impl->renderTarget->draw(gridLine);
+        m_impl->renderTarget->draw(m_impl->debugGrid);
+        m_impl->statistics.drawCalls++;
+    }
+    
+    // Only the tiles under the view are submitted, one call per row of tiles at most
+    switch (m_impl->detailLevel()) {
+        case DetailLevel::Detail:
+            m_impl->drawMesh(RoadMesh::materialBit(RoadMesh::Material::Asphalt) |
+                             RoadMesh::materialBit(RoadMesh::Material::LaneMarking) |
+                             RoadMesh::materialBit(RoadMesh::Material::CenterLine));
+            break;
+        case DetailLevel::Standard:
+            m_impl->drawMesh(RoadMesh::materialBit(RoadMesh::Material::Asphalt));
+            break;
+        case DetailLevel::Overview:
+            m_impl->statistics.drawCalls += m_impl->density.drawVisible(*m_impl->renderTarget, sf::RenderStates::Default,
+                                                                        m_impl->spatialIndex, m_impl->visibleArea());
+            break;
+    }
+}
+
+void Renderer::setMap(const Core::MapData& map, uint64_t revision) {
+    if (m_impl->roadMeshBuilt && revision == m_impl->roadMeshRevision) return;
+    
+    // While edits keep coming, keep drawing the last build; rebuild once they settle
+    if (m_impl->roadMeshBuilt) {
+        const auto now = std::chrono::steady_clock::now();
+        if (revision != m_impl->pendingRevision) {
+            m_impl->pendingRevision = revision;
+            m_impl->pendingSince = now;
+            return;
         }
+        if (now - m_impl->pendingSince < MapSettleTime) return;
     }
+    
+    m_impl->spatialIndex.build(map);
+    m_impl->roadMesh.build(map, m_impl->spatialIndex);
+    m_impl->density.build(map, m_impl->spatialIndex);
+    m_impl->roadMeshRevision = revision;
+    m_impl->roadMeshBuilt = true;
+}
+
+void Renderer::setEntities(std::span<const AgentInstance> agents) {
+    // Far out, agents collapse into per-road density and the batch stays empty
+    if (m_impl->detailLevel() == DetailLevel::Overview) {
+        m_impl->entities.update({});
+        m_impl->density.update(agents, m_impl->spatialIndex, m_impl->parallelFor);
+    } else {
+        m_impl->entities.update(agents, m_impl->visibleArea());
+    }
+    m_impl->statistics.agentsDrawn = m_impl->entities.getAgentCount();
+}
+
+void Renderer::setParallelFor(EntityBatch::ParallelFor parallelFor) {
+    m_impl->entities.setParallelFor(parallelFor);
+    m_impl->parallelFor = std::move(parallelFor);
 }
 
 void Renderer::renderEntities() {
     if (!m_impl->initialized || !m_impl->renderTarget) return;
+    if (m_impl->entities.getAgentCount() == 0) return;
     
-    // TODO: Render actual entities
-    // - Draw vehicles with appropriate colors and sizes
-    // - Draw pedestrians
-    // - Draw cyclists
-    // - Show entity states (moving, waiting, etc.)
+    m_impl->renderTarget->draw(m_impl->entities);
+    m_impl->statistics.drawCalls++;
+    
+    // TODO: Show entity states (moving, waiting, etc.)
 }
 
 void Renderer::renderTrafficLights() {
     if (!m_impl->initialized || !m_impl->renderTarget) return;
+    if (m_impl->detailLevel() == DetailLevel::Overview) return;
     
-    // TODO: Render traffic lights
-    // - Draw traffic light poles
-    // - Show current light state (red, yellow, green)
-    // - Render timing information if in debug mode
+    // TODO: Show current light state (red, yellow, green) once signals have state
+    m_impl->drawMesh(RoadMesh::materialBit(RoadMesh::Material::TrafficLight));
 }
 
 void Renderer::renderSpawnPoints() {
     if (!m_impl->initialized || !m_impl->renderTarget) return;
+    if (m_impl->detailLevel() == DetailLevel::Overview) return;
     
-    // TODO: Render spawn points
-    // - Draw spawn point markers
-    // - Show spawn rates and entity types
-    // - Indicate active/inactive states
+    // TODO: Show spawn rates and active/inactive states
+    m_impl->drawMesh(RoadMesh::materialBit(RoadMesh::Material::SpawnPoint));
 }
 
 void Renderer::renderEditorUI() {
@@ -151,12 +249,16 @@ void Renderer::renderMetrics() {
     // - Performance metrics
     
     if (m_impl->debugMode) {
-        m_impl->debugText.setString("RoadSim - Debug Mode");
+        m_impl->debugText.setString("RoadSim - Debug Mode\n" + m_impl->metricsText);
         m_impl->debugText.setPosition(10, 10);
         m_impl->renderTarget->draw(m_impl->debugText);
     }
 }
 
+void Renderer::setMetricsText(const std::string& text) {
+    m_impl->metricsText = text;
+}
+
 void Renderer::setCamera(float x, float y, float zoom) {
     if (!m_impl->initialized) return;
     
@@ -191,4 +293,28 @@ void Renderer::setDebugMode(bool enabled) {
     std::cout << "[Render] Debug mode " << (enabled ? "enabled" : "disabled") << std::endl;
 }
 
+void Renderer::setLodThresholds(const LodThresholds& thresholds) {
+    m_impl->lodThresholds = thresholds;
+}
+
+const Renderer::LodThresholds& Renderer::getLodThresholds() const {
+    return m_impl->lodThresholds;
+}
+
+Renderer::DetailLevel Renderer::getDetailLevel() const {
+    return m_impl->detailLevel();
+}
+
+sf::FloatRect Renderer::getVisibleArea() const {
+    return m_impl->visibleArea();
+}
+
+const Renderer::Statistics& Renderer::getStatistics() const {
+    return m_impl->statistics;
+}
+
+const Core::MapSpatialIndex& Renderer::getSpatialIndex() const {
+    return m_impl->spatialIndex;
+}
+
 } // namespace RoadSim::Render
\ No newline at end of file
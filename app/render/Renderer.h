@@ -1,8 +1,17 @@
 #pragma once
 
+#include "EntityBatch.h"
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
+#include <string>
+
+namespace RoadSim::Core {
+    struct MapData;
+    class MapSpatialIndex;
+}
 
 namespace RoadSim::Render {
 
@@ -12,6 +21,32 @@ namespace RoadSim::Render {
  */
 class Renderer {
 public:
+    /**
+     * @brief Level of detail chosen from the zoom (screen pixels per world unit)
+     */
+    enum class DetailLevel {
+        Detail,     // Roads, lane markings, markers and individual agents
+        Standard,   // Roads, markers and agents without lane markings
+        Overview    // Roads coloured by traffic density; no agents or markers
+    };
+    
+    /**
+     * @brief Zoom thresholds in screen pixels per world unit
+     */
+    struct LodThresholds {
+        float markings = 1.0f;  // Lane markings at or above this zoom
+        float agents = 0.35f;   // Individual agents at or above this zoom, density below
+    };
+    
+    /**
+     * @brief What the last frame submitted
+     */
+    struct Statistics {
+        size_t drawCalls = 0;
+        size_t agentsDrawn = 0;
+        DetailLevel level = DetailLevel::Detail;
+    };
+    
     Renderer();
     ~Renderer();
     
@@ -46,12 +81,40 @@ public:
     void clear(const sf::Color& color = sf::Color(45, 45, 45));
     
     /**
-     * @brief Render road network
+     * @brief Provide the road network to draw
+     * Indexes it in a spatial grid and tessellates it into cached vertex
+     * buffers when the revision differs from the one last built; otherwise
+     * this is free. The first map is built at once. After that a rebuild
+     * (~120 ms on large maps) waits until the revision has held still for a
+     * quarter of a second, so a burst of edits costs one rebuild when it
+     * ends instead of one per frame; until then the previous geometry is
+     * drawn.
+     * @param map Map tables (not retained)
+     * @param revision Counter that changes whenever the tables do
+     */
+    void setMap(const Core::MapData& map, uint64_t revision);
+    
+    /**
+     * @brief Render the part of the road network inside the view
+     * At overview zoom, roads are drawn as density-coloured lines instead.
      */
     void renderRoads();
     
     /**
-     * @brief Render traffic entities (vehicles, pedestrians, cyclists)
+     * @brief Provide this frame's agents
+     * Rebuilds the entity batch from the agents inside the view, or the
+     * per-road density at overview zoom; call after setCamera().
+     * @param agents Render snapshot of the simulation (not retained)
+     */
+    void setEntities(std::span<const AgentInstance> agents);
+    
+    /**
+     * @brief Parallel loop used to fill large entity batches and density counts
+     */
+    void setParallelFor(EntityBatch::ParallelFor parallelFor);
+    
+    /**
+     * @brief Render traffic entities (vehicles, pedestrians, cyclists) in one draw call
      */
     void renderEntities();
     
@@ -75,6 +138,12 @@ public:
      */
     void renderMetrics();
     
+    /**
+     * @brief Set the text shown by the metrics overlay
+     * @param text Multi-line metrics report
+     */
+    void setMetricsText(const std::string& text);
+    
     /**
      * @brief Set camera position and zoom
      * @param x Camera X position
@@ -101,6 +170,26 @@ public:
      */
     void setDebugMode(bool enabled);
     
+    void setLodThresholds(const LodThresholds& thresholds);
+    const LodThresholds& getLodThresholds() const;
+    
+    /**
+     * @brief Detail level for the current camera zoom
+     */
+    DetailLevel getDetailLevel() const;
+    
+    /**
+     * @brief World rectangle covered by the current camera
+     */
+    sf::FloatRect getVisibleArea() const;
+    
+    const Statistics& getStatistics() const;
+    
+    /**
+     * @brief Spatial grid over the current map, shared with the road mesh
+     */
+    const Core::MapSpatialIndex& getSpatialIndex() const;
+    
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
@@ -0,0 +1,472 @@
+#include "RoadMesh.h"
+#include "../core/MapData.h"
+#include "../core/MapSpatialIndex.h"
+#include "../core/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace RoadSim::Render {
+
+namespace {
+
+constexpr int IntersectionSides = 8;
+
+// Copied rather than constructed: sf::Vertex's constructors are not inline
+void appendVertex(std::vector<sf::Vertex>& vertices, sf::Vector2f position, sf::Color color) {
+    static const sf::Vertex prototype;
+    sf::Vertex& vertex = vertices.emplace_back(prototype);
+    vertex.position = position;
+    vertex.color = color;
+}
+
+// Two triangles for the quad a-b-c-d (in winding order)
+void appendQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d, sf::Color color) {
+    appendVertex(vertices, a, color);
+    appendVertex(vertices, b, color);
+    appendVertex(vertices, c, color);
+    appendVertex(vertices, a, color);
+    appendVertex(vertices, c, color);
+    appendVertex(vertices, d, color);
+}
+
+// Item ids grouped by tile (counting sort), so geometry can be emitted tile by tile
+struct TileBuckets {
+    std::vector<uint32_t> start;
+    std::vector<uint32_t> items;
+    
+    void fill(size_t tileCount, const std::vector<int>& tileOfItem) {
+        start.assign(tileCount + 1, 0);
+        for (const int tile : tileOfItem) {
+            if (tile >= 0) start[static_cast<size_t>(tile) + 1]++;
+        }
+        for (size_t tile = 1; tile < start.size(); ++tile) start[tile] += start[tile - 1];
+        
+        items.resize(start.back());
+        std::vector<uint32_t> next(start.begin(), start.end() - 1);
+        for (size_t item = 0; item < tileOfItem.size(); ++item) {
+            if (tileOfItem[item] >= 0) items[next[static_cast<size_t>(tileOfItem[item])]++] = static_cast<uint32_t>(item);
+        }
+    }
+    
+    std::span<const uint32_t> tile(size_t index) const {
+        return {items.data() + start[index], items.data() + start[index + 1]};
+    }
+};
+
+// Stretch [from, to) of a road, in distance from its start node; roads longer
+// than a tile are cut into such pieces so no item reaches far past its tile
+struct RoadPiece {
+    uint32_t road;
+    float from;
+    float to;
+};
+
+// Strip of the given width along the centre line from -> to
+void appendStrip(std::vector<sf::Vertex>& vertices, sf::Vector2f from, sf::Vector2f to, sf::Vector2f normal, float halfWidth, sf::Color color) {
+    const sf::Vector2f side = normal * halfWidth;
+    appendQuad(vertices, from + side, to + side, to - side, from - side, color);
+}
+
+} // namespace
+
+struct RoadMesh::Impl {
+    Style style;
+    
+    // CPU copies are dropped once uploaded, unless vertex buffers are unavailable
+    std::array<std::vector<sf::Vertex>, MaterialCount> vertices;
+    std::array<sf::VertexBuffer, MaterialCount> buffers;
+    std::array<size_t, MaterialCount> counts{};
+    bool gpu = false;
+    sf::FloatRect bounds;
+    
+    // First vertex of each tile per material (tileCount + 1 entries)
+    std::array<std::vector<uint32_t>, MaterialCount> tileStart;
+    
+    // Furthest any geometry reaches outside the tile of its centre
+    float tileMargin = 0.0f;
+    
+    Impl() {
+        for (sf::VertexBuffer& buffer : buffers) {
+            buffer.setPrimitiveType(sf::Triangles);
+            buffer.setUsage(sf::VertexBuffer::Static);
+        }
+    }
+    
+    std::vector<sf::Vertex>& layer(Material material) {
+        return vertices[static_cast<size_t>(material)];
+    }
+    
+    sf::Color color(Material material) const {
+        return style.colors[static_cast<size_t>(material)];
+    }
+    
+    void tessellate(const Core::MapData& map, const Core::MapSpatialIndex& index) {
+        for (auto& layerVertices : vertices) layerVertices.clear();
+        tileMargin = 0.0f;
+        
+        std::unordered_map<int32_t, size_t> nodeIndex;
+        nodeIndex.reserve(map.nodes.size());
+        for (size_t i = 0; i < map.nodes.size(); ++i) {
+            nodeIndex.emplace(map.nodes[i].id, i);
+        }
+        
+        // Intersection radius: half the widest road meeting the node
+        std::vector<float> radius(map.nodes.size(), 0.0f);
+        for (const Core::MapRoad& road : map.roads) {
+            const auto from = nodeIndex.find(road.fromNode);
+            const auto to = nodeIndex.find(road.toNode);
+            if (from == nodeIndex.end() || to == nodeIndex.end()) continue;
+            const float halfWidth = 0.5f * style.laneWidth * static_cast<float>(std::max(road.lanes, 1));
+            radius[from->second] = std::max(radius[from->second], halfWidth);
+            radius[to->second] = std::max(radius[to->second], halfWidth);
+        }
+        
+        // Every item belongs to the tile of its centre; an empty index makes one tile
+        const size_t tileCount = index.isEmpty() ? 1 : static_cast<size_t>(index.getCellCount());
+        auto tileOf = [&index](sf::Vector2f point) { return index.isEmpty() ? 0 : index.getCellIndex(point); };
+        
+        // Roads are cut into pieces no longer than a tile, each filed under the
+        // tile of its own midpoint, so the view margin stays about one tile
+        const float maxPieceLength = index.isEmpty() ? 0.0f : index.getCellSize();
+        std::vector<RoadPiece> pieces;
+        std::vector<int> pieceTiles;
+        pieces.reserve(map.roads.size());
+        pieceTiles.reserve(map.roads.size());
+        std::vector<size_t> roadFrom(map.roads.size()), roadTo(map.roads.size());
+        for (size_t i = 0; i < map.roads.size(); ++i) {
+            const auto from = nodeIndex.find(map.roads[i].fromNode);
+            const auto to = nodeIndex.find(map.roads[i].toNode);
+            if (from == nodeIndex.end() || to == nodeIndex.end()) continue;
+            roadFrom[i] = from->second;
+            roadTo[i] = to->second;
+            const sf::Vector2f start(map.nodes[from->second].x, map.nodes[from->second].y);
+            const sf::Vector2f delta = sf::Vector2f(map.nodes[to->second].x, map.nodes[to->second].y) - start;
+            const float length = std::hypot(delta.x, delta.y);
+            if (length <= 0.0f) continue;
+            
+            const size_t count = maxPieceLength > 0.0f ? std::max<size_t>(1, static_cast<size_t>(std::ceil(length / maxPieceLength))) : 1;
+            for (size_t piece = 0; piece < count; ++piece) {
+                const float pieceFrom = length * static_cast<float>(piece) / static_cast<float>(count);
+                const float pieceTo = length * static_cast<float>(piece + 1) / static_cast<float>(count);
+                pieces.push_back({static_cast<uint32_t>(i), pieceFrom, pieceTo});
+                pieceTiles.push_back(tileOf(start + delta * (0.5f * (pieceFrom + pieceTo) / length)));
+            }
+        }
+        
+        // Size the layers up front: six vertices per road quad and per dash
+        const float period = std::max(style.dashLength + style.dashGap, 0.01f);
+        size_t asphalt = pieces.size() * 6 + map.nodes.size() * IntersectionSides * 3;
+        size_t dashes = 0;
+        size_t centerLines = 0;
+        for (const Core::MapRoad& road : map.roads) {
+            const auto from = nodeIndex.find(road.fromNode);
+            const auto to = nodeIndex.find(road.toNode);
+            if (from == nodeIndex.end() || to == nodeIndex.end() || road.lanes < 2) continue;
+            const Core::MapNode& a = map.nodes[from->second];
+            const Core::MapNode& b = map.nodes[to->second];
+            const float length = std::hypot(b.x - a.x, b.y - a.y);
+            const size_t count = maxPieceLength > 0.0f ? static_cast<size_t>(std::ceil(length / maxPieceLength)) : 1;
+            dashes += static_cast<size_t>(road.lanes - 1) * (static_cast<size_t>(length / period) + 1) * 6;
+            centerLines += road.oneWay ? 0 : 6 * std::max<size_t>(count, 1);
+        }
+        layer(Material::Asphalt).reserve(asphalt);
+        layer(Material::LaneMarking).reserve(dashes);
+        layer(Material::CenterLine).reserve(centerLines);
+        layer(Material::TrafficLight).reserve(map.trafficLights.size() * 6);
+        layer(Material::SpawnPoint).reserve(map.spawnPoints.size() * 6);
+        
+        std::vector<int> nodeTiles(map.nodes.size(), -1);
+        for (size_t i = 0; i < map.nodes.size(); ++i) {
+            if (radius[i] > 0.0f) nodeTiles[i] = tileOf(sf::Vector2f(map.nodes[i].x, map.nodes[i].y));
+        }
+        std::vector<int> lightTiles(map.trafficLights.size(), -1);
+        std::vector<size_t> lightNodes(map.trafficLights.size());
+        for (size_t i = 0; i < map.trafficLights.size(); ++i) {
+            const auto node = nodeIndex.find(map.trafficLights[i].nodeId);
+            if (node == nodeIndex.end()) continue;
+            lightNodes[i] = node->second;
+            lightTiles[i] = tileOf(sf::Vector2f(map.nodes[node->second].x, map.nodes[node->second].y));
+        }
+        std::vector<int> spawnTiles(map.spawnPoints.size());
+        for (size_t i = 0; i < map.spawnPoints.size(); ++i) {
+            spawnTiles[i] = tileOf(sf::Vector2f(map.spawnPoints[i].x, map.spawnPoints[i].y));
+        }
+        
+        TileBuckets roads, nodes, lights, spawns;
+        roads.fill(tileCount, pieceTiles);
+        nodes.fill(tileCount, nodeTiles);
+        lights.fill(tileCount, lightTiles);
+        spawns.fill(tileCount, spawnTiles);
+        
+        for (auto& starts : tileStart) starts.assign(tileCount + 1, 0);
+        for (size_t tile = 0; tile < tileCount; ++tile) {
+            for (size_t m = 0; m < MaterialCount; ++m) {
+                tileStart[m][tile] = static_cast<uint32_t>(vertices[m].size());
+            }
+            
+            for (const uint32_t p : roads.tile(tile)) {
+                const RoadPiece& piece = pieces[p];
+                const size_t i = piece.road;
+                addRoad(map.roads[i], map.nodes[roadFrom[i]], map.nodes[roadTo[i]], radius[roadFrom[i]], radius[roadTo[i]],
+                        piece.from, piece.to);
+            }
+            for (const uint32_t i : nodes.tile(tile)) {
+                addIntersection(map.nodes[i], radius[i]);
+            }
+            for (const uint32_t i : lights.tile(tile)) {
+                addMarker(Material::TrafficLight, sf::Vector2f(map.nodes[lightNodes[i]].x, map.nodes[lightNodes[i]].y));
+            }
+            for (const uint32_t i : spawns.tile(tile)) {
+                addMarker(Material::SpawnPoint, sf::Vector2f(map.spawnPoints[i].x, map.spawnPoints[i].y));
+            }
+        }
+        for (size_t m = 0; m < MaterialCount; ++m) {
+            tileStart[m][tileCount] = static_cast<uint32_t>(vertices[m].size());
+        }
+        tileMargin = std::max(tileMargin, style.markerSize);
+    }
+    
+    // The stretch [from, to) of the road: asphalt, the centre line over it and the dashes starting in it
+    void addRoad(const Core::MapRoad& road, const Core::MapNode& a, const Core::MapNode& b, float radiusA, float radiusB,
+                 float from, float to) {
+        const sf::Vector2f start(a.x, a.y);
+        const sf::Vector2f end(b.x, b.y);
+        const sf::Vector2f delta = end - start;
+        const float length = std::hypot(delta.x, delta.y);
+        if (length <= 0.0f) return;
+        
+        const sf::Vector2f direction = delta / length;
+        const sf::Vector2f normal(-direction.y, direction.x);
+        const int lanes = std::max(road.lanes, 1);
+        const float halfWidth = 0.5f * style.laneWidth * static_cast<float>(lanes);
+        appendStrip(layer(Material::Asphalt), start + direction * from, start + direction * to, normal, halfWidth,
+                    color(Material::Asphalt));
+        tileMargin = std::max(tileMargin, 0.5f * (to - from) + halfWidth);
+        
+        // Markings stop where the intersections begin
+        const float markingStart = radiusA;
+        const float markingEnd = length - radiusB;
+        if (lanes < 2 || markingEnd <= markingStart) return;
+        
+        // A dash may run on past the end of the piece it starts in
+        const float sliceStart = std::max(markingStart, from);
+        const float sliceEnd = std::min(markingEnd, to);
+        tileMargin = std::max(tileMargin, 0.5f * (to - from) + style.dashLength + halfWidth);
+        
+        // Two-way roads carry (lanes + 1) / 2 lanes forward, the rest back
+        const int forwardLanes = road.oneWay ? lanes : (lanes + 1) / 2;
+        const float halfMarking = 0.5f * style.markingWidth;
+        for (int boundary = 1; boundary < lanes; ++boundary) {
+            const sf::Vector2f offset = normal * (static_cast<float>(boundary) * style.laneWidth - halfWidth);
+            
+            if (!road.oneWay && boundary == forwardLanes) {
+                if (sliceEnd > sliceStart) {
+                    appendStrip(layer(Material::CenterLine), start + offset + direction * sliceStart,
+                                start + offset + direction * sliceEnd, normal, halfMarking, color(Material::CenterLine));
+                }
+                continue;
+            }
+            
+            // Dash positions are computed from the road start, so neighbouring pieces agree on them
+            const float period = std::max(style.dashLength + style.dashGap, 0.01f);
+            const int firstDash = std::max(0, static_cast<int>(std::floor((sliceStart - markingStart) / period)));
+            for (int dash = firstDash;; ++dash) {
+                const float s = markingStart + static_cast<float>(dash) * period;
+                if (s >= sliceEnd) break;
+                if (s < from) continue;
+                const float dashEnd = std::min(s + style.dashLength, markingEnd);
+                appendStrip(layer(Material::LaneMarking), start + offset + direction * s,
+                            start + offset + direction * dashEnd, normal, halfMarking, color(Material::LaneMarking));
+            }
+        }
+    }
+    
+    void addIntersection(const Core::MapNode& node, float radius) {
+        std::vector<sf::Vertex>& asphalt = layer(Material::Asphalt);
+        const sf::Vector2f center(node.x, node.y);
+        const sf::Color fill = color(Material::Asphalt);
+        
+        // Polygon circumscribing the radius, so road ends are fully covered
+        const float pi = 3.14159265f;
+        const float outer = radius / std::cos(pi / IntersectionSides);
+        for (int side = 0; side < IntersectionSides; ++side) {
+            const float angle0 = 2.0f * pi * static_cast<float>(side) / IntersectionSides;
+            const float angle1 = 2.0f * pi * static_cast<float>(side + 1) / IntersectionSides;
+            appendVertex(asphalt, center, fill);
+            appendVertex(asphalt, center + outer * sf::Vector2f(std::cos(angle0), std::sin(angle0)), fill);
+            appendVertex(asphalt, center + outer * sf::Vector2f(std::cos(angle1), std::sin(angle1)), fill);
+        }
+        tileMargin = std::max(tileMargin, outer);
+    }
+    
+    void addMarker(Material material, sf::Vector2f center) {
+        const float half = 0.5f * style.markerSize;
+        appendQuad(layer(material), center + sf::Vector2f(-half, -half), center + sf::Vector2f(half, -half),
+                   center + sf::Vector2f(half, half), center + sf::Vector2f(-half, half), color(material));
+    }
+    
+    void computeBounds() {
+        float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+        bool first = true;
+        for (const auto& layerVertices : vertices) {
+            for (const sf::Vertex& vertex : layerVertices) {
+                const sf::Vector2f p = vertex.position;
+                if (first) {
+                    left = right = p.x;
+                    top = bottom = p.y;
+                    first = false;
+                    continue;
+                }
+                left = std::min(left, p.x);
+                right = std::max(right, p.x);
+                top = std::min(top, p.y);
+                bottom = std::max(bottom, p.y);
+            }
+        }
+        bounds = sf::FloatRect(left, top, right - left, bottom - top);
+    }
+    
+    void upload() {
+        gpu = sf::VertexBuffer::isAvailable();
+        for (size_t i = 0; i < MaterialCount; ++i) {
+            counts[i] = vertices[i].size();
+            if (!gpu) continue;
+            
+            if (!buffers[i].create(counts[i]) || (counts[i] > 0 && !buffers[i].update(vertices[i].data()))) {
+                std::cerr << "[Render] Failed to upload road vertex buffer; drawing from memory" << std::endl;
+                gpu = false;
+                continue;
+            }
+        }
+        
+        // The GPU holds the only copy needed for drawing
+        if (gpu) {
+            for (auto& layerVertices : vertices) {
+                layerVertices.clear();
+                layerVertices.shrink_to_fit();
+            }
+        }
+    }
+};
+
+RoadMesh::RoadMesh() : m_impl(std::make_unique<Impl>()) {}
+
+RoadMesh::~RoadMesh() = default;
+
+void RoadMesh::setStyle(const Style& style) {
+    m_impl->style = style;
+}
+
+const RoadMesh::Style& RoadMesh::getStyle() const {
+    return m_impl->style;
+}
+
+void RoadMesh::build(const Core::MapData& map, const Core::MapSpatialIndex& index) {
+    ROADSIM_TRACE_SCOPE("Render", "RoadMesh::build");
+    const auto start = std::chrono::steady_clock::now();
+    
+    m_impl->tessellate(map, index);
+    m_impl->computeBounds();
+    m_impl->upload();
+    
+    const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Render] Tessellated " << map.roads.size() << " roads into " << getVertexCount() << " vertices, "
+              << getDrawCallCount() << " draw calls (" << milliseconds << " ms)" << std::endl;
+}
+
+void RoadMesh::clear() {
+    for (auto& layerVertices : m_impl->vertices) layerVertices.clear();
+    for (auto& starts : m_impl->tileStart) starts.clear();
+    m_impl->counts.fill(0);
+    m_impl->bounds = sf::FloatRect();
+    m_impl->tileMargin = 0.0f;
+}
+
+size_t RoadMesh::drawVisible(sf::RenderTarget& target, const sf::RenderStates& states, const Core::MapSpatialIndex& index,
+                             const sf::FloatRect& area, uint32_t materials) const {
+    const Impl& impl = *m_impl;
+    
+    // Tiles hold items by centre, so widen the view by the furthest overhang
+    const float margin = impl.tileMargin;
+    const sf::FloatRect widened(area.left - margin, area.top - margin, area.width + 2.0f * margin, area.height + 2.0f * margin);
+    
+    size_t drawCalls = 0;
+    for (size_t m = 0; m < MaterialCount; ++m) {
+        if (!(materials & (1u << m)) || impl.counts[m] == 0) continue;
+        const std::vector<uint32_t>& starts = impl.tileStart[m];
+        
+        auto drawRange = [&](size_t first, size_t end) {
+            if (end <= first) return;
+            if (impl.gpu) {
+                target.draw(impl.buffers[m], first, end - first, states);
+            } else {
+                target.draw(impl.vertices[m].data() + first, end - first, sf::Triangles, states);
+            }
+            ++drawCalls;
+        };
+        
+        if (index.isEmpty() || starts.size() != static_cast<size_t>(index.getCellCount()) + 1) {
+            drawRange(0, impl.counts[m]);
+            continue;
+        }
+        
+        // Runs touching end to end are merged into one call
+        size_t runFirst = 0, runEnd = 0;
+        index.forEachCellRun(widened, [&](int firstCell, int lastCell) {
+            const size_t first = starts[static_cast<size_t>(firstCell)];
+            const size_t end = starts[static_cast<size_t>(lastCell) + 1];
+            if (first == runEnd) {
+                runEnd = end;
+                return;
+            }
+            drawRange(runFirst, runEnd);
+            runFirst = first;
+            runEnd = end;
+        });
+        drawRange(runFirst, runEnd);
+    }
+    return drawCalls;
+}
+
+size_t RoadMesh::getVertexCount() const {
+    size_t total = 0;
+    for (const size_t count : m_impl->counts) total += count;
+    return total;
+}
+
+size_t RoadMesh::getVertexCount(Material material) const {
+    return m_impl->counts[static_cast<size_t>(material)];
+}
+
+size_t RoadMesh::getDrawCallCount() const {
+    return static_cast<size_t>(std::count_if(m_impl->counts.begin(), m_impl->counts.end(),
+                                             [](size_t count) { return count > 0; }));
+}
+
+sf::FloatRect RoadMesh::getBounds() const {
+    return m_impl->bounds;
+}
+
+bool RoadMesh::usesVertexBuffers() const {
+    return m_impl->gpu;
+}
+
+void RoadMesh::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    for (size_t i = 0; i < MaterialCount; ++i) {
+        const size_t count = m_impl->counts[i];
+        if (count == 0) continue;
+        
+        if (m_impl->gpu) {
+            target.draw(m_impl->buffers[i], 0, count, states);
+        } else {
+            target.draw(m_impl->vertices[i].data(), count, sf::Triangles, states);
+        }
+    }
+}
+
+} // namespace RoadSim::Render
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <memory>
+
+namespace RoadSim::Core {
+    struct MapData;
+    class MapSpatialIndex;
+}
+
+namespace RoadSim::Render {
+
+/**
+ * @brief Road network tessellated once into static vertex buffers
+ * Road surfaces, intersections, lane markings and map markers are baked into
+ * triangle lists, one per material, and uploaded to sf::VertexBuffer (or kept
+ * in memory where vertex buffers are unavailable). Geometry only changes
+ * through build().
+ *
+ * Within each list, vertices are sorted by the MapSpatialIndex cell holding
+ * the item's centre; roads longer than a cell are cut into pieces no longer
+ * than one, so nothing reaches much more than a cell past its own. drawVisible()
+ * therefore draws only the cells overlapping the view (widened by that
+ * reach), one call per row of cells, or a single call per material once the
+ * view covers whole rows.
+ */
+class RoadMesh : public sf::Drawable {
+public:
+    /**
+     * @brief Draw layers, in drawing order
+     */
+    enum class Material {
+        Asphalt,        // Road surfaces and intersections
+        LaneMarking,    // Dashed lines between lanes of one direction
+        CenterLine,     // Solid line between the directions of a two-way road
+        TrafficLight,   // Marker on each signalised node
+        SpawnPoint,     // Marker on each spawn point
+        Count
+    };
+    
+    static constexpr uint32_t materialBit(Material material) {
+        return 1u << static_cast<uint32_t>(material);
+    }
+    
+    static constexpr size_t MaterialCount = static_cast<size_t>(Material::Count);
+    
+    /**
+     * @brief Dimensions in world units (metres) and colours
+     */
+    struct Style {
+        float laneWidth = 3.5f;
+        float markingWidth = 0.15f;
+        float dashLength = 3.0f;
+        float dashGap = 6.0f;
+        float markerSize = 2.5f;
+        std::array<sf::Color, MaterialCount> colors = {
+            sf::Color(80, 80, 85),
+            sf::Color(220, 220, 220),
+            sf::Color(230, 190, 40),
+            sf::Color(200, 40, 40),
+            sf::Color(60, 200, 90)
+        };
+    };
+    
+    RoadMesh();
+    ~RoadMesh() override;
+    
+    // Non-copyable (owns GPU buffers)
+    RoadMesh(const RoadMesh&) = delete;
+    RoadMesh& operator=(const RoadMesh&) = delete;
+    
+    void setStyle(const Style& style);
+    const Style& getStyle() const;
+    
+    /**
+     * @brief Tessellate the map and upload it, replacing the previous geometry
+     * @param map Road network; roads referencing missing nodes are skipped
+     * @param index Spatial index built from the same map; its cells become the mesh tiles
+     */
+    void build(const Core::MapData& map, const Core::MapSpatialIndex& index);
+    
+    /**
+     * @brief Draw the selected materials of the tiles overlapping area
+     * @param index The index passed to build()
+     * @param area Visible world rectangle
+     * @param materials Bitmask of materialBit() values
+     * @return Number of draw calls issued
+     */
+    size_t drawVisible(sf::RenderTarget& target, const sf::RenderStates& states, const Core::MapSpatialIndex& index,
+                       const sf::FloatRect& area, uint32_t materials) const;
+    
+    void clear();
+    
+    size_t getVertexCount() const;
+    size_t getVertexCount(Material material) const;
+    
+    /**
+     * @brief Draw calls issued by draw(), which ignores the view (materials with geometry)
+     */
+    size_t getDrawCallCount() const;
+    
+    /**
+     * @brief World-space bounds of the tessellated network
+     */
+    sf::FloatRect getBounds() const;
+    
+    /**
+     * @brief Whether geometry lives in GPU vertex buffers
+     */
+    bool usesVertexBuffers() const;
+    
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::Render
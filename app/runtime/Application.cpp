@@ -1,21 +1,83 @@
 #include "Application.h"
 #include "ThreadManager.h"
+#include "BehaviourExecutor.h"
+#include "FramePacer.h"
+#include "AutoSaver.h"
 #include "../core/Simulator.h"
 #include "../core/Scheduler.h"
 #include "../core/Scene.h"
+#include "../core/Trace.h"
 #include "../editor/MapEditor.h"
 #include "../editor/EntityEditor.h"
 #include "../render/Window.h"
 #include "../render/Renderer.h"
 #include "../render/UIManager.h"
 #include "../io/ConfigLoader.h"
+#include "../io/ConfigWatcher.h"
+#include "../io/MetricsWriter.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <chrono>
+#include <filesystem>
 #include <thread>
 
 namespace RoadSim::Runtime {
 
+namespace {
+
+// Split [0, count) over the workers and this thread; returns when every range is done.
+// Ranges are claimed from a shared counter, so this thread runs every range no worker
+// has started yet (workers may be busy with long tasks, or submission may fail) and
+// then waits only for the ranges already running. Helpers that start after the last
+// range was claimed return without touching body.
+void parallelFor(ThreadManager& threads, size_t count, const std::function<void(size_t, size_t)>& body) {
+    const size_t parts = std::min(threads.getWorkerThreadCount() + 1, count);
+    if (parts <= 1) {
+        body(0, count);
+        return;
+    }
+    
+    // Outlives this call: queued helpers may still run after it returns
+    struct Ranges {
+        const std::function<void(size_t, size_t)>* body = nullptr;
+        size_t count = 0;
+        size_t parts = 0;
+        size_t step = 0;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        
+        void run() {
+            for (size_t part = next.fetch_add(1, std::memory_order_relaxed); part < parts;
+                 part = next.fetch_add(1, std::memory_order_relaxed)) {
+                const size_t begin = std::min(count, part * step);
+                (*body)(begin, std::min(count, begin + step));
+                done.fetch_add(1, std::memory_order_release);
+            }
+        }
+    };
+    auto ranges = std::make_shared<Ranges>();
+    ranges->body = &body;
+    ranges->count = count;
+    ranges->parts = parts;
+    ranges->step = (count + parts - 1) / parts;
+    
+    for (size_t helper = 1; helper < parts; ++helper) {
+        if (threads.submitTask([ranges] { ranges->run(); }) == 0) break;
+    }
+    ranges->run();
+    
+    // Only ranges already running remain; they are short, so yield rather than sleep
+    while (ranges->done.load(std::memory_order_acquire) < parts) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace
+
 struct Application::Impl {
     // Subsystems
     std::unique_ptr<Core::Simulator> simulator;
@@ -27,7 +89,34 @@ struct Application::Impl {
     std::unique_ptr<Render::Renderer> renderer;
     std::unique_ptr<Render::UIManager> uiManager;
     std::unique_ptr<ThreadManager> threadManager;
+    std::unique_ptr<BehaviourExecutor> behaviours;
     std::unique_ptr<IO::ConfigLoader> configLoader;
+    std::unique_ptr<IO::ConfigWatcher> configWatcher;
+    
+    // Per-frame render snapshot of the scene's agents (reused, grows only)
+    std::vector<Render::AgentInstance> agentSnapshot;
+    
+    // Background map autosave, configured from IOConfig
+    std::unique_ptr<AutoSaver> autoSaver;
+    
+    // Network-wide samples, one per simulated second, written off-thread
+    std::unique_ptr<IO::MetricsWriter> metrics;
+    double nextMetricsSample = 0.0;
+    
+    // Background loading; the map is handed over on the main thread once done
+    std::unique_ptr<LoadingPipeline> loading;
+    std::string loadingMapPath;
+    bool loadingHandedOver = true;
+    int loadingPercentShown = -1;
+    
+    // Last configuration snapshot applied at a step boundary
+    IO::ConfigSnapshot appliedConfig;
+    uint64_t appliedConfigVersion = 0;
+    
+    // Tunables read every frame or tick, bound once to the shared loader
+    IO::ConfigKey<double> timeStep;
+    IO::ConfigKey<bool> enableStatistics;
+    double appliedTimeStep = 0.0;
     
     // Application state
     bool initialized = false;
@@ -38,7 +127,15 @@ struct Application::Impl {
     
     // Timing
     unsigned int targetFPS = 60;
+    bool verticalSync = false;
     std::chrono::high_resolution_clock::time_point lastFrameTime;
+    FramePacer framePacer;
+    LatencyHistogram frameIntervals;
+    
+    // Allocation accounting
+    std::array<MemoryTracker::Counters, MemoryTracker::TagCount> frameStartAllocations{};
+    size_t simulationAllocationBudget = 0;
+    size_t budgetExceededSinceReport = 0;
     
     // Statistics
     Statistics stats;
@@ -62,40 +159,61 @@ bool Application::initialize(const std::string& configPath) {
         return true;
     }
     
-    (void)configPath; // Suppress unused parameter warning - TODO: Use for config loading
-    
     std::cout << "[Runtime] Initializing application..." << std::endl;
     
     try {
         // Initialize subsystems in dependency order
         
         // 1. Configuration loader
-        m_impl->configLoader = std::make_unique<IO::ConfigLoader>();
-        m_impl->configLoader->initialize();
+        {
+            MemoryScope memoryScope(MemoryTag::IO);
+            m_impl->configLoader = std::make_unique<IO::ConfigLoader>();
+            m_impl->configLoader->initialize();
+            
+            if (!m_impl->configLoader->loadConfig(configPath)) {
+                std::cerr << "[Runtime] Failed to load config: " << configPath << ", using defaults" << std::endl;
+            }
+            
+            const IO::ConfigLoader::SimulationConfig defaults;
+            m_impl->timeStep = m_impl->configLoader->bind("simulation", "timeStep", defaults.timeStep);
+            m_impl->enableStatistics = m_impl->configLoader->bind("simulation", "enableStatistics", defaults.enableStatistics);
+            
+            // Edits to the file are reparsed off the main thread and applied at step boundaries
+            m_impl->configWatcher = std::make_unique<IO::ConfigWatcher>();
+            m_impl->configWatcher->start(configPath, *m_impl->configLoader);
+        }
         
-        // TODO: Load configuration from file
-        // if (!m_impl->configLoader->loadConfig(configPath)) {
-        //     std::cerr << "[Runtime] Failed to load config: " << configPath << std::endl;
-        // }
+        const IO::ConfigLoader::WindowConfig windowConfig = m_impl->configLoader->getWindowConfig();
+        m_impl->targetFPS = static_cast<unsigned int>(std::max(0, windowConfig.maxFPS));
         
         // 2. Thread manager
         m_impl->threadManager = std::make_unique<ThreadManager>();
         m_impl->threadManager->initialize();
+        m_impl->autoSaver = std::make_unique<AutoSaver>(*m_impl->threadManager);
         
         // 3. Window and renderer
         m_impl->window = std::make_unique<Render::Window>();
-        if (!m_impl->window->create(1200, 800, "RoadSim - Traffic Simulation")) {
+        const auto windowWidth = static_cast<unsigned int>(windowConfig.width);
+        const auto windowHeight = static_cast<unsigned int>(windowConfig.height);
+        if (!m_impl->window->create(windowWidth, windowHeight, windowConfig.title, windowConfig.fullscreen)) {
             std::cerr << "[Runtime] Failed to create window" << std::endl;
             return false;
         }
         
+        // Only one limiter runs: vsync when configured, the frame pacer otherwise
+        m_impl->window->setFramerateLimit(0);
+        setVerticalSyncEnabled(windowConfig.vsync);
+        
         m_impl->renderer = std::make_unique<Render::Renderer>();
         m_impl->renderer->initialize(m_impl->window->getRenderWindow());
+        m_impl->renderer->setParallelFor([threads = m_impl->threadManager.get()](size_t count, const std::function<void(size_t, size_t)>& body) {
+            parallelFor(*threads, count, body);
+        });
         
         // 4. UI Manager
         m_impl->uiManager = std::make_unique<Render::UIManager>();
         m_impl->uiManager->initialize(m_impl->window->getRenderWindow());
-        m_impl->uiManager->setWindowSize(1200, 800);
+        m_impl->uiManager->setWindowSize(windowWidth, windowHeight);
         
         // 5. Scene management
         m_impl->scene = std::make_unique<Core::Scene>();
@@ -103,10 +221,32 @@ bool Application::initialize(const std::string& configPath) {
         // 6. Core simulation components
         m_impl->simulator = std::make_unique<Core::Simulator>();
         m_impl->simulator->initialize();
+        m_impl->simulator->setStateHashSource([this](Core::StateHasher& hasher, Core::Simulator::NumericMode mode) {
+            m_impl->scene->hashState(hasher, mode == Core::Simulator::NumericMode::FixedPoint);
+        });
         
         m_impl->scheduler = std::make_unique<Core::Scheduler>();
         m_impl->scheduler->initialize();
         
+        // Agent behaviours advance once per simulation tick
+        m_impl->behaviours = std::make_unique<BehaviourExecutor>();
+        m_impl->simulator->setTickCallback([this](uint64_t, double time) {
+            if (m_impl->behaviours) {
+                m_impl->behaviours->tick(time);
+            }
+            if (m_impl->metrics && *m_impl->enableStatistics && time >= m_impl->nextMetricsSample) {
+                // Agents do not follow roads yet, so only the vehicle count is measured;
+                // throughput, waits, speed and occupancy stay empty
+                IO::MetricRecord record;
+                record.time = time;
+                m_impl->scene->forEachGameObject([&record](const Core::GameObject& gameObject) {
+                    if (gameObject.isActive()) record.vehicles++;
+                });
+                m_impl->metrics->push(record);
+                m_impl->nextMetricsSample = time + 1.0;
+            }
+        });
+        
         // 5. Editor components
         m_impl->mapEditor = std::make_unique<Editor::MapEditor>();
         m_impl->mapEditor->initialize();
@@ -139,6 +279,8 @@ bool Application::initialize(const std::string& configPath) {
             // - Camera controls
         });
         
+        applyConfigUpdates();
+        
         m_impl->initialized = true;
         m_impl->lastFrameTime = std::chrono::high_resolution_clock::now();
         m_impl->statsStartTime = m_impl->lastFrameTime;
@@ -160,14 +302,18 @@ int Application::run() {
     
     std::cout << "[Runtime] Starting main loop..." << std::endl;
     m_impl->running = true;
+    ROADSIM_TRACE_THREAD_NAME("Main");
     
     while (m_impl->running && m_impl->window->isOpen() && !m_impl->exitRequested) {
+        ROADSIM_TRACE_SCOPE("Runtime", "Frame");
         auto frameStart = std::chrono::high_resolution_clock::now();
         
         // Calculate delta time
         auto deltaTime = std::chrono::duration<double>(frameStart - m_impl->lastFrameTime).count();
         m_impl->lastFrameTime = frameStart;
         
+        updateLoading();
+        
         // Handle events
         handleEvents();
         
@@ -190,18 +336,17 @@ int Application::run() {
         updateStatistics(frameTime);
         m_impl->stats.updateTime = updateTime;
         m_impl->stats.renderTime = renderTime;
+        m_impl->frameIntervals.record(static_cast<uint64_t>(deltaTime * 1e9));
         
         // Frame rate limiting
-        if (m_impl->targetFPS > 0) {
-            double targetFrameTime = 1.0 / m_impl->targetFPS;
-            if (frameTime < targetFrameTime) {
-                auto sleepTime = std::chrono::duration<double>(targetFrameTime - frameTime);
-                std::this_thread::sleep_for(sleepTime);
-            }
+        {
+            ROADSIM_TRACE_SCOPE("Runtime", "FramePacing");
+            m_impl->framePacer.waitForNextFrame();
         }
     }
     
     std::cout << "[Runtime] Main loop ended" << std::endl;
+    std::cout << "[Runtime] Run summary:\n" << buildPerformanceReport() << std::flush;
     return 0;
 }
 
@@ -213,11 +358,25 @@ void Application::shutdown() {
     m_impl->running = false;
     
     // Shutdown subsystems in reverse order
+    if (m_impl->configWatcher) {
+        m_impl->configWatcher->stop();
+    }
+    
+    // Loading tasks run on the thread manager; let them drain first
+    m_impl->loading.reset();
+    m_impl->autoSaver.reset();
+    
+    if (m_impl->metrics) {
+        m_impl->metrics->close();
+    }
+    
     if (m_impl->threadManager) {
         m_impl->threadManager->shutdown();
     }
     
     // Reset all subsystems
+    m_impl->behaviours.reset();
+    m_impl->metrics.reset();
     m_impl->entityEditor.reset();
     m_impl->mapEditor.reset();
     m_impl->scheduler.reset();
@@ -225,6 +384,7 @@ void Application::shutdown() {
     m_impl->renderer.reset();
     m_impl->window.reset();
     m_impl->threadManager.reset();
+    m_impl->configWatcher.reset();
     m_impl->configLoader.reset();
     
     m_impl->initialized = false;
@@ -244,6 +404,19 @@ void Application::switchToSimulationMode() {
     std::cout << "[Runtime] Switching to simulation mode" << std::endl;
     m_impl->currentMode = Mode::Simulation;
     
+    // Metrics go to <outputDirectory>/metrics.csv for the whole session
+    if (!m_impl->metrics && m_impl->configLoader) {
+        const std::filesystem::path directory = m_impl->configLoader->getIOConfig().outputDirectory;
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        
+        auto metrics = std::make_unique<IO::MetricsWriter>();
+        if (metrics->open((directory / "metrics.csv").string())) {
+            m_impl->metrics = std::move(metrics);
+            m_impl->nextMetricsSample = 0.0;
+        }
+    }
+    
     if (m_impl->simulator) {
         m_impl->simulator->start();
     }
@@ -264,6 +437,7 @@ Application::Mode Application::getCurrentMode() const {
 
 bool Application::loadMap(const std::string& mapPath) {
     std::cout << "[Runtime] Loading map: " << mapPath << std::endl;
+    MemoryScope memoryScope(MemoryTag::IO);
     
     if (m_impl->mapEditor) {
         return m_impl->mapEditor->loadMap(mapPath);
@@ -274,6 +448,7 @@ bool Application::loadMap(const std::string& mapPath) {
 
 bool Application::saveMap(const std::string& mapPath) {
     std::cout << "[Runtime] Saving map: " << mapPath << std::endl;
+    MemoryScope memoryScope(MemoryTag::IO);
     
     if (m_impl->mapEditor) {
         return m_impl->mapEditor->saveMap(mapPath);
@@ -290,17 +465,96 @@ void Application::createNewMap() {
     }
 }
 
+bool Application::startLoading(const std::string& mapPath, const std::string& profilesPath, const std::string& scenarioPath) {
+    if (!m_impl->threadManager) {
+        std::cerr << "[Runtime] Cannot load before initialization" << std::endl;
+        return false;
+    }
+    
+    if (!m_impl->loading) {
+        m_impl->loading = std::make_unique<LoadingPipeline>(*m_impl->threadManager);
+    }
+    
+    LoadingPipeline::Request request;
+    request.mapPath = mapPath;
+    request.profilesPath = profilesPath;
+    request.scenarioPath = scenarioPath;
+    if (!m_impl->loading->start(request)) {
+        return false;
+    }
+    
+    m_impl->loadingMapPath = mapPath;
+    m_impl->loadingHandedOver = false;
+    m_impl->loadingPercentShown = -1;
+    return true;
+}
+
+LoadingPipeline::Progress Application::getLoadingProgress() const {
+    if (!m_impl->loading) {
+        LoadingPipeline::Progress idle;
+        idle.finished = true;
+        idle.succeeded = true;
+        return idle;
+    }
+    return m_impl->loading->getProgress();
+}
+
+void Application::updateLoading() {
+    if (!m_impl->loading || m_impl->loadingHandedOver) return;
+    
+    const LoadingPipeline::Progress progress = m_impl->loading->getProgress();
+    if (!progress.finished) {
+        // Report progress in the title; only touch the window when the percentage moves
+        const int percent = static_cast<int>(progress.getFraction() * 100.0);
+        if (percent != m_impl->loadingPercentShown && m_impl->window) {
+            m_impl->loadingPercentShown = percent;
+            m_impl->window->setTitle(m_impl->appliedConfig.window.title + " - Loading " + std::to_string(percent) + "%");
+        }
+        return;
+    }
+    
+    m_impl->loadingHandedOver = true;
+    if (m_impl->window) {
+        m_impl->window->setTitle(m_impl->appliedConfig.window.title);
+    }
+    
+    for (const std::string& error : m_impl->loading->getErrors()) {
+        std::cerr << "[Runtime] " << error << std::endl;
+    }
+    
+    Core::MapData map;
+    if (m_impl->mapEditor && m_impl->loading->takeMap(map)) {
+        MemoryScope memoryScope(MemoryTag::IO);
+        m_impl->mapEditor->setMapData(std::move(map), m_impl->loadingMapPath);
+    }
+    
+    std::cout << "[Runtime] Loaded " << progress.bytesTotal / 1024 << " KB in " << progress.elapsedSeconds * 1000.0
+              << " ms (" << progress.tasksCompleted << " tasks)" << std::endl;
+}
+
 Application::Statistics Application::getStatistics() const {
-    return m_impl->stats;
+    Statistics stats = m_impl->stats;
+    auto pacing = m_impl->framePacer.getStatistics();
+    stats.frameTimes = m_impl->frameIntervals.snapshot().summarize();
+    stats.missedFrames = pacing.missedDeadlines;
+    stats.sleepEstimate = pacing.sleepEstimate;
+    return stats;
 }
 
 void Application::setTargetFPS(unsigned int fps) {
     m_impl->targetFPS = fps;
+    m_impl->framePacer.setTargetFPS(m_impl->verticalSync ? 0 : fps);
+    m_impl->frameIntervals.reset();
     std::cout << "[Runtime] Target FPS set to " << fps << std::endl;
-    
+}
+
+void Application::setVerticalSyncEnabled(bool enabled) {
+    m_impl->verticalSync = enabled;
     if (m_impl->window) {
-        m_impl->window->setFramerateLimit(fps);
+        m_impl->window->setVerticalSyncEnabled(enabled);
     }
+    m_impl->framePacer.setTargetFPS(enabled ? 0 : m_impl->targetFPS);
+    m_impl->frameIntervals.reset();
 }
 
 void Application::setDebugMode(bool enabled) {
@@ -321,8 +575,12 @@ Render::Renderer* Application::getRenderer() { return m_impl->renderer.get(); }
 Render::UIManager* Application::getUIManager() { return m_impl->uiManager.get(); }
 Core::Scene* Application::getScene() { return m_impl->scene.get(); }
 ThreadManager* Application::getThreadManager() { return m_impl->threadManager.get(); }
+BehaviourExecutor* Application::getBehaviourExecutor() { return m_impl->behaviours.get(); }
+IO::MetricsWriter* Application::getMetricsWriter() { return m_impl->metrics.get(); }
 
 void Application::update(double deltaTime) {
+    ROADSIM_TRACE_SCOPE("Runtime", "Update");
+    
     // Update UI Manager
     if (m_impl->uiManager) {
         m_impl->uiManager->update(static_cast<float>(deltaTime));
@@ -348,9 +606,13 @@ void Application::update(double deltaTime) {
         m_impl->scheduler->processScheduledTasks();
     }
     
+    // Step boundary: pick up a reloaded configuration before the scene and simulator advance
+    applyConfigUpdates();
+    
     // Update scene
     if (m_impl->scene) {
         if (m_impl->currentMode == Mode::Simulation) {
+            MemoryScope memoryScope(MemoryTag::Scene);
             m_impl->scene->update(static_cast<float>(deltaTime));
             m_impl->scene->fixedUpdate(static_cast<float>(deltaTime));
         }
@@ -358,6 +620,12 @@ void Application::update(double deltaTime) {
     
     // Update simulation if running
     if (m_impl->currentMode == Mode::Simulation && m_impl->simulator) {
+        MemoryScope memoryScope(MemoryTag::Simulator);
+        const double timeStep = *m_impl->timeStep;
+        if (timeStep != m_impl->appliedTimeStep) {
+            m_impl->simulator->setFixedTimeStep(timeStep);
+            m_impl->appliedTimeStep = timeStep;
+        }
         m_impl->simulator->step(static_cast<float>(deltaTime));
     }
     
@@ -370,16 +638,82 @@ void Application::update(double deltaTime) {
             m_impl->entityEditor->update(deltaTime);
         }
     }
+    
+    // Only snapshots the map here; the file is written on a worker
+    if (m_impl->autoSaver && m_impl->mapEditor) {
+        m_impl->autoSaver->update(*m_impl->mapEditor);
+    }
+}
+
+void Application::applyConfigUpdates() {
+    if (!m_impl->configWatcher) return;
+    
+    // Lock-free: one atomic load, and a store releasing the previous snapshot
+    const IO::ConfigSnapshot* config = m_impl->configWatcher->acquire();
+    if (!config || config->version == m_impl->appliedConfigVersion) return;
+    
+    ROADSIM_TRACE_SCOPE("Runtime", "ApplyConfig");
+    const bool initial = m_impl->appliedConfigVersion == 0;
+    const IO::ConfigSnapshot& previous = m_impl->appliedConfig;
+    
+    // The window was created from the initial values; only changes need applying
+    if (!initial) {
+        if (m_impl->window && config->window.title != previous.window.title) {
+            m_impl->window->setTitle(config->window.title);
+        }
+        if (config->window.maxFPS != previous.window.maxFPS) {
+            setTargetFPS(static_cast<unsigned int>(std::max(0, config->window.maxFPS)));
+        }
+        if (config->window.vsync != previous.window.vsync) {
+            setVerticalSyncEnabled(config->window.vsync);
+        }
+        if (config->render.enableDebugRendering != previous.render.enableDebugRendering) {
+            setDebugMode(config->render.enableDebugRendering);
+        }
+    }
+    
+    const IO::ConfigLoader::IOConfig& io = config->io;
+    const IO::ConfigLoader::IOConfig& previousIO = previous.io;
+    const bool autoSaveChanged = initial
+        || io.enableAutoSave != previousIO.enableAutoSave || io.autoSaveInterval != previousIO.autoSaveInterval
+        || io.enableBackups != previousIO.enableBackups || io.maxBackups != previousIO.maxBackups
+        || io.outputDirectory != previousIO.outputDirectory;
+    if (m_impl->autoSaver && autoSaveChanged) {
+        AutoSaver::Settings autoSave;
+        autoSave.enabled = io.enableAutoSave && io.autoSaveInterval > 0;
+        autoSave.intervalSeconds = io.autoSaveInterval;
+        autoSave.enableBackups = io.enableBackups;
+        autoSave.maxBackups = io.maxBackups;
+        autoSave.directory = (std::filesystem::path(io.outputDirectory) / "autosave").string();
+        m_impl->autoSaver->configure(autoSave);
+    }
+    
+    // Mirror the whole file into the shared loader so every bound ConfigKey sees the new values
+    if (m_impl->configLoader) {
+        m_impl->configLoader->setValues(config->values);
+    }
+    
+    m_impl->appliedConfig = *config;
+    m_impl->appliedConfigVersion = config->version;
+    std::cout << "[Runtime] Applied config version " << config->version << std::endl;
 }
 
 void Application::render() {
     if (!m_impl->renderer || !m_impl->window) return;
     
+    ROADSIM_TRACE_SCOPE("Render", "Render");
+    MemoryScope memoryScope(MemoryTag::Renderer);
+    
     m_impl->window->clear(sf::Color(45, 45, 45));
     
     m_impl->renderer->beginFrame();
     m_impl->renderer->clear();
     
+    // Road geometry is only re-tessellated when the map has changed
+    if (m_impl->mapEditor) {
+        m_impl->renderer->setMap(m_impl->mapEditor->getMapData(), m_impl->mapEditor->getRevision());
+    }
+    
     // Render based on current mode
     switch (m_impl->currentMode) {
         case Mode::Editor:
@@ -388,9 +722,10 @@ void Application::render() {
             m_impl->renderer->renderTrafficLights();
             m_impl->renderer->renderEditorUI();
             break;
-            
+        
         case Mode::Simulation:
         case Mode::Paused:
+            collectAgents();
             m_impl->renderer->renderRoads();
             m_impl->renderer->renderEntities();
             m_impl->renderer->renderTrafficLights();
@@ -414,11 +749,35 @@ void Application::render() {
 }
 
 void Application::handleEvents() {
+    ROADSIM_TRACE_SCOPE("Runtime", "Events");
+    
     if (m_impl->window) {
         m_impl->window->pollEvents();
     }
 }
 
+void Application::collectAgents() {
+    ROADSIM_TRACE_SCOPE("Render", "CollectAgents");
+    
+    std::vector<Render::AgentInstance>& agents = m_impl->agentSnapshot;
+    agents.clear();
+    if (m_impl->scene) {
+        agents.reserve(m_impl->scene->getGameObjectCount());
+        
+        // Every GameObject is drawn as a vehicle until agents carry their kind
+        m_impl->scene->forEachGameObject([&agents](const Core::GameObject& gameObject) {
+            if (!gameObject.isActive()) return;
+            
+            Render::AgentInstance agent;
+            agent.position = gameObject.getPosition();
+            agent.direction = gameObject.getTransform()->getForward();
+            agent.kind = Render::AgentKind::Vehicle;
+            agents.push_back(agent);
+        });
+    }
+    m_impl->renderer->setEntities(agents);
+}
+
 void Application::updateStatistics(double frameTime) {
     m_impl->frameCounter++;
     m_impl->totalFrameTime += frameTime;
@@ -435,10 +794,107 @@ void Application::updateStatistics(double frameTime) {
         m_impl->frameCounter = 0;
         m_impl->totalFrameTime = 0.0;
         m_impl->statsStartTime = now;
+        
+        auto processMemory = MemoryTracker::getProcessMemory();
+        m_impl->stats.memoryUsage = processMemory.residentBytes;
+        m_impl->stats.peakMemoryUsage = processMemory.peakResidentBytes;
+        
+        if (m_impl->debugMode && m_impl->renderer) {
+            m_impl->renderer->setMetricsText(buildPerformanceReport());
+        }
+        
+        if (m_impl->budgetExceededSinceReport > 0) {
+            std::cerr << "[Runtime] Simulation allocation budget (" << m_impl->simulationAllocationBudget
+                      << " per frame) exceeded in " << m_impl->budgetExceededSinceReport << " frame(s)" << std::endl;
+            m_impl->budgetExceededSinceReport = 0;
+        }
+    }
+    
+    // Allocations since the previous frame, per subsystem
+    m_impl->stats.allocationsPerFrame = 0;
+    m_impl->stats.allocatedBytesPerFrame = 0;
+    for (size_t i = 0; i < MemoryTracker::TagCount; ++i) {
+        auto current = MemoryTracker::getCounters(static_cast<MemoryTag>(i));
+        auto frame = current - m_impl->frameStartAllocations[i];
+        m_impl->stats.subsystemAllocationsPerFrame[i] = frame;
+        m_impl->stats.allocationsPerFrame += frame.allocations;
+        m_impl->stats.allocatedBytesPerFrame += frame.bytes;
+        m_impl->frameStartAllocations[i] = current;
     }
     
-    // TODO: Calculate memory usage
-    // m_impl->stats.memoryUsage = getCurrentMemoryUsage();
+    if (m_impl->simulationAllocationBudget > 0 && m_impl->currentMode == Mode::Simulation) {
+        const auto& perTag = m_impl->stats.subsystemAllocationsPerFrame;
+        uint64_t simulationAllocations = perTag[static_cast<size_t>(MemoryTag::Scene)].allocations +
+                                         perTag[static_cast<size_t>(MemoryTag::Simulator)].allocations;
+        if (simulationAllocations > m_impl->simulationAllocationBudget) {
+            m_impl->stats.allocationBudgetExceededFrames++;
+            m_impl->budgetExceededSinceReport++;
+        }
+    }
+}
+
+void Application::setHardwareCountersEnabled(bool enabled) {
+    if (m_impl->simulator) {
+        m_impl->simulator->setHardwareCountersEnabled(enabled);
+    }
+    if (m_impl->threadManager) {
+        m_impl->threadManager->setHardwareCountersEnabled(enabled);
+    }
+}
+
+std::string Application::buildPerformanceReport() const {
+    Statistics stats = getStatistics();
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(2);
+    
+    report << "FPS " << stats.averageFPS
+           << "  frame p50 " << stats.frameTimes.p50 * 1000.0 << " ms"
+           << "  p99 " << stats.frameTimes.p99 * 1000.0 << " ms"
+           << "  missed " << stats.missedFrames << "\n";
+    report << "RSS " << stats.memoryUsage / (1024 * 1024) << " MB (peak " << stats.peakMemoryUsage / (1024 * 1024) << " MB)"
+           << "  allocations/frame " << stats.allocationsPerFrame << "\n";
+    
+    auto appendCounters = [&report](const Core::PerfSample& sample) {
+        report << "IPC " << sample.instructionsPerCycle()
+               << "  cache MPKI " << sample.cacheMissesPerKiloInstruction()
+               << "  branch MPKI " << sample.branchMissesPerKiloInstruction();
+    };
+    
+    if (m_impl->simulator) {
+        for (const auto& phase : m_impl->simulator->getPhaseCounters()) {
+            if (phase.calls == 0) continue;
+            report << "  " << std::left << std::setw(11) << phase.name << std::right << phase.calls << " calls  ";
+            appendCounters(phase.counters);
+            report << "\n";
+        }
+    }
+    
+    if (m_impl->threadManager) {
+        auto threadStats = m_impl->threadManager->getStatistics();
+        for (size_t i = 0; i < threadStats.workers.size(); ++i) {
+            const auto& worker = threadStats.workers[i];
+            if (!worker.hardwareCountersAvailable) continue;
+            report << "  Worker " << i << "   " << worker.tasksExecuted << " tasks  ";
+            appendCounters(worker.hardware);
+            report << "\n";
+        }
+    }
+    
+    return report.str();
+}
+
+bool Application::exportTrace(const std::string& filePath) const {
+    if (!Core::Trace::isCompiledIn()) {
+        std::cerr << "[Runtime] Tracing is disabled in this build (configure with -DROADSIM_TRACING=ON)" << std::endl;
+        return false;
+    }
+    
+    return Core::Trace::exportChromeTrace(filePath);
+}
+
+void Application::setSimulationAllocationBudget(size_t allocationsPerFrame) {
+    m_impl->simulationAllocationBudget = allocationsPerFrame;
+    std::cout << "[Runtime] Simulation allocation budget set to " << allocationsPerFrame << " per frame" << std::endl;
 }
 
 } // namespace RoadSim::Runtime
\ No newline at end of file
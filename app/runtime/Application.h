@@ -3,6 +3,10 @@
 #include <memory>
 #include <string>
 #include <functional>
+#include <array>
+#include "LatencyHistogram.h"
+#include "MemoryTracker.h"
+#include "LoadingPipeline.h"
 
 namespace RoadSim::Core {
     class Simulator;
@@ -26,10 +30,13 @@ namespace RoadSim::Core {
 
 namespace RoadSim::IO {
     class ConfigLoader;
+    class ConfigWatcher;
+    class MetricsWriter;
 }
 
 namespace RoadSim::Runtime {
     class ThreadManager;
+    class BehaviourExecutor;
 }
 
 namespace RoadSim::Runtime {
@@ -115,6 +122,22 @@ public:
      */
     void createNewMap();
     
+    /**
+     * @brief Load a map, entity profiles and a scenario in the background
+     * The files load concurrently on the thread manager while frames keep
+     * running; the map is handed to the map editor once all of them finish.
+     * @param mapPath Map file (JSON or .rsmap), empty to skip
+     * @param profilesPath Entity profiles JSON, empty to skip
+     * @param scenarioPath Scenario JSON, empty to skip
+     * @return False if a load is already running
+     */
+    bool startLoading(const std::string& mapPath, const std::string& profilesPath = "", const std::string& scenarioPath = "");
+    
+    /**
+     * @brief Progress of the load started by startLoading()
+     */
+    LoadingPipeline::Progress getLoadingProgress() const;
+    
     /**
      * @brief Get application statistics
      */
@@ -124,17 +147,64 @@ public:
         double renderTime = 0.0;
         size_t frameCount = 0;
         double averageFPS = 0.0;
-        size_t memoryUsage = 0;
+        size_t memoryUsage = 0;                 // Resident set size, refreshed every second
+        size_t peakMemoryUsage = 0;
+        
+        // Heap allocations made during the last frame
+        uint64_t allocationsPerFrame = 0;
+        uint64_t allocatedBytesPerFrame = 0;
+        std::array<MemoryTracker::Counters, MemoryTracker::TagCount> subsystemAllocationsPerFrame{}; // Indexed by MemoryTag
+        size_t allocationBudgetExceededFrames = 0;
+        
+        // Frame pacing
+        LatencyHistogram::Summary frameTimes;   // Frame-to-frame interval since the target was set
+        size_t missedFrames = 0;                // Frames more than one period late
+        double sleepEstimate = 0.0;             // Mean + one std. deviation of measured 1 ms sleeps (s)
     };
     
     Statistics getStatistics() const;
     
     /**
      * @brief Set frame rate limit
+     * The application paces frames itself; the window limiter stays disabled.
+     * Ignored while vertical sync paces the frames instead.
      * @param fps Target FPS (0 for unlimited)
      */
     void setTargetFPS(unsigned int fps);
     
+    /**
+     * @brief Let the display's vertical sync pace frames instead of the frame pacer
+     * Exactly one limiter is active: enabling vsync turns the pacer off.
+     * @param enabled VSync state
+     */
+    void setVerticalSyncEnabled(bool enabled);
+    
+    /**
+     * @brief Count hardware events per simulation phase and per worker
+     * Linux only (perf_event_open); reported in the debug overlay and run summary
+     * @param enabled Counter state
+     */
+    void setHardwareCountersEnabled(bool enabled);
+    
+    /**
+     * @brief Build a text report of frame timing, memory and hardware counters
+     * Shown by the debug metrics overlay and printed when the main loop ends
+     */
+    std::string buildPerformanceReport() const;
+    
+    /**
+     * @brief Write recorded trace spans as Chrome trace JSON (chrome://tracing, Perfetto)
+     * @param filePath Output path
+     * @return False if tracing is compiled out or the file cannot be written
+     */
+    bool exportTrace(const std::string& filePath) const;
+    
+    /**
+     * @brief Warn when the simulation loop (Scene + Simulator) allocates more per frame
+     * @param allocationsPerFrame Allowed allocations per frame (0 disables the check)
+     */
+    void setSimulationAllocationBudget(size_t allocationsPerFrame);
+    
     /**
      * @brief Enable/disable debug mode
      * @param enabled Debug mode state
@@ -152,6 +222,8 @@ public:
     Render::UIManager* getUIManager();
     Core::Scene* getScene();
     ThreadManager* getThreadManager();
+    BehaviourExecutor* getBehaviourExecutor();
+    IO::MetricsWriter* getMetricsWriter();
     
 private:
     struct Impl;
@@ -162,6 +234,9 @@ private:
     void render();
     void handleEvents();
     void updateStatistics(double frameTime);
+    void applyConfigUpdates();
+    void updateLoading();
+    void collectAgents();
 };
 
 } // namespace RoadSim::Runtime
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "AutoSaver.h"
+#include "ThreadManager.h"
+#include "../core/MapData.h"
+#include "../core/Trace.h"
+#include "../editor/MapEditor.h"
+#include "../io/MapBinary.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+
+namespace RoadSim::Runtime {
+
+namespace {
+
+// File name stem for the map being edited
+std::string autosaveStem(const Editor::MapEditor& editor) {
+    const std::string& mapFile = editor.getCurrentMapFile();
+    if (!mapFile.empty()) return std::filesystem::path(mapFile).stem().string();
+    
+    std::string name = editor.getMapData().name;
+    std::replace_if(name.begin(), name.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); }, '_');
+    return name.empty() ? std::string("untitled") : name;
+}
+
+std::filesystem::path slotPath(const std::filesystem::path& directory, const std::string& stem, int slot) {
+    return directory / (stem + ".autosave." + std::to_string(slot) + ".rsmap");
+}
+
+} // namespace
+
+struct AutoSaver::Impl {
+    using Clock = std::chrono::steady_clock;
+    
+    ThreadManager& threads;
+    Settings settings;
+    
+    // Main thread state
+    Clock::time_point lastSaveTime = Clock::now();
+    uint64_t savedRevision = 0;
+    bool savedAny = false;
+    
+    // Shared with the worker
+    std::atomic<bool> saving{false};
+    mutable std::mutex mutex;
+    std::condition_variable done;
+    Statistics stats;
+    std::string lastError;
+    bool lastSucceeded = true;
+    
+    explicit Impl(ThreadManager& threadManager) : threads(threadManager) {}
+    
+    int slotCount() const {
+        return settings.enableBackups ? std::max(1, settings.maxBackups) : 1;
+    }
+    
+    // Worker: shift the older files up one slot, then write the newest into slot 1
+    void write(std::shared_ptr<const Core::MapData> map, std::filesystem::path directory, std::string stem, int slots) {
+        ROADSIM_TRACE_SCOPE("Runtime", "AutoSaver::write");
+        const auto start = Clock::now();
+        
+        std::string error;
+        std::error_code fileError;
+        std::filesystem::create_directories(directory, fileError);
+        if (fileError) {
+            error = "Cannot create " + directory.string() + ": " + fileError.message();
+        }
+        
+        // Each rename replaces its target atomically; the oldest file falls off the end
+        for (int slot = slots - 1; slot >= 1 && error.empty(); --slot) {
+            const auto from = slotPath(directory, stem, slot);
+            if (!std::filesystem::exists(from, fileError)) continue;
+            std::filesystem::rename(from, slotPath(directory, stem, slot + 1), fileError);
+            if (fileError) {
+                error = "Cannot rotate " + from.string() + ": " + fileError.message();
+            }
+        }
+        
+        const std::string target = slotPath(directory, stem, 1).string();
+        if (error.empty()) {
+            IO::MapBinary::write(target, *map, error);
+        }
+        
+        // Drop the snapshot here rather than on the main thread
+        map.reset();
+        const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        
+        if (error.empty()) {
+            std::cout << "[Runtime] Autosaved " << target << " in " << milliseconds << " ms" << std::endl;
+        } else {
+            std::cerr << "[Runtime] Autosave failed: " << error << std::endl;
+        }
+        
+        // Notify under the lock: a waiter may destroy the saver as soon as it is released
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.lastWriteMilliseconds = milliseconds;
+        if (error.empty()) {
+            stats.savesCompleted++;
+            stats.lastFile = target;
+        } else {
+            stats.savesFailed++;
+            lastError = error;
+        }
+        lastSucceeded = error.empty();
+        saving = false;
+        done.notify_all();
+    }
+    
+    bool start(const Editor::MapEditor& editor) {
+        if (saving) {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.savesSkipped++;
+            return false;
+        }
+        
+        ROADSIM_TRACE_SCOPE("Runtime", "AutoSaver::snapshot");
+        const auto start = Clock::now();
+        
+        std::shared_ptr<const Core::MapData> map = editor.snapshot();
+        std::filesystem::path directory = settings.directory;
+        std::string stem = autosaveStem(editor);
+        const int slots = slotCount();
+        
+        lastSaveTime = start;
+        saving = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.lastSnapshotMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+        
+        auto task = [this, map = std::move(map), directory = std::move(directory), stem = std::move(stem), slots]() mutable {
+            write(std::move(map), std::move(directory), std::move(stem), slots);
+        };
+        
+        // Run on a worker, or inline when the thread manager has none
+        if (threads.getWorkerThreadCount() == 0) {
+            task();
+        } else if (threads.submitTask(std::move(task)) == 0) {
+            // Refused (the pool is shutting down): the task will never clear the flag
+            std::lock_guard<std::mutex> lock(mutex);
+            stats.savesFailed++;
+            lastError = "Autosave could not be queued";
+            lastSucceeded = false;
+            saving = false;
+            done.notify_all();
+            return false;
+        }
+        
+        savedRevision = editor.getRevision();
+        savedAny = true;
+        return true;
+    }
+};
+
+AutoSaver::AutoSaver(ThreadManager& threadManager)
+    : m_impl(std::make_unique<Impl>(threadManager)) {}
+
+AutoSaver::~AutoSaver() {
+    wait();
+}
+
+void AutoSaver::configure(const Settings& settings) {
+    m_impl->settings = settings;
+    m_impl->lastSaveTime = Impl::Clock::now();
+    
+    if (settings.enabled) {
+        std::cout << "[Runtime] Autosave every " << settings.intervalSeconds << " s to " << settings.directory
+                  << " (" << m_impl->slotCount() << " files)" << std::endl;
+    }
+}
+
+const AutoSaver::Settings& AutoSaver::getSettings() const {
+    return m_impl->settings;
+}
+
+void AutoSaver::update(const Editor::MapEditor& editor) {
+    Impl& impl = *m_impl;
+    if (!impl.settings.enabled) return;
+    
+    const double elapsed = std::chrono::duration<double>(Impl::Clock::now() - impl.lastSaveTime).count();
+    if (elapsed < impl.settings.intervalSeconds || impl.saving) return;
+    
+    // Nothing to do for an unmodified map, or one already autosaved at this revision
+    if (!editor.hasUnsavedChanges() || (impl.savedAny && editor.getRevision() == impl.savedRevision)) {
+        impl.lastSaveTime = Impl::Clock::now();
+        return;
+    }
+    
+    impl.start(editor);
+}
+
+bool AutoSaver::saveNow(const Editor::MapEditor& editor) {
+    return m_impl->start(editor);
+}
+
+bool AutoSaver::isSaving() const {
+    return m_impl->saving.load();
+}
+
+bool AutoSaver::wait() {
+    std::unique_lock<std::mutex> lock(m_impl->mutex);
+    m_impl->done.wait(lock, [this] { return !m_impl->saving.load(); });
+    return m_impl->lastSucceeded;
+}
+
+AutoSaver::Statistics AutoSaver::getStatistics() const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->stats;
+}
+
+std::string AutoSaver::getLastError() const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->lastError;
+}
+
+} // namespace RoadSim::Runtime
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace RoadSim::Editor {
+    class MapEditor;
+}
+
+namespace RoadSim::Runtime {
+
+class ThreadManager;
+
+/**
+ * @brief Periodically saves the edited map in the background (IOConfig autosave settings)
+ * On the main thread, a save only takes a copy-on-write snapshot of the
+ * MapEditor tables, which costs a reference count; the next edit then pays
+ * for one copy of the map (see MapEditor). A ThreadManager worker writes the
+ * snapshot as a binary .rsmap into a rotation of numbered files:
+ * <name>.autosave.1.rsmap is the newest. Older ones are shifted up with
+ * renames before each write. MapBinary::write syncs the new file before
+ * renaming it into place and syncs the directory afterwards, so after a
+ * crash slot 1 holds a complete autosave, either the new one or the
+ * previous one.
+ */
+class AutoSaver {
+public:
+    struct Settings {
+        bool enabled = true;
+        double intervalSeconds = 300.0;
+        bool enableBackups = true;          // Keep maxBackups files instead of one
+        int maxBackups = 5;
+        std::string directory = "output/autosave";
+    };
+    
+    struct Statistics {
+        uint64_t savesCompleted = 0;
+        uint64_t savesFailed = 0;
+        uint64_t savesSkipped = 0;          // saveNow() calls refused while a save was running
+        double lastSnapshotMilliseconds = 0.0;  // Main-thread cost of the last save
+        double lastWriteMilliseconds = 0.0;     // Worker time of the last save
+        std::string lastFile;
+    };
+    
+    explicit AutoSaver(ThreadManager& threadManager);
+    
+    /**
+     * @brief Waits for a save still being written
+     */
+    ~AutoSaver();
+    
+    // Non-copyable
+    AutoSaver(const AutoSaver&) = delete;
+    AutoSaver& operator=(const AutoSaver&) = delete;
+    
+    /**
+     * @brief Apply new settings; the interval restarts from now
+     */
+    void configure(const Settings& settings);
+    
+    const Settings& getSettings() const;
+    
+    /**
+     * @brief Start a save when the interval has elapsed and the map changed since the last one
+     * @param editor Editor to snapshot; main thread only
+     */
+    void update(const Editor::MapEditor& editor);
+    
+    /**
+     * @brief Start a save immediately, if none is running
+     * @return False if a save is already in progress or could not be queued
+     */
+    bool saveNow(const Editor::MapEditor& editor);
+    
+    bool isSaving() const;
+    
+    /**
+     * @brief Block until the running save (if any) has been written
+     * @return Whether it succeeded
+     */
+    bool wait();
+    
+    /**
+     * @brief Counters; safe to call from any thread
+     */
+    Statistics getStatistics() const;
+    
+    std::string getLastError() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::Runtime
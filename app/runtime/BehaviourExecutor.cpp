@@ -0,0 +1,217 @@
+#include "BehaviourExecutor.h"
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace RoadSim::Runtime {
+
+namespace {
+
+struct Timer {
+    double wakeTime;
+    uint64_t sequence; // Breaks ties so equal wake times resume in submission order
+    Behaviour::Handle handle;
+    
+    bool operator>(const Timer& other) const {
+        return wakeTime != other.wakeTime ? wakeTime > other.wakeTime : sequence > other.sequence;
+    }
+};
+
+} // namespace
+
+struct BehaviourExecutor::Impl {
+    // Simulation thread only
+    std::vector<Handle> tickWaiters;
+    std::vector<Handle> resumeBatch; // Reused every tick
+    std::vector<Timer> timers;       // Min-heap on wake time
+    uint64_t timerSequence = 0;
+    std::unordered_map<SignalId, std::vector<Handle>> signalWaiters;
+    size_t signalWaiterCount = 0;
+    std::vector<Handle> signalled;
+    
+    // Filled by ThreadManager workers; workerJobs is guarded by workerMutex too
+    mutable std::mutex workerMutex;
+    std::condition_variable workerIdle;
+    std::vector<Handle> workerCompleted;
+    size_t workerJobs = 0;
+    
+    double currentTime = 0.0;
+    uint64_t tickCount = 0;
+    size_t completedBehaviours = 0;
+    size_t failedBehaviours = 0;
+    
+    void waitForWorkers() {
+        std::unique_lock<std::mutex> lock(workerMutex);
+        workerIdle.wait(lock, [this] { return workerJobs == 0; });
+    }
+    
+    void finishWorkerJob() {
+        // Called with workerMutex held
+        if (--workerJobs == 0) workerIdle.notify_all();
+    }
+};
+
+BehaviourExecutor::BehaviourExecutor() : m_impl(std::make_unique<Impl>()) {
+    std::cout << "[Runtime] BehaviourExecutor created" << std::endl;
+}
+
+BehaviourExecutor::~BehaviourExecutor() {
+    clear();
+    std::cout << "[Runtime] BehaviourExecutor destroyed" << std::endl;
+}
+
+void BehaviourExecutor::spawn(Behaviour behaviour) {
+    Handle handle = behaviour.release();
+    if (!handle) return;
+    
+    handle.promise().executor = this;
+    resume(handle);
+}
+
+void BehaviourExecutor::tick(double simulationTime) {
+    m_impl->currentTime = simulationTime;
+    m_impl->tickCount++;
+    
+    auto& batch = m_impl->resumeBatch;
+    auto resumeBatch = [this, &batch]() {
+        for (Handle handle : batch) {
+            resume(handle);
+        }
+        batch.clear();
+    };
+    
+    // Behaviours that suspend again during this tick land in fresh lists
+    batch.swap(m_impl->tickWaiters);
+    resumeBatch();
+    
+    auto& timers = m_impl->timers;
+    while (!timers.empty() && timers.front().wakeTime <= simulationTime) {
+        std::pop_heap(timers.begin(), timers.end(), std::greater<Timer>());
+        batch.push_back(timers.back().handle);
+        timers.pop_back();
+    }
+    resumeBatch();
+    
+    batch.swap(m_impl->signalled);
+    resumeBatch();
+    
+    {
+        std::lock_guard<std::mutex> lock(m_impl->workerMutex);
+        batch.swap(m_impl->workerCompleted);
+    }
+    resumeBatch();
+}
+
+void BehaviourExecutor::raiseSignal(SignalId signalId) {
+    auto it = m_impl->signalWaiters.find(signalId);
+    if (it == m_impl->signalWaiters.end() || it->second.empty()) return;
+    
+    // Keep the per-signal vector so its capacity is reused
+    auto& waiters = it->second;
+    m_impl->signalled.insert(m_impl->signalled.end(), waiters.begin(), waiters.end());
+    m_impl->signalWaiterCount -= waiters.size();
+    waiters.clear();
+}
+
+void BehaviourExecutor::clear() {
+    m_impl->waitForWorkers();
+    
+    auto destroyAll = [](std::vector<Handle>& handles) {
+        for (Handle handle : handles) {
+            handle.destroy();
+        }
+        handles.clear();
+    };
+    
+    destroyAll(m_impl->tickWaiters);
+    destroyAll(m_impl->signalled);
+    destroyAll(m_impl->workerCompleted);
+    
+    for (auto& entry : m_impl->signalWaiters) {
+        destroyAll(entry.second);
+    }
+    m_impl->signalWaiters.clear();
+    m_impl->signalWaiterCount = 0;
+    
+    for (auto& timer : m_impl->timers) {
+        timer.handle.destroy();
+    }
+    m_impl->timers.clear();
+}
+
+BehaviourExecutor::Statistics BehaviourExecutor::getStatistics() const {
+    Statistics stats;
+    stats.waitingForTick = m_impl->tickWaiters.size();
+    stats.waitingForDelay = m_impl->timers.size();
+    stats.waitingForSignal = m_impl->signalWaiterCount + m_impl->signalled.size();
+    {
+        std::lock_guard<std::mutex> lock(m_impl->workerMutex);
+        stats.runningOnWorkers = m_impl->workerJobs;
+    }
+    stats.suspendedBehaviours = stats.waitingForTick + stats.waitingForDelay +
+                                stats.waitingForSignal + stats.runningOnWorkers;
+    stats.completedBehaviours = m_impl->completedBehaviours;
+    stats.failedBehaviours = m_impl->failedBehaviours;
+    stats.tickCount = m_impl->tickCount;
+    return stats;
+}
+
+double BehaviourExecutor::getCurrentTime() const {
+    return m_impl->currentTime;
+}
+
+void BehaviourExecutor::waitForTick(Handle handle) {
+    m_impl->tickWaiters.push_back(handle);
+}
+
+void BehaviourExecutor::waitForDelay(Handle handle, double seconds) {
+    m_impl->timers.push_back({m_impl->currentTime + seconds, m_impl->timerSequence++, handle});
+    std::push_heap(m_impl->timers.begin(), m_impl->timers.end(), std::greater<Timer>());
+}
+
+void BehaviourExecutor::waitForSignal(Handle handle, SignalId signalId) {
+    m_impl->signalWaiters[signalId].push_back(handle);
+    m_impl->signalWaiterCount++;
+}
+
+void BehaviourExecutor::beginWorkerJob() {
+    std::lock_guard<std::mutex> lock(m_impl->workerMutex);
+    m_impl->workerJobs++;
+}
+
+void BehaviourExecutor::cancelWorkerJob() {
+    std::lock_guard<std::mutex> lock(m_impl->workerMutex);
+    m_impl->finishWorkerJob();
+}
+
+void BehaviourExecutor::completeWorkerJob(Handle handle) {
+    std::lock_guard<std::mutex> lock(m_impl->workerMutex);
+    m_impl->workerCompleted.push_back(handle);
+    m_impl->finishWorkerJob();
+}
+
+void BehaviourExecutor::resume(Handle handle) {
+    handle.resume();
+    if (!handle.done()) return;
+    
+    if (auto exception = handle.promise().exception) {
+        m_impl->failedBehaviours++;
+        try {
+            std::rethrow_exception(exception);
+        } catch (const std::exception& e) {
+            std::cerr << "[Runtime] Behaviour threw exception: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "[Runtime] Behaviour threw unknown exception" << std::endl;
+        }
+    } else {
+        m_impl->completedBehaviours++;
+    }
+    
+    handle.destroy();
+}
+
+} // namespace RoadSim::Runtime
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "ThreadManager.h"
+#include "TaskStatePool.h"
+
+namespace RoadSim::Runtime {
+
+class BehaviourExecutor;
+
+using SignalId = int;
+
+/**
+ * @brief Coroutine type for sequential agent behaviours spanning many ticks
+ * A behaviour starts suspended and only runs once handed to
+ * BehaviourExecutor::spawn. Frames are allocated from TaskStatePool.
+ *
+ * Example:
+ *   Behaviour crossRoad(int lightId) {
+ *       co_await signal(lightId);
+ *       co_await simDelay(4.0);
+ *       co_await nextTick();
+ *   }
+ */
+class Behaviour {
+public:
+    struct promise_type {
+        BehaviourExecutor* executor = nullptr;
+        
+        Behaviour get_return_object() noexcept {
+            return Behaviour(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { exception = std::current_exception(); }
+        
+        static void* operator new(size_t size) { return TaskStatePool::allocate(size); }
+        static void operator delete(void* frame, size_t size) noexcept { TaskStatePool::deallocate(frame, size); }
+        
+        std::exception_ptr exception;
+    };
+    
+    using Handle = std::coroutine_handle<promise_type>;
+    
+    Behaviour() noexcept = default;
+    explicit Behaviour(Handle handle) noexcept : m_handle(handle) {}
+    
+    Behaviour(Behaviour&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    Behaviour& operator=(Behaviour&& other) noexcept {
+        if (this != &other) {
+            if (m_handle) m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+    
+    // Non-copyable
+    Behaviour(const Behaviour&) = delete;
+    Behaviour& operator=(const Behaviour&) = delete;
+    
+    ~Behaviour() {
+        if (m_handle) m_handle.destroy();
+    }
+    
+    /**
+     * @brief Release ownership of the coroutine frame
+     */
+    Handle release() noexcept { return std::exchange(m_handle, {}); }
+    
+private:
+    Handle m_handle;
+};
+
+/**
+ * @brief Runs behaviours on the simulation thread, one step per simulation tick
+ * Suspended behaviours are parked in intrusive wait lists (tick list, timer
+ * heap, per-signal lists), so they cost only their frame: no thread and no
+ * polling. Everything except work completion from ThreadManager workers must
+ * happen on the simulation thread.
+ */
+class BehaviourExecutor {
+public:
+    using Handle = Behaviour::Handle;
+    
+    BehaviourExecutor();
+    ~BehaviourExecutor();
+    
+    // Non-copyable
+    BehaviourExecutor(const BehaviourExecutor&) = delete;
+    BehaviourExecutor& operator=(const BehaviourExecutor&) = delete;
+    
+    /**
+     * @brief Start a behaviour; it runs until its first suspension point
+     * @param behaviour Behaviour to take ownership of
+     */
+    void spawn(Behaviour behaviour);
+    
+    /**
+     * @brief Resume every behaviour due at this simulation tick
+     * Order is deterministic: next-tick waiters, expired delays (by wake time,
+     * then submission order), raised signals, then completed worker jobs.
+     * @param simulationTime Simulation time of the tick in seconds
+     */
+    void tick(double simulationTime);
+    
+    /**
+     * @brief Wake every behaviour waiting on a signal (e.g. a light turning green)
+     * Waiters resume during the next call to tick()
+     * @param signalId Signal to raise
+     */
+    void raiseSignal(SignalId signalId);
+    
+    /**
+     * @brief Destroy every suspended behaviour
+     */
+    void clear();
+    
+    /**
+     * @brief Executor counters
+     */
+    struct Statistics {
+        size_t suspendedBehaviours = 0;
+        size_t waitingForTick = 0;
+        size_t waitingForDelay = 0;
+        size_t waitingForSignal = 0;
+        size_t runningOnWorkers = 0;
+        size_t completedBehaviours = 0;
+        size_t failedBehaviours = 0;    // Ended with an exception
+        uint64_t tickCount = 0;
+    };
+    
+    Statistics getStatistics() const;
+    
+    double getCurrentTime() const;
+    
+    // Used by the awaitables below
+    void waitForTick(Handle handle);
+    void waitForDelay(Handle handle, double seconds);
+    void waitForSignal(Handle handle, SignalId signalId);
+    void beginWorkerJob();
+    void cancelWorkerJob();
+    void completeWorkerJob(Handle handle);
+    
+private:
+    void resume(Handle handle);
+    
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/**
+ * @brief Suspend until the next simulation tick
+ */
+inline auto nextTick() {
+    struct Awaiter {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Behaviour::Handle handle) { handle.promise().executor->waitForTick(handle); }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{};
+}
+
+/**
+ * @brief Suspend for an amount of simulation time
+ * @param seconds Simulation seconds; resumes on the first tick at or past the wake time
+ */
+inline auto simDelay(double seconds) {
+    struct Awaiter {
+        double seconds;
+        bool await_ready() const noexcept { return seconds <= 0.0; }
+        void await_suspend(Behaviour::Handle handle) { handle.promise().executor->waitForDelay(handle, seconds); }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{seconds};
+}
+
+/**
+ * @brief Suspend until the signal is raised
+ * @param signalId Signal to wait for, e.g. a traffic light id
+ */
+inline auto signal(SignalId signalId) {
+    struct Awaiter {
+        SignalId signalId;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Behaviour::Handle handle) { handle.promise().executor->waitForSignal(handle, signalId); }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{signalId};
+}
+
+/**
+ * @brief Run a function on a ThreadManager worker and resume with its result
+ * The behaviour resumes on the simulation thread at the tick after completion;
+ * exceptions thrown by the function are rethrown inside the behaviour.
+ * @param threadManager Thread pool to run on
+ * @param function Function to execute
+ */
+template<typename F>
+auto runOnWorker(ThreadManager& threadManager, F&& function) {
+    using Result = std::invoke_result_t<std::decay_t<F>&>;
+    using Storage = std::conditional_t<std::is_void_v<Result>, bool, Result>;
+    
+    struct Awaiter {
+        ThreadManager& threadManager;
+        std::decay_t<F> function;
+        std::optional<Storage> result;
+        std::exception_ptr exception;
+        
+        bool await_ready() const noexcept { return false; }
+        
+        void execute() {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    function();
+                    result.emplace(true);
+                } else {
+                    result.emplace(function());
+                }
+            } catch (...) {
+                exception = std::current_exception();
+            }
+        }
+        
+        bool await_suspend(Behaviour::Handle handle) {
+            BehaviourExecutor* executor = handle.promise().executor;
+            executor->beginWorkerJob();
+            
+            // The awaiter lives in the suspended frame until the worker resumes it
+            TaskId taskId = threadManager.submitTask([this, handle, executor]() {
+                execute();
+                executor->completeWorkerJob(handle);
+            });
+            
+            if (taskId == 0) {
+                // Thread pool not running: execute inline and continue without suspending
+                executor->cancelWorkerJob();
+                execute();
+                return false;
+            }
+            return true;
+        }
+        
+        Result await_resume() {
+            if (exception) std::rethrow_exception(exception);
+            if constexpr (!std::is_void_v<Result>) {
+                return std::move(*result);
+            }
+        }
+    };
+    
+    return Awaiter{threadManager, std::forward<F>(function), std::nullopt, nullptr};
+}
+
+} // namespace RoadSim::Runtime
@@ -0,0 +1,88 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace RoadSim::Runtime {
+
+namespace {
+
+// Restart the sleep statistics periodically so they follow changes in timer resolution
+constexpr size_t MaxSleepSamples = 1000;
+
+} // namespace
+
+void FramePacer::setTargetFPS(unsigned int fps) {
+    m_targetFPS = fps;
+    m_period = fps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps))
+                       : Clock::duration::zero();
+    reset();
+}
+
+void FramePacer::reset() {
+    m_scheduled = false;
+    m_missedDeadlines = 0;
+    m_spinTime = 0.0;
+}
+
+void FramePacer::waitForNextFrame() {
+    if (m_targetFPS == 0) return;
+    
+    auto now = Clock::now();
+    if (!m_scheduled) {
+        m_deadline = now;
+        m_scheduled = true;
+    }
+    
+    m_deadline += m_period;
+    
+    // More than a whole period late: resynchronize instead of bursting to catch up
+    if (now > m_deadline + m_period) {
+        m_missedDeadlines++;
+        m_deadline = now;
+        return;
+    }
+    
+    // Coarse sleeps while they cannot overshoot the deadline
+    while (std::chrono::duration<double>(m_deadline - now).count() > m_sleepEstimate) {
+        auto sleepStart = now;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        now = Clock::now();
+        recordSleep(std::chrono::duration<double>(now - sleepStart).count());
+    }
+    
+    // Spin for the remainder
+    auto spinStart = now;
+    while (now < m_deadline) {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+    m_spinTime += std::chrono::duration<double>(now - spinStart).count();
+}
+
+void FramePacer::recordSleep(double seconds) {
+    if (m_sleepSamples >= MaxSleepSamples) {
+        m_sleepSamples = 1;
+        m_sleepM2 = 0.0;
+        m_sleepMean = seconds;
+    } else {
+        m_sleepSamples++;
+        double delta = seconds - m_sleepMean;
+        m_sleepMean += delta / static_cast<double>(m_sleepSamples);
+        m_sleepM2 += delta * (seconds - m_sleepMean);
+    }
+    
+    // Mean plus one standard deviation keeps overshoot rare without spinning too long
+    double stdDev = std::sqrt(m_sleepM2 / static_cast<double>(m_sleepSamples));
+    m_sleepEstimate = std::max(m_sleepMean + stdDev, 0.001);
+}
+
+FramePacer::Statistics FramePacer::getStatistics() const {
+    Statistics stats;
+    stats.missedDeadlines = m_missedDeadlines;
+    stats.sleepEstimate = m_sleepEstimate;
+    stats.spinTime = m_spinTime;
+    return stats;
+}
+
+} // namespace RoadSim::Runtime
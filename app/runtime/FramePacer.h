@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace RoadSim::Runtime {
+
+/**
+ * @brief Paces the main loop to a fixed frame rate
+ * Frames are scheduled on an absolute timeline (deadline += period), so
+ * per-frame sleep error does not accumulate into drift. Waiting is a hybrid:
+ * coarse 1 ms sleeps while the remaining time exceeds the measured sleep
+ * overshoot, then a yielding spin up to the deadline.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    FramePacer() = default;
+    
+    /**
+     * @brief Set the target frame rate
+     * @param fps Frames per second (0 disables pacing)
+     */
+    void setTargetFPS(unsigned int fps);
+    
+    unsigned int getTargetFPS() const { return m_targetFPS; }
+    
+    /**
+     * @brief Restart the frame schedule from now
+     */
+    void reset();
+    
+    /**
+     * @brief Block until the next frame deadline
+     */
+    void waitForNextFrame();
+    
+    /**
+     * @brief Pacing counters
+     */
+    struct Statistics {
+        size_t missedDeadlines = 0;  // Frames that ran more than one period late
+        double sleepEstimate = 0.0;  // Mean + one std. deviation of measured 1 ms sleeps, in seconds
+        double spinTime = 0.0;       // Total time spent spinning in seconds
+    };
+    
+    Statistics getStatistics() const;
+    
+private:
+    void recordSleep(double seconds);
+    
+    unsigned int m_targetFPS = 0;
+    Clock::duration m_period{};
+    Clock::time_point m_deadline{};
+    bool m_scheduled = false;
+    
+    // Running mean/variance of observed 1 ms sleeps (Welford)
+    double m_sleepEstimate = 0.002;
+    double m_sleepMean = 0.001;
+    double m_sleepM2 = 0.0;
+    size_t m_sleepSamples = 1;
+    
+    size_t m_missedDeadlines = 0;
+    double m_spinTime = 0.0;
+};
+
+} // namespace RoadSim::Runtime
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace RoadSim::Runtime {
+
+/**
+ * @brief Move-only void() callable with inline storage
+ * Callables up to InlineSize bytes that are nothrow-movable are stored in place,
+ * so wrapping a typical lambda never touches the heap. Larger callables fall
+ * back to a heap allocation, which is counted for diagnostics.
+ */
+class InlineTask {
+public:
+    static constexpr size_t InlineSize = 64;
+    
+    InlineTask() noexcept = default;
+    
+    template<typename F,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineTask> &&
+                                         std::is_invocable_v<std::decay_t<F>&>>>
+    InlineTask(F&& function) {
+        using Callable = std::decay_t<F>;
+        
+        if constexpr (fitsInline<Callable>()) {
+            ::new (static_cast<void*>(m_storage)) Callable(std::forward<F>(function));
+            m_ops = &InlineOps<Callable>::ops;
+        } else {
+            Callable* heapCallable = new Callable(std::forward<F>(function));
+            ::new (static_cast<void*>(m_storage)) Callable*(heapCallable);
+            m_ops = &HeapOps<Callable>::ops;
+            s_heapFallbacks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    InlineTask(InlineTask&& other) noexcept {
+        moveFrom(other);
+    }
+    
+    InlineTask& operator=(InlineTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+    
+    // Non-copyable
+    InlineTask(const InlineTask&) = delete;
+    InlineTask& operator=(const InlineTask&) = delete;
+    
+    ~InlineTask() {
+        reset();
+    }
+    
+    /**
+     * @brief Invoke the stored callable
+     */
+    void operator()() {
+        if (!m_ops) {
+            throw std::bad_function_call();
+        }
+        m_ops->invoke(m_storage);
+    }
+    
+    /**
+     * @brief Check if a callable is stored
+     */
+    explicit operator bool() const noexcept { return m_ops != nullptr; }
+    
+    /**
+     * @brief Destroy the stored callable
+     */
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+    
+    /**
+     * @brief Number of callables that were too large for inline storage
+     */
+    static size_t getHeapFallbackCount() noexcept {
+        return s_heapFallbacks.load(std::memory_order_relaxed);
+    }
+    
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* destination, void* source) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+    
+    template<typename Callable>
+    static constexpr bool fitsInline() {
+        return sizeof(Callable) <= InlineSize &&
+               alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Callable>;
+    }
+    
+    template<typename Callable>
+    struct InlineOps {
+        static void invoke(void* storage) {
+            (*std::launder(static_cast<Callable*>(storage)))();
+        }
+        static void move(void* destination, void* source) noexcept {
+            Callable* from = std::launder(static_cast<Callable*>(source));
+            ::new (destination) Callable(std::move(*from));
+            from->~Callable();
+        }
+        static void destroy(void* storage) noexcept {
+            std::launder(static_cast<Callable*>(storage))->~Callable();
+        }
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+    
+    template<typename Callable>
+    struct HeapOps {
+        static Callable*& pointer(void* storage) {
+            return *std::launder(static_cast<Callable**>(storage));
+        }
+        static void invoke(void* storage) {
+            (*pointer(storage))();
+        }
+        static void move(void* destination, void* source) noexcept {
+            ::new (destination) Callable*(pointer(source));
+        }
+        static void destroy(void* storage) noexcept {
+            delete pointer(storage);
+        }
+        static constexpr Ops ops{&invoke, &move, &destroy};
+    };
+    
+    void moveFrom(InlineTask& other) noexcept {
+        if (other.m_ops) {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+    
+    alignas(std::max_align_t) unsigned char m_storage[InlineSize];
+    const Ops* m_ops = nullptr;
+    
+    static inline std::atomic<size_t> s_heapFallbacks{0};
+};
+
+} // namespace RoadSim::Runtime
@@ -0,0 +1,105 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace RoadSim::Runtime {
+
+size_t LatencyHistogram::bucketIndex(uint64_t valueNs) {
+    valueNs = std::min(valueNs, (uint64_t{1} << MaxValueBits) - 1);
+    
+    if (valueNs < SubBucketCount) {
+        return static_cast<size_t>(valueNs);
+    }
+    
+    // Values in [2^msb, 2^(msb+1)) share one power-of-two range
+    const int msb = std::bit_width(valueNs) - 1;
+    const int shift = msb - SubBucketBits;
+    const uint64_t subBucket = (valueNs >> shift) - SubBucketCount;
+    return static_cast<size_t>(SubBucketCount + static_cast<uint64_t>(shift) * SubBucketCount + subBucket);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SubBucketCount) {
+        return index;
+    }
+    
+    const size_t shift = (index - SubBucketCount) / SubBucketCount;
+    const uint64_t subBucket = (index - SubBucketCount) % SubBucketCount;
+    return ((SubBucketCount + subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t valueNs) {
+    // Single writer: plain load/store pairs are enough, no read-modify-write needed
+    auto& bucket = m_counts[bucketIndex(valueNs)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_sumNs.store(m_sumNs.load(std::memory_order_relaxed) + valueNs, std::memory_order_relaxed);
+    
+    if (valueNs > m_maxNs.load(std::memory_order_relaxed)) {
+        m_maxNs.store(valueNs, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot result;
+    
+    for (size_t i = 0; i < BucketCount; ++i) {
+        result.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        result.totalCount += result.counts[i];
+    }
+    
+    result.sumNs = m_sumNs.load(std::memory_order_relaxed);
+    result.maxNs = m_maxNs.load(std::memory_order_relaxed);
+    return result;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& count : m_counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    m_sumNs.store(0, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Snapshot::merge(const Snapshot& other) {
+    for (size_t i = 0; i < BucketCount; ++i) {
+        counts[i] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    sumNs += other.sumNs;
+    maxNs = std::max(maxNs, other.maxNs);
+}
+
+uint64_t LatencyHistogram::Snapshot::valueAtPercentile(double percentile) const {
+    if (totalCount == 0) return 0;
+    
+    const auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(totalCount)));
+    uint64_t seen = 0;
+    
+    for (size_t i = 0; i < BucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= std::max<uint64_t>(target, 1)) {
+            return std::min(bucketUpperBound(i), maxNs);
+        }
+    }
+    
+    return maxNs;
+}
+
+LatencyHistogram::Summary LatencyHistogram::Snapshot::summarize() const {
+    constexpr double nsToSeconds = 1e-9;
+    
+    Summary summary;
+    summary.count = totalCount;
+    if (totalCount == 0) return summary;
+    
+    summary.mean = static_cast<double>(sumNs) / static_cast<double>(totalCount) * nsToSeconds;
+    summary.p50 = static_cast<double>(valueAtPercentile(50.0)) * nsToSeconds;
+    summary.p90 = static_cast<double>(valueAtPercentile(90.0)) * nsToSeconds;
+    summary.p99 = static_cast<double>(valueAtPercentile(99.0)) * nsToSeconds;
+    summary.p999 = static_cast<double>(valueAtPercentile(99.9)) * nsToSeconds;
+    summary.max = static_cast<double>(maxNs) * nsToSeconds;
+    return summary;
+}
+
+} // namespace RoadSim::Runtime
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace RoadSim::Runtime {
+
+/**
+ * @brief Log-linear (HDR-style) histogram of durations in nanoseconds
+ * Each power of two is split into 16 sub-buckets (~6% relative precision).
+ * Recording is lock-free and meant for a single writer thread; any thread
+ * may take a snapshot concurrently.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SubBucketBits = 4;
+    static constexpr uint64_t SubBucketCount = 1u << SubBucketBits;
+    static constexpr int MaxValueBits = 40; // ~18 minutes, larger values are clamped
+    static constexpr size_t BucketCount = SubBucketCount + (MaxValueBits - SubBucketBits) * SubBucketCount;
+    
+    /**
+     * @brief Percentile summary, durations in seconds
+     */
+    struct Summary {
+        uint64_t count = 0;
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double max = 0.0;
+    };
+    
+    /**
+     * @brief Plain copy of the histogram that can be merged and queried
+     */
+    struct Snapshot {
+        std::vector<uint64_t> counts = std::vector<uint64_t>(BucketCount, 0);
+        uint64_t totalCount = 0;
+        uint64_t sumNs = 0;
+        uint64_t maxNs = 0;
+        
+        void merge(const Snapshot& other);
+        uint64_t valueAtPercentile(double percentile) const;
+        Summary summarize() const;
+    };
+    
+    LatencyHistogram() = default;
+    
+    // Non-copyable (atomic counters)
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    
+    /**
+     * @brief Record one duration (single writer)
+     * @param valueNs Duration in nanoseconds
+     */
+    void record(uint64_t valueNs);
+    
+    /**
+     * @brief Copy the current counts
+     */
+    Snapshot snapshot() const;
+    
+    /**
+     * @brief Clear all counts (not synchronized with a concurrent writer)
+     */
+    void reset();
+    
+    static size_t bucketIndex(uint64_t valueNs);
+    static uint64_t bucketUpperBound(size_t index);
+    
+private:
+    std::array<std::atomic<uint64_t>, BucketCount> m_counts{};
+    std::atomic<uint64_t> m_sumNs{0};
+    std::atomic<uint64_t> m_maxNs{0};
+};
+
+} // namespace RoadSim::Runtime
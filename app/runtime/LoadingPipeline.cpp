@@ -0,0 +1,264 @@
+#include "LoadingPipeline.h"
+#include "ThreadManager.h"
+#include "../io/JsonLoader.h"
+#include "../io/MapBinary.h"
+#include "../core/Trace.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+
+namespace RoadSim::Runtime {
+
+namespace {
+
+size_t fileSizeOrZero(const std::string& filePath) {
+    std::error_code error;
+    const auto size = std::filesystem::file_size(filePath, error);
+    return error ? 0 : static_cast<size_t>(size);
+}
+
+} // namespace
+
+struct LoadingPipeline::Impl {
+    using Clock = std::chrono::steady_clock;
+    
+    ThreadManager& threads;
+    Request request;
+    
+    // Progress counters, read by getProgress() from any thread
+    std::atomic<size_t> tasksCompleted{0};
+    std::atomic<size_t> tasksTotal{0};
+    std::atomic<size_t> bytesLoaded{0};
+    std::atomic<size_t> bytesTotal{0};
+    std::atomic<bool> finished{true};
+    std::atomic<bool> failed{false};
+    Clock::time_point startTime;
+    std::atomic<int64_t> finishNanoseconds{0};
+    
+    // A job is one requested file; the last chunk task of the map finishes its job
+    std::atomic<size_t> pendingJobs{0};
+    std::atomic<size_t> pendingChunks{0};
+    std::atomic<size_t> mapBytesCredited{0};
+    size_t mapFileSize = 0;
+    IO::MapChunkReader chunkReader;
+    
+    // Results, guarded by mutex
+    mutable std::mutex mutex;
+    std::condition_variable done;
+    std::vector<std::string> errors;
+    Core::MapData map;
+    bool mapLoaded = false;
+    
+    explicit Impl(ThreadManager& threadManager) : threads(threadManager) {}
+    
+    // Run on a worker, or inline when the thread manager has none
+    template <typename F>
+    void submit(F&& task) {
+        if (threads.getWorkerThreadCount() == 0) {
+            task();
+        } else {
+            threads.submitTask(std::forward<F>(task));
+        }
+    }
+    
+    void fail(const std::string& message) {
+        std::cerr << "[Runtime] Loading failed: " << message << std::endl;
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.push_back(message);
+        failed = true;
+    }
+    
+    void finishTask(size_t bytes) {
+        bytesLoaded += bytes;
+        tasksCompleted++;
+    }
+    
+    void finishJob() {
+        if (--pendingJobs > 0) return;
+        
+        finishNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count();
+        std::cout << "[Runtime] Loading " << (failed ? "failed" : "finished") << " after "
+                  << finishNanoseconds / 1000000 << " ms (" << tasksCompleted << " tasks)" << std::endl;
+        
+        // Notify under the lock: a waiter may destroy the pipeline as soon as it is released
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        done.notify_all();
+    }
+    
+    void storeMap(Core::MapData&& loaded) {
+        std::lock_guard<std::mutex> lock(mutex);
+        map = std::move(loaded);
+        mapLoaded = true;
+    }
+    
+    void loadMap() {
+        ROADSIM_TRACE_SCOPE("Runtime", "LoadingPipeline::loadMap");
+        
+        // Binary maps are mapped, not parsed, so there is nothing to split
+        if (IO::MapBinary::isBinaryMapFile(request.mapPath)) {
+            IO::JsonLoader loader;
+            loader.initialize();
+            Core::MapData loaded;
+            if (loader.loadMapData(request.mapPath, loaded)) {
+                storeMap(std::move(loaded));
+            } else {
+                fail(loader.getLastError());
+            }
+            finishTask(mapFileSize);
+            finishJob();
+            return;
+        }
+        
+        if (!chunkReader.open(request.mapPath, request.chunkBytes)) {
+            fail(chunkReader.getError());
+            finishTask(mapFileSize);
+            finishJob();
+            return;
+        }
+        
+        const size_t chunkCount = chunkReader.getChunkCount();
+        tasksTotal += chunkCount;
+        pendingChunks = chunkCount;
+        finishTask(0);
+        
+        for (size_t index = 0; index < chunkCount; ++index) {
+            submit([this, index] { parseMapChunk(index); });
+        }
+    }
+    
+    void parseMapChunk(size_t index) {
+        chunkReader.parseChunk(index);
+        
+        const size_t bytes = chunkReader.getChunkSize(index);
+        mapBytesCredited += bytes;
+        finishTask(bytes);
+        if (--pendingChunks > 0) return;
+        
+        // Last chunk: every partial table is visible after the decrement above
+        Core::MapData loaded;
+        if (chunkReader.merge(loaded)) {
+            storeMap(std::move(loaded));
+        } else {
+            fail(chunkReader.getError());
+        }
+        
+        const size_t credited = mapBytesCredited.load();
+        if (mapFileSize > credited) bytesLoaded += mapFileSize - credited;
+        finishJob();
+    }
+    
+    void loadFile(const std::string& filePath, bool (IO::JsonLoader::*load)(const std::string&)) {
+        ROADSIM_TRACE_SCOPE("Runtime", "LoadingPipeline::loadFile");
+        
+        IO::JsonLoader loader;
+        loader.initialize();
+        if (!(loader.*load)(filePath)) {
+            fail(filePath + ": " + loader.getLastError());
+        }
+        finishTask(fileSizeOrZero(filePath));
+        finishJob();
+    }
+};
+
+LoadingPipeline::LoadingPipeline(ThreadManager& threadManager)
+    : m_impl(std::make_unique<Impl>(threadManager)) {}
+
+LoadingPipeline::~LoadingPipeline() {
+    wait();
+}
+
+bool LoadingPipeline::start(const Request& request) {
+    Impl& impl = *m_impl;
+    if (!impl.finished) {
+        std::cerr << "[Runtime] Loading already in progress" << std::endl;
+        return false;
+    }
+    
+    impl.request = request;
+    impl.mapFileSize = request.mapPath.empty() ? 0 : fileSizeOrZero(request.mapPath);
+    {
+        std::lock_guard<std::mutex> lock(impl.mutex);
+        impl.errors.clear();
+        impl.map.clear();
+        impl.mapLoaded = false;
+    }
+    
+    const size_t jobs = !request.mapPath.empty() + !request.profilesPath.empty() + !request.scenarioPath.empty();
+    impl.tasksCompleted = 0;
+    impl.tasksTotal = jobs;
+    impl.bytesLoaded = 0;
+    impl.bytesTotal = impl.mapFileSize
+        + (request.profilesPath.empty() ? 0 : fileSizeOrZero(request.profilesPath))
+        + (request.scenarioPath.empty() ? 0 : fileSizeOrZero(request.scenarioPath));
+    impl.mapBytesCredited = 0;
+    impl.failed = false;
+    impl.finishNanoseconds = 0;
+    impl.startTime = Impl::Clock::now();
+    if (jobs == 0) return true;
+    
+    std::cout << "[Runtime] Loading " << jobs << " files (" << impl.bytesTotal / 1024 << " KB) on "
+              << impl.threads.getWorkerThreadCount() << " workers" << std::endl;
+    
+    // Set before the first job can finish
+    impl.pendingJobs = jobs;
+    impl.finished = false;
+    
+    if (!request.mapPath.empty()) {
+        impl.submit([&impl] { impl.loadMap(); });
+    }
+    if (!request.profilesPath.empty()) {
+        impl.submit([&impl] { impl.loadFile(impl.request.profilesPath, &IO::JsonLoader::loadEntityProfiles); });
+    }
+    if (!request.scenarioPath.empty()) {
+        impl.submit([&impl] { impl.loadFile(impl.request.scenarioPath, &IO::JsonLoader::loadScenario); });
+    }
+    return true;
+}
+
+LoadingPipeline::Progress LoadingPipeline::getProgress() const {
+    const Impl& impl = *m_impl;
+    
+    Progress progress;
+    progress.finished = impl.finished.load();
+    progress.succeeded = progress.finished && !impl.failed.load();
+    progress.tasksCompleted = impl.tasksCompleted.load();
+    progress.tasksTotal = impl.tasksTotal.load();
+    progress.bytesLoaded = impl.bytesLoaded.load();
+    progress.bytesTotal = impl.bytesTotal.load();
+    progress.elapsedSeconds = progress.finished
+        ? static_cast<double>(impl.finishNanoseconds.load()) * 1e-9
+        : std::chrono::duration<double>(Impl::Clock::now() - impl.startTime).count();
+    return progress;
+}
+
+bool LoadingPipeline::isFinished() const {
+    return m_impl->finished.load();
+}
+
+bool LoadingPipeline::wait() {
+    std::unique_lock<std::mutex> lock(m_impl->mutex);
+    m_impl->done.wait(lock, [this] { return m_impl->finished.load(); });
+    return !m_impl->failed.load();
+}
+
+bool LoadingPipeline::takeMap(Core::MapData& map) {
+    if (!isFinished()) return false;
+    
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    if (!m_impl->mapLoaded) return false;
+    map = std::move(m_impl->map);
+    m_impl->map.clear();
+    m_impl->mapLoaded = false;
+    return true;
+}
+
+std::vector<std::string> LoadingPipeline::getErrors() const {
+    std::lock_guard<std::mutex> lock(m_impl->mutex);
+    return m_impl->errors;
+}
+
+} // namespace RoadSim::Runtime
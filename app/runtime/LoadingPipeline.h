@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../core/MapData.h"
+#include "../io/MapChunkReader.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RoadSim::Runtime {
+
+class ThreadManager;
+
+/**
+ * @brief Loads a map, entity profiles and a scenario concurrently on ThreadManager
+ * The three files are independent, so each is its own job. JSON maps are
+ * split by MapChunkReader and their chunks parsed as separate tasks, then
+ * merged by whichever task finishes last; binary maps are mapped directly.
+ * start() returns immediately and getProgress() is lock-free, so the main
+ * loop keeps running (and drawing) while a large city loads.
+ */
+class LoadingPipeline {
+public:
+    /**
+     * @brief Files to load; empty paths are skipped
+     */
+    struct Request {
+        std::string mapPath;
+        std::string profilesPath;
+        std::string scenarioPath;
+        size_t chunkBytes = IO::MapChunkReader::DefaultChunkBytes;
+    };
+    
+    /**
+     * @brief Snapshot of the pipeline's counters
+     */
+    struct Progress {
+        size_t tasksCompleted = 0;
+        size_t tasksTotal = 0;      // Grows once the map has been split
+        size_t bytesLoaded = 0;
+        size_t bytesTotal = 0;
+        double elapsedSeconds = 0.0;
+        bool finished = false;
+        bool succeeded = false;
+        
+        /**
+         * @brief Fraction of input bytes processed (0.0 - 1.0)
+         */
+        double getFraction() const {
+            if (finished) return 1.0;
+            return bytesTotal > 0 ? static_cast<double>(bytesLoaded) / static_cast<double>(bytesTotal) : 0.0;
+        }
+    };
+    
+    explicit LoadingPipeline(ThreadManager& threadManager);
+    
+    /**
+     * @brief Waits for any tasks still running
+     */
+    ~LoadingPipeline();
+    
+    // Non-copyable
+    LoadingPipeline(const LoadingPipeline&) = delete;
+    LoadingPipeline& operator=(const LoadingPipeline&) = delete;
+    
+    /**
+     * @brief Submit the loads and return immediately
+     * @param request Files to load
+     * @return False if a previous load is still running
+     */
+    bool start(const Request& request);
+    
+    /**
+     * @brief Current progress; safe to call from any thread
+     */
+    Progress getProgress() const;
+    
+    bool isFinished() const;
+    
+    /**
+     * @brief Block until every job has finished
+     * @return Whether all of them succeeded
+     */
+    bool wait();
+    
+    /**
+     * @brief Move the loaded map out once finished
+     * @param map Output map tables
+     * @return False if no map was requested, loaded, or it was already taken
+     */
+    bool takeMap(Core::MapData& map);
+    
+    /**
+     * @brief Errors reported by failed jobs
+     */
+    std::vector<std::string> getErrors() const;
+    
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace RoadSim::Runtime
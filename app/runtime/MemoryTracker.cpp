@@ -0,0 +1,248 @@
+#include "MemoryTracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#include <malloc.h>
+#endif
+
+namespace RoadSim::Runtime {
+
+namespace {
+
+struct alignas(64) TagCounters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+// Constant-initialized, so usable by allocations made during static initialization
+TagCounters g_tagCounters[MemoryTracker::TagCount];
+std::atomic<uint64_t> g_deallocations{0};
+thread_local MemoryTag t_currentTag = MemoryTag::Untagged;
+
+[[maybe_unused]] void countAllocation(size_t size) {
+    TagCounters& counters = g_tagCounters[static_cast<size_t>(t_currentTag)];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+[[maybe_unused]] void countDeallocation() {
+    g_deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+#ifdef __linux__
+// Parse a "Key:   1234 kB" line of /proc/self/status
+size_t parseStatusKilobytes(const char* line, const char* key) {
+    const size_t keyLength = std::strlen(key);
+    if (std::strncmp(line, key, keyLength) != 0) return 0;
+    return static_cast<size_t>(std::strtoull(line + keyLength, nullptr, 10)) * 1024;
+}
+#endif
+
+} // namespace
+
+bool MemoryTracker::isEnabled() {
+#ifdef ROADSIM_NO_ALLOCATION_TRACKING
+    return false;
+#else
+    return true;
+#endif
+}
+
+MemoryTracker::Counters MemoryTracker::getCounters(MemoryTag tag) {
+    const TagCounters& counters = g_tagCounters[static_cast<size_t>(tag)];
+    return {counters.allocations.load(std::memory_order_relaxed), counters.bytes.load(std::memory_order_relaxed)};
+}
+
+MemoryTracker::Counters MemoryTracker::getTotalCounters() {
+    Counters total;
+    for (size_t i = 0; i < TagCount; ++i) {
+        Counters counters = getCounters(static_cast<MemoryTag>(i));
+        total.allocations += counters.allocations;
+        total.bytes += counters.bytes;
+    }
+    return total;
+}
+
+uint64_t MemoryTracker::getDeallocationCount() {
+    return g_deallocations.load(std::memory_order_relaxed);
+}
+
+MemoryTracker::ProcessMemory MemoryTracker::getProcessMemory() {
+    ProcessMemory memory;
+    
+#ifdef __linux__
+    // stdio only, so reading the status does not show up in allocation counts
+    if (std::FILE* file = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), file)) {
+            if (size_t value = parseStatusKilobytes(line, "VmRSS:")) memory.residentBytes = value;
+            if (size_t value = parseStatusKilobytes(line, "VmHWM:")) memory.peakResidentBytes = value;
+        }
+        std::fclose(file);
+    }
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        memory.residentBytes = counters.WorkingSetSize;
+        memory.peakResidentBytes = counters.PeakWorkingSetSize;
+    }
+#endif
+    
+    return memory;
+}
+
+MemoryTag MemoryTracker::setCurrentTag(MemoryTag tag) {
+    MemoryTag previous = t_currentTag;
+    t_currentTag = tag;
+    return previous;
+}
+
+MemoryTag MemoryTracker::getCurrentTag() {
+    return t_currentTag;
+}
+
+const char* MemoryTracker::getTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::Untagged: return "Untagged";
+        case MemoryTag::Scene: return "Scene";
+        case MemoryTag::Simulator: return "Simulator";
+        case MemoryTag::Renderer: return "Renderer";
+        case MemoryTag::IO: return "IO";
+        default: return "Unknown";
+    }
+}
+
+} // namespace RoadSim::Runtime
+
+#ifndef ROADSIM_NO_ALLOCATION_TRACKING
+
+namespace {
+
+void* trackedAllocate(std::size_t size) {
+    if (size == 0) size = 1;
+    
+    while (true) {
+        if (void* block = std::malloc(size)) {
+            RoadSim::Runtime::countAllocation(size);
+            return block;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+    }
+}
+
+void* trackedAllocateAligned(std::size_t size, std::align_val_t alignment) {
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (size == 0) size = 1;
+    
+    while (true) {
+#ifdef _WIN32
+        void* block = _aligned_malloc(size, align);
+#else
+        // aligned_alloc requires a size that is a multiple of the alignment
+        void* block = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+        if (block) {
+            RoadSim::Runtime::countAllocation(size);
+            return block;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+    }
+}
+
+void trackedFree(void* block) noexcept {
+    if (!block) return;
+    RoadSim::Runtime::countDeallocation();
+    std::free(block);
+}
+
+void trackedFreeAligned(void* block) noexcept {
+    if (!block) return;
+    RoadSim::Runtime::countDeallocation();
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* block = trackedAllocate(size)) return block;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* block = trackedAllocate(size)) return block;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return trackedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return trackedAllocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* block = trackedAllocateAligned(size, alignment)) return block;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* block = trackedAllocateAligned(size, alignment)) return block;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return trackedAllocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return trackedAllocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* block) noexcept { trackedFree(block); }
+void operator delete[](void* block) noexcept { trackedFree(block); }
+void operator delete(void* block, std::size_t) noexcept { trackedFree(block); }
+void operator delete[](void* block, std::size_t) noexcept { trackedFree(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { trackedFree(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { trackedFree(block); }
+
+void operator delete(void* block, std::align_val_t) noexcept { trackedFreeAligned(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { trackedFreeAligned(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { trackedFreeAligned(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { trackedFreeAligned(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept { trackedFreeAligned(block); }
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept { trackedFreeAligned(block); }
+
+#endif // ROADSIM_NO_ALLOCATION_TRACKING
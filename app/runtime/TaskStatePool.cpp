@@ -0,0 +1,122 @@
+#include "TaskStatePool.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RoadSim::Runtime {
+
+namespace {
+
+constexpr std::array<size_t, 4> SizeClasses = {64, 128, 256, 512};
+constexpr size_t ChunkBytes = 64 * 1024;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct SizeClassPool {
+    std::mutex mutex;
+    FreeBlock* freeList = nullptr;
+    size_t blocksInUse = 0;
+};
+
+struct PoolState {
+    std::array<SizeClassPool, SizeClasses.size()> classes;
+    std::mutex chunkMutex;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+    size_t oversizeAllocations = 0;
+};
+
+PoolState& state() {
+    // Never destroyed: blocks may be released by threads outliving static destruction
+    static PoolState* pool = new PoolState();
+    return *pool;
+}
+
+int sizeClassIndex(size_t bytes) {
+    for (size_t i = 0; i < SizeClasses.size(); ++i) {
+        if (bytes <= SizeClasses[i]) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// Carve a new chunk into blocks; called with the class mutex held
+void growClass(PoolState& pool, size_t classIndex) {
+    const size_t blockSize = SizeClasses[classIndex];
+    auto chunk = std::make_unique<unsigned char[]>(ChunkBytes + TaskStatePool::BlockAlignment);
+    
+    // Align the first block; the chunk is kept alive by the pool
+    auto address = reinterpret_cast<uintptr_t>(chunk.get());
+    address = (address + TaskStatePool::BlockAlignment - 1) & ~(uintptr_t{TaskStatePool::BlockAlignment} - 1);
+    auto* cursor = reinterpret_cast<unsigned char*>(address);
+    
+    SizeClassPool& sizeClass = pool.classes[classIndex];
+    for (size_t offset = 0; offset + blockSize <= ChunkBytes; offset += blockSize) {
+        auto* block = ::new (cursor + offset) FreeBlock{sizeClass.freeList};
+        sizeClass.freeList = block;
+    }
+    
+    std::lock_guard<std::mutex> lock(pool.chunkMutex);
+    pool.chunks.push_back(std::move(chunk));
+}
+
+} // namespace
+
+void* TaskStatePool::allocate(size_t bytes) {
+    PoolState& pool = state();
+    const int classIndex = sizeClassIndex(bytes);
+    
+    if (classIndex < 0) {
+        std::lock_guard<std::mutex> lock(pool.chunkMutex);
+        pool.oversizeAllocations++;
+        return ::operator new(bytes, std::align_val_t{BlockAlignment});
+    }
+    
+    SizeClassPool& sizeClass = pool.classes[static_cast<size_t>(classIndex)];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    
+    if (!sizeClass.freeList) {
+        growClass(pool, static_cast<size_t>(classIndex));
+    }
+    
+    FreeBlock* block = sizeClass.freeList;
+    sizeClass.freeList = block->next;
+    sizeClass.blocksInUse++;
+    return block;
+}
+
+void TaskStatePool::deallocate(void* block, size_t bytes) noexcept {
+    if (!block) return;
+    
+    PoolState& pool = state();
+    const int classIndex = sizeClassIndex(bytes);
+    
+    if (classIndex < 0) {
+        ::operator delete(block, std::align_val_t{BlockAlignment});
+        return;
+    }
+    
+    SizeClassPool& sizeClass = pool.classes[static_cast<size_t>(classIndex)];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    sizeClass.freeList = ::new (block) FreeBlock{sizeClass.freeList};
+    sizeClass.blocksInUse--;
+}
+
+TaskStatePool::Statistics TaskStatePool::getStatistics() {
+    PoolState& pool = state();
+    Statistics stats;
+    
+    for (auto& sizeClass : pool.classes) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        stats.blocksInUse += sizeClass.blocksInUse;
+    }
+    
+    std::lock_guard<std::mutex> lock(pool.chunkMutex);
+    stats.chunksAllocated = pool.chunks.size();
+    stats.oversizeAllocations = pool.oversizeAllocations;
+    return stats;
+}
+
+} // namespace RoadSim::Runtime
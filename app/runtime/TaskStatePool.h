@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace RoadSim::Runtime {
+
+/**
+ * @brief Recycling pool for small, short-lived task state
+ * Blocks are grouped in a few size classes and returned to a free list
+ * instead of the heap, so promise/future shared states are reused once
+ * the pool has warmed up. Requests above the largest class use the heap.
+ */
+class TaskStatePool {
+public:
+    static constexpr size_t BlockAlignment = 64;
+    
+    /**
+     * @brief Allocate a block of at least the given size
+     * @param bytes Requested size
+     */
+    static void* allocate(size_t bytes);
+    
+    /**
+     * @brief Return a block to the pool
+     * @param block Block returned by allocate
+     * @param bytes Size passed to allocate
+     */
+    static void deallocate(void* block, size_t bytes) noexcept;
+    
+    /**
+     * @brief Pool usage counters
+     */
+    struct Statistics {
+        size_t chunksAllocated = 0;   // Heap allocations made to grow the pool
+        size_t oversizeAllocations = 0; // Requests too large for any size class
+        size_t blocksInUse = 0;
+    };
+    
+    static Statistics getStatistics();
+};
+
+/**
+ * @brief Standard allocator adapter over TaskStatePool
+ * Used with std::promise so the shared state of task results is pooled
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    
+    PoolAllocator() noexcept = default;
+    
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+    
+    T* allocate(size_t count) {
+        if constexpr (alignof(T) > TaskStatePool::BlockAlignment) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}));
+        } else {
+            return static_cast<T*>(TaskStatePool::allocate(count * sizeof(T)));
+        }
+    }
+    
+    void deallocate(T* pointer, size_t count) noexcept {
+        if constexpr (alignof(T) > TaskStatePool::BlockAlignment) {
+            ::operator delete(pointer, std::align_val_t{alignof(T)});
+        } else {
+            TaskStatePool::deallocate(pointer, count * sizeof(T));
+        }
+    }
+    
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+};
+
+} // namespace RoadSim::Runtime
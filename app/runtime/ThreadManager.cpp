@@ -1,18 +1,295 @@
 #include "ThreadManager.h"
-#include <queue>
+#include "../core/Trace.h"
+#include "../core/PerfCounters.h"
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
-#include <unordered_map>
 #include <chrono>
 #include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace RoadSim::Runtime {
 
+namespace {
+
+/**
+ * @brief Parse a Linux cpulist string such as "0-3,8,10-11"
+ */
+std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    size_t pos = 0;
+    
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        
+        std::string range = list.substr(pos, end - pos);
+        size_t dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(range));
+            } else {
+                int first = std::stoi(range.substr(0, dash));
+                int last = std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (...) {
+            // Ignore malformed entries (e.g. trailing newline)
+        }
+        
+        pos = end + 1;
+    }
+    
+    return cpus;
+}
+
+/**
+ * @brief Detect NUMA nodes and the CPUs this process may run on
+ */
+ThreadManager::Topology detectTopology() {
+    ThreadManager::Topology topology;
+    
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool haveAllowed = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    
+    std::error_code ec;
+    std::vector<std::pair<int, std::vector<int>>> nodes;
+    
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+            !std::all_of(name.begin() + 4, name.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            continue;
+        }
+        
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        if (!file.is_open() || !std::getline(file, list)) continue;
+        
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(list)) {
+            if (!haveAllowed || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) {
+                cpus.push_back(cpu);
+            }
+        }
+        
+        if (!cpus.empty()) {
+            nodes.emplace_back(std::stoi(name.substr(4)), std::move(cpus));
+        }
+    }
+    
+    std::sort(nodes.begin(), nodes.end());
+    for (auto& node : nodes) {
+        topology.nodeCpus.push_back(std::move(node.second));
+    }
+    
+    if (topology.nodeCpus.empty() && haveAllowed) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        }
+        if (!cpus.empty()) topology.nodeCpus.push_back(std::move(cpus));
+    }
+#endif
+    
+    // Fallback: a single node with every hardware thread
+    if (topology.nodeCpus.empty()) {
+        unsigned int count = std::thread::hardware_concurrency();
+        std::vector<int> cpus;
+        for (unsigned int cpu = 0; cpu < std::max(count, 1u); ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        topology.nodeCpus.push_back(std::move(cpus));
+    }
+    
+    for (const auto& cpus : topology.nodeCpus) {
+        topology.logicalCpuCount += cpus.size();
+    }
+    
+    return topology;
+}
+
+using Clock = std::chrono::steady_clock;
+
+// Rolling window used for busy/idle accounting
+constexpr int64_t WindowSlotNs = 500'000'000;
+constexpr size_t WindowSlotCount = 10;
+
+/**
+ * @brief Counters written only by one worker, padded to avoid false sharing
+ */
+struct alignas(64) WorkerCounters {
+    struct WindowSlot {
+        std::atomic<int64_t> epoch{-1};
+        std::atomic<int64_t> busyNs{0};
+    };
+    
+    std::atomic<uint64_t> tasksExecuted{0};
+    std::atomic<uint64_t> totalBusyNs{0};
+    std::array<WindowSlot, WindowSlotCount> window;
+    LatencyHistogram taskLatency;
+    LatencyHistogram queueWait;
+    
+    // Hardware counters of the worker thread, guarded by the queue mutex
+    std::unique_ptr<Core::PerfCounters> hardware;
+    Core::PerfSample hardwareBaseline;
+    
+    void addBusyTime(int64_t startNs, int64_t endNs) {
+        // Split the interval over the window slots it covers
+        while (startNs < endNs) {
+            const int64_t epoch = startNs / WindowSlotNs;
+            const int64_t slotEnd = std::min(endNs, (epoch + 1) * WindowSlotNs);
+            auto& slot = window[static_cast<size_t>(epoch) % WindowSlotCount];
+            
+            if (slot.epoch.load(std::memory_order_relaxed) != epoch) {
+                slot.busyNs.store(0, std::memory_order_relaxed);
+                slot.epoch.store(epoch, std::memory_order_relaxed);
+            }
+            slot.busyNs.store(slot.busyNs.load(std::memory_order_relaxed) + (slotEnd - startNs), std::memory_order_relaxed);
+            startNs = slotEnd;
+        }
+    }
+    
+    int64_t busyInWindow(int64_t nowNs) const {
+        const int64_t currentEpoch = nowNs / WindowSlotNs;
+        int64_t busy = 0;
+        for (const auto& slot : window) {
+            int64_t epoch = slot.epoch.load(std::memory_order_relaxed);
+            if (epoch >= 0 && epoch <= currentEpoch && currentEpoch - epoch < static_cast<int64_t>(WindowSlotCount)) {
+                busy += slot.busyNs.load(std::memory_order_relaxed);
+            }
+        }
+        return busy;
+    }
+};
+
+struct QueuedTask {
+    TaskId id = 0;
+    Task function;
+    Clock::time_point enqueueTime;
+};
+
+/**
+ * @brief FIFO of queued tasks backed by a power-of-two ring
+ * Slots are reused, so the queue only allocates when it has to grow.
+ */
+class TaskRing {
+public:
+    bool empty() const { return m_count == 0; }
+    size_t size() const { return m_count; }
+    size_t capacity() const { return m_slots.size(); }
+    
+    void push(QueuedTask task) {
+        if (m_count == m_slots.size()) {
+            grow();
+        }
+        m_slots[(m_head + m_count) & (m_slots.size() - 1)] = std::move(task);
+        m_count++;
+    }
+    
+    void pop(QueuedTask& task) {
+        QueuedTask& slot = m_slots[m_head];
+        task = std::move(slot);
+        slot.function.reset();
+        m_head = (m_head + 1) & (m_slots.size() - 1);
+        m_count--;
+    }
+    
+private:
+    void grow() {
+        std::vector<QueuedTask> slots(std::max<size_t>(m_slots.size() * 2, 64));
+        for (size_t i = 0; i < m_count; ++i) {
+            slots[i] = std::move(m_slots[(m_head + i) & (m_slots.size() - 1)]);
+        }
+        m_slots = std::move(slots);
+        m_head = 0;
+    }
+    
+    std::vector<QueuedTask> m_slots;
+    size_t m_head = 0;
+    size_t m_count = 0;
+};
+
+/**
+ * @brief Completion state of task ids without a per-task map entry
+ * Every id below the watermark is complete; ids above it that finished
+ * out of order are flagged in a ring indexed by id. The ring only grows
+ * when more ids than its capacity are in flight at once.
+ */
+class CompletionTracker {
+public:
+    bool isCompleted(TaskId id) const {
+        if (id < m_watermark) return true;
+        if (id - m_watermark >= m_done.size()) return false;
+        return m_done[id & (m_done.size() - 1)] != 0;
+    }
+    
+    void markCompleted(TaskId id) {
+        if (id < m_watermark) return;
+        if (id - m_watermark >= m_done.size()) {
+            grow(id - m_watermark + 1);
+        }
+        
+        const size_t mask = m_done.size() - 1;
+        m_done[id & mask] = 1;
+        
+        // Advance over the contiguous run of finished ids
+        while (m_done[m_watermark & mask]) {
+            m_done[m_watermark & mask] = 0;
+            m_watermark++;
+        }
+    }
+    
+private:
+    void grow(size_t span) {
+        size_t capacity = std::max<size_t>(m_done.size(), 256);
+        while (capacity < span) capacity *= 2;
+        
+        std::vector<uint8_t> done(capacity, 0);
+        for (size_t i = 0; i < m_done.size(); ++i) {
+            const TaskId id = m_watermark + i;
+            done[id & (capacity - 1)] = m_done[id & (m_done.size() - 1)];
+        }
+        m_done = std::move(done);
+    }
+    
+    TaskId m_watermark = 1; // Task ids start at 1
+    std::vector<uint8_t> m_done;
+};
+
+} // namespace
+
 struct ThreadManager::Impl {
+    struct WorkerInfo {
+        int node = 0;
+        int cpu = -1;
+        long nativeId = 0; // Kernel thread id, 0 until the worker has started
+    };
+    
     std::vector<std::thread> workers;
-    std::queue<std::pair<TaskId, Task>> taskQueue;
-    std::unordered_map<TaskId, bool> taskStatus;
+    std::vector<WorkerInfo> workerInfo;
+    
+    // One queue per NUMA node; workers drain their own node first, then steal
+    std::vector<TaskRing> nodeQueues;
+    CompletionTracker completedTasks;
+    size_t pendingTasks = 0;
+    size_t nextSubmitNode = 0;
     
     mutable std::mutex queueMutex;
     std::condition_variable condition;
@@ -20,14 +297,116 @@ struct ThreadManager::Impl {
     std::atomic<TaskId> nextTaskId{1};
     std::atomic<size_t> activeTasks{0};
     
-    // Statistics
-    std::atomic<size_t> totalTasksExecuted{0};
-    std::atomic<double> totalTaskDuration{0.0};
+    // Statistics, one padded block per worker
+    std::unique_ptr<WorkerCounters[]> counters;
+    Clock::time_point startTime;
+    
+    // Scheduling settings, applied to running and future workers
+    Topology topology;
+    int priority = 0;
+    int realtimePriority = 0;
+    bool affinityEnabled = false;
+    bool hardwareCountersEnabled = false;
     
     bool initialized = false;
     size_t numThreads = 0;
+    
+    bool popTask(size_t workerIndex, QueuedTask& task);
+    
+    int64_t elapsedNs(Clock::time_point time) const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time - startTime).count();
+    }
+    size_t selectSubmitNode();
+    void applyWorkerSettings(size_t workerIndex);
 };
 
+bool ThreadManager::Impl::popTask(size_t workerIndex, QueuedTask& task) {
+    const size_t nodeCount = nodeQueues.size();
+    const size_t home = static_cast<size_t>(workerInfo[workerIndex].node);
+    
+    for (size_t i = 0; i < nodeCount; ++i) {
+        auto& queue = nodeQueues[(home + i) % nodeCount];
+        if (!queue.empty()) {
+            queue.pop(task);
+            pendingTasks--;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+size_t ThreadManager::Impl::selectSubmitNode() {
+    const size_t nodeCount = nodeQueues.size();
+    if (nodeCount == 1) return 0;
+    
+#ifdef __linux__
+    // Keep work close to the data the submitting thread just touched
+    if (affinityEnabled) {
+        int cpu = sched_getcpu();
+        for (size_t node = 0; node < nodeCount && cpu >= 0; ++node) {
+            const auto& cpus = topology.nodeCpus[node];
+            if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) {
+                return node;
+            }
+        }
+    }
+#endif
+    
+    return nextSubmitNode++ % nodeCount;
+}
+
+void ThreadManager::Impl::applyWorkerSettings(size_t workerIndex) {
+#ifdef __linux__
+    WorkerInfo& info = workerInfo[workerIndex];
+    if (info.nativeId == 0) return;
+    
+    pthread_t handle = workers[workerIndex].native_handle();
+    
+    // Affinity: pin to one CPU of the worker's node, or allow every CPU
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    const auto& nodeCpus = topology.nodeCpus[static_cast<size_t>(info.node)];
+    
+    if (affinityEnabled) {
+        // Spread workers of the same node over its CPUs
+        size_t slot = workerIndex / topology.nodeCpus.size();
+        info.cpu = nodeCpus[slot % nodeCpus.size()];
+        CPU_SET(info.cpu, &cpuSet);
+    } else {
+        info.cpu = -1;
+        for (const auto& cpus : topology.nodeCpus) {
+            for (int cpu : cpus) CPU_SET(cpu, &cpuSet);
+        }
+    }
+    
+    if (int err = pthread_setaffinity_np(handle, sizeof(cpuSet), &cpuSet); err != 0) {
+        std::cerr << "[Runtime] Failed to set affinity of worker " << workerIndex << " (error " << err << ")" << std::endl;
+        info.cpu = -1;
+    }
+    
+    // Scheduling policy: SCHED_FIFO when a real-time priority is set
+    sched_param param{};
+    int policy = SCHED_OTHER;
+    if (realtimePriority > 0) {
+        policy = SCHED_FIFO;
+        param.sched_priority = std::clamp(realtimePriority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+    }
+    
+    if (int err = pthread_setschedparam(handle, policy, &param); err != 0) {
+        std::cerr << "[Runtime] Failed to set scheduling policy of worker " << workerIndex << " (error " << err << ")" << std::endl;
+    }
+    
+    // Nice value is per thread on Linux
+    int niceValue = std::clamp(-priority, -20, 19);
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(info.nativeId), niceValue) != 0) {
+        std::cerr << "[Runtime] Failed to set priority of worker " << workerIndex << " (nice " << niceValue << ")" << std::endl;
+    }
+#else
+    (void)workerIndex;
+#endif
+}
+
 ThreadManager::ThreadManager() : m_impl(std::make_unique<Impl>()) {
     std::cout << "[Runtime] ThreadManager created" << std::endl;
 }
@@ -43,67 +422,123 @@ void ThreadManager::initialize(size_t numThreads) {
         return;
     }
     
+    m_impl->topology = detectTopology();
+    const size_t nodeCount = m_impl->topology.nodeCpus.size();
+    
     if (numThreads == 0) {
         numThreads = std::thread::hardware_concurrency();
         if (numThreads == 0) numThreads = 4; // Fallback
     }
     
     m_impl->numThreads = numThreads;
-    std::cout << "[Runtime] Initializing ThreadManager with " << numThreads << " threads" << std::endl;
+    m_impl->stop = false;
+    m_impl->nodeQueues.clear();
+    m_impl->nodeQueues.resize(nodeCount);
+    m_impl->workerInfo.assign(numThreads, {});
+    m_impl->counters = std::make_unique<WorkerCounters[]>(numThreads);
+    m_impl->startTime = Clock::now();
+    
+    // Round-robin workers over NUMA nodes
+    for (size_t i = 0; i < numThreads; ++i) {
+        m_impl->workerInfo[i].node = static_cast<int>(i % nodeCount);
+    }
+    
+    std::cout << "[Runtime] Initializing ThreadManager with " << numThreads << " threads on "
+              << nodeCount << " NUMA node(s), " << m_impl->topology.logicalCpuCount << " CPUs" << std::endl;
+    
+    // Hold the lock so workers register only once every std::thread exists
+    std::unique_lock<std::mutex> startLock(m_impl->queueMutex);
     
     // Create worker threads
     for (size_t i = 0; i < numThreads; ++i) {
         m_impl->workers.emplace_back([this, i]() {
+            {
+                std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+#ifdef __linux__
+                m_impl->workerInfo[i].nativeId = static_cast<long>(syscall(SYS_gettid));
+#else
+                m_impl->workerInfo[i].nativeId = static_cast<long>(i + 1);
+#endif
+                m_impl->applyWorkerSettings(i);
+            }
+            
+            ROADSIM_TRACE_THREAD_NAME("Worker " + std::to_string(i));
             std::cout << "[Runtime] Worker thread " << i << " started" << std::endl;
             
             while (true) {
-                std::pair<TaskId, Task> task;
+                QueuedTask task;
                 
                 {
                     std::unique_lock<std::mutex> lock(m_impl->queueMutex);
                     
-                    m_impl->condition.wait(lock, [this] {
-                        return m_impl->stop || !m_impl->taskQueue.empty();
+                    WorkerCounters& counters = m_impl->counters[i];
+                    m_impl->condition.wait(lock, [this, &counters] {
+                        return m_impl->stop || m_impl->pendingTasks > 0 ||
+                               (m_impl->hardwareCountersEnabled && !counters.hardware);
                     });
                     
-                    if (m_impl->stop && m_impl->taskQueue.empty()) {
-                        break;
+                    // Counters measure the calling thread, so each worker opens its own
+                    if (m_impl->hardwareCountersEnabled && !counters.hardware) {
+                        counters.hardware = std::make_unique<Core::PerfCounters>();
+                        counters.hardwareBaseline = counters.hardware->read();
+                        if (i == 0 && !counters.hardware->isAvailable()) {
+                            std::cerr << "[Runtime] Hardware counters unavailable: " << counters.hardware->getError() << std::endl;
+                        }
                     }
                     
-                    task = std::move(m_impl->taskQueue.front());
-                    m_impl->taskQueue.pop();
+                    if (!m_impl->popTask(i, task)) {
+                        if (m_impl->stop) {
+                            // Only reached when stopping with nothing left to run
+                            break;
+                        }
+                        continue;
+                    }
                 }
                 
                 // Execute task
-                auto startTime = std::chrono::high_resolution_clock::now();
+                auto startTime = Clock::now();
                 m_impl->activeTasks++;
                 
                 try {
-                    task.second(); // Execute the task
+                    ROADSIM_TRACE_SCOPE("Runtime", "Task");
+                    task.function(); // Execute the task
                 } catch (const std::exception& e) {
-                    std::cerr << "[Runtime] Task " << task.first << " threw exception: " << e.what() << std::endl;
+                    std::cerr << "[Runtime] Task " << task.id << " threw exception: " << e.what() << std::endl;
                 } catch (...) {
-                    std::cerr << "[Runtime] Task " << task.first << " threw unknown exception" << std::endl;
+                    std::cerr << "[Runtime] Task " << task.id << " threw unknown exception" << std::endl;
                 }
                 
-                auto endTime = std::chrono::high_resolution_clock::now();
-                auto duration = std::chrono::duration<double>(endTime - startTime).count();
-                
+                auto endTime = Clock::now();
                 m_impl->activeTasks--;
-                m_impl->totalTasksExecuted++;
-                m_impl->totalTaskDuration += duration;
+                
+                // Per-worker statistics, no shared cache lines touched
+                WorkerCounters& counters = m_impl->counters[i];
+                const int64_t startNs = m_impl->elapsedNs(startTime);
+                const int64_t endNs = m_impl->elapsedNs(endTime);
+                const int64_t waitNs = std::max<int64_t>(0, startNs - m_impl->elapsedNs(task.enqueueTime));
+                
+                counters.taskLatency.record(static_cast<uint64_t>(endNs - startNs));
+                counters.queueWait.record(static_cast<uint64_t>(waitNs));
+                counters.addBusyTime(startNs, endNs);
+                counters.totalBusyNs.store(counters.totalBusyNs.load(std::memory_order_relaxed) + static_cast<uint64_t>(endNs - startNs), std::memory_order_relaxed);
+                counters.tasksExecuted.store(counters.tasksExecuted.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
                 
                 // Mark task as completed
                 {
                     std::lock_guard<std::mutex> lock(m_impl->queueMutex);
-                    m_impl->taskStatus[task.first] = true;
+                    m_impl->completedTasks.markCompleted(task.id);
                 }
+                
+                // Release captured state outside the lock
+                task.function.reset();
             }
             
             std::cout << "[Runtime] Worker thread " << i << " stopped" << std::endl;
         });
     }
     
+    startLock.unlock();
+    
     m_impl->initialized = true;
     std::cout << "[Runtime] ThreadManager initialized successfully" << std::endl;
 }
@@ -127,6 +562,7 @@ void ThreadManager::shutdown() {
     }
     
     m_impl->workers.clear();
+    m_impl->workerInfo.clear();
     m_impl->initialized = false;
     
     std::cout << "[Runtime] ThreadManager shutdown complete" << std::endl;
@@ -142,8 +578,8 @@ TaskId ThreadManager::submitTask(Task task) {
     
     {
         std::lock_guard<std::mutex> lock(m_impl->queueMutex);
-        m_impl->taskQueue.emplace(taskId, std::move(task));
-        m_impl->taskStatus[taskId] = false;
+        m_impl->nodeQueues[m_impl->selectSubmitNode()].push({taskId, std::move(task), Clock::now()});
+        m_impl->pendingTasks++;
     }
     
     m_impl->condition.notify_one();
@@ -167,14 +603,15 @@ void ThreadManager::waitForAllTasks() {
 }
 
 bool ThreadManager::isTaskCompleted(TaskId taskId) const {
+    if (taskId == 0) return false;
+    
     std::lock_guard<std::mutex> lock(m_impl->queueMutex);
-    auto it = m_impl->taskStatus.find(taskId);
-    return it != m_impl->taskStatus.end() && it->second;
+    return m_impl->completedTasks.isCompleted(taskId);
 }
 
 size_t ThreadManager::getPendingTaskCount() const {
     std::lock_guard<std::mutex> lock(m_impl->queueMutex);
-    return m_impl->taskQueue.size();
+    return m_impl->pendingTasks;
 }
 
 size_t ThreadManager::getWorkerThreadCount() const {
@@ -182,34 +619,179 @@ size_t ThreadManager::getWorkerThreadCount() const {
 }
 
 float ThreadManager::getThreadUtilization() const {
-    if (m_impl->numThreads == 0) return 0.0f;
-    return static_cast<float>(m_impl->activeTasks) / static_cast<float>(m_impl->numThreads);
+    if (m_impl->numThreads == 0 || !m_impl->counters) return 0.0f;
+    
+    const int64_t nowNs = m_impl->elapsedNs(Clock::now());
+    const int64_t windowNs = std::min<int64_t>(nowNs, static_cast<int64_t>(WindowSlotCount - 1) * WindowSlotNs + nowNs % WindowSlotNs);
+    if (windowNs <= 0) return 0.0f;
+    
+    int64_t busy = 0;
+    for (size_t i = 0; i < m_impl->numThreads; ++i) {
+        busy += m_impl->counters[i].busyInWindow(nowNs);
+    }
+    
+    return static_cast<float>(static_cast<double>(busy) / (static_cast<double>(windowNs) * static_cast<double>(m_impl->numThreads)));
 }
 
 void ThreadManager::setThreadPriority(int priority) {
-    // TODO: Implement thread priority setting
-    // This is platform-specific and requires careful implementation
-    std::cout << "[Runtime] Thread priority setting not yet implemented (requested: " << priority << ")" << std::endl;
+    std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+    m_impl->priority = std::clamp(priority, -19, 20);
+    
+#ifdef __linux__
+    std::cout << "[Runtime] Worker thread priority set to " << m_impl->priority << std::endl;
+    for (size_t i = 0; i < m_impl->workerInfo.size(); ++i) {
+        m_impl->applyWorkerSettings(i);
+    }
+#else
+    std::cout << "[Runtime] Thread priority setting not supported on this platform (requested: " << priority << ")" << std::endl;
+#endif
+}
+
+void ThreadManager::setRealtimePriority(int rtPriority) {
+    std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+    m_impl->realtimePriority = std::max(rtPriority, 0);
+    
+#ifdef __linux__
+    std::cout << "[Runtime] Worker real-time priority set to " << m_impl->realtimePriority << std::endl;
+    for (size_t i = 0; i < m_impl->workerInfo.size(); ++i) {
+        m_impl->applyWorkerSettings(i);
+    }
+#else
+    std::cout << "[Runtime] Real-time scheduling not supported on this platform (requested: " << rtPriority << ")" << std::endl;
+#endif
 }
 
 void ThreadManager::setAffinityOptimization(bool enabled) {
-    // TODO: Implement thread affinity optimization
-    // This is platform-specific and requires careful implementation
-    std::cout << "[Runtime] Thread affinity optimization " << (enabled ? "enabled" : "disabled") << " (not yet implemented)" << std::endl;
+    std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+    m_impl->affinityEnabled = enabled;
+    
+#ifdef __linux__
+    std::cout << "[Runtime] Thread affinity optimization " << (enabled ? "enabled" : "disabled") << std::endl;
+    for (size_t i = 0; i < m_impl->workerInfo.size(); ++i) {
+        m_impl->applyWorkerSettings(i);
+    }
+#else
+    std::cout << "[Runtime] Thread affinity optimization " << (enabled ? "enabled" : "disabled") << " (not supported on this platform)" << std::endl;
+#endif
+}
+
+void ThreadManager::setHardwareCountersEnabled(bool enabled) {
+    {
+        std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+        m_impl->hardwareCountersEnabled = enabled;
+    }
+    
+    // Wake idle workers so they open their counters now
+    m_impl->condition.notify_all();
+    std::cout << "[Runtime] Worker hardware counters " << (enabled ? "enabled" : "disabled") << std::endl;
 }
 
 ThreadManager::Statistics ThreadManager::getStatistics() const {
     Statistics stats;
-    stats.totalTasksExecuted = m_impl->totalTasksExecuted;
     stats.currentPendingTasks = getPendingTaskCount();
     stats.activeThreads = m_impl->activeTasks;
     stats.threadUtilization = getThreadUtilization();
     
-    if (stats.totalTasksExecuted > 0) {
-        stats.averageTaskDuration = m_impl->totalTaskDuration / stats.totalTasksExecuted;
+    if (m_impl->counters) {
+        constexpr double nsToSeconds = 1e-9;
+        const int64_t nowNs = m_impl->elapsedNs(Clock::now());
+        const int64_t windowNs = std::min<int64_t>(nowNs, static_cast<int64_t>(WindowSlotCount - 1) * WindowSlotNs + nowNs % WindowSlotNs);
+        stats.windowLength = static_cast<double>(windowNs) * nsToSeconds;
+        
+        LatencyHistogram::Snapshot taskLatency;
+        LatencyHistogram::Snapshot queueWait;
+        uint64_t totalBusyNs = 0;
+        double maxBusy = 0.0;
+        double sumBusy = 0.0;
+        
+        for (size_t i = 0; i < m_impl->numThreads; ++i) {
+            const WorkerCounters& counters = m_impl->counters[i];
+            auto workerLatency = counters.taskLatency.snapshot();
+            auto workerWait = counters.queueWait.snapshot();
+            
+            WorkerStatistics worker;
+            worker.tasksExecuted = counters.tasksExecuted.load(std::memory_order_relaxed);
+            worker.busyTime = static_cast<double>(counters.busyInWindow(nowNs)) * nsToSeconds;
+            worker.busyTime = std::min(worker.busyTime, stats.windowLength);
+            worker.idleTime = stats.windowLength - worker.busyTime;
+            worker.utilization = stats.windowLength > 0.0 ? worker.busyTime / stats.windowLength : 0.0;
+            worker.taskLatency = workerLatency.summarize();
+            worker.queueWait = workerWait.summarize();
+            
+            stats.totalTasksExecuted += worker.tasksExecuted;
+            totalBusyNs += counters.totalBusyNs.load(std::memory_order_relaxed);
+            maxBusy = std::max(maxBusy, worker.busyTime);
+            sumBusy += worker.busyTime;
+            
+            taskLatency.merge(workerLatency);
+            queueWait.merge(workerWait);
+            stats.workers.push_back(worker);
+        }
+        
+        stats.taskLatency = taskLatency.summarize();
+        stats.queueWait = queueWait.summarize();
+        
+        if (sumBusy > 0.0) {
+            stats.loadImbalance = maxBusy / (sumBusy / static_cast<double>(m_impl->numThreads));
+        }
+        
+        if (stats.totalTasksExecuted > 0) {
+            stats.averageTaskDuration = static_cast<double>(totalBusyNs) * nsToSeconds / static_cast<double>(stats.totalTasksExecuted);
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+        for (const auto& queue : m_impl->nodeQueues) {
+            stats.queueCapacity += queue.capacity();
+        }
+        stats.topology = m_impl->topology;
+        stats.topology.affinityEnabled = m_impl->affinityEnabled;
+        for (const auto& info : m_impl->workerInfo) {
+            stats.topology.workerNodes.push_back(info.node);
+            stats.topology.workerCpus.push_back(info.cpu);
+        }
+        
+        if (m_impl->hardwareCountersEnabled) {
+            for (size_t i = 0; i < stats.workers.size(); ++i) {
+                const WorkerCounters& counters = m_impl->counters[i];
+                if (!counters.hardware || !counters.hardware->isAvailable()) continue;
+                
+                stats.workers[i].hardwareCountersAvailable = true;
+                stats.workers[i].hardware = counters.hardware->read() - counters.hardwareBaseline;
+                stats.hardware += stats.workers[i].hardware;
+            }
+        }
     }
     
+    stats.taskHeapFallbacks = InlineTask::getHeapFallbackCount();
+    stats.taskStatePoolChunks = TaskStatePool::getStatistics().chunksAllocated;
+    
     return stats;
 }
 
-} // namespace RoadSim::Runtime
\ No newline at end of file
+void ThreadManager::resetStatistics() {
+    if (!m_impl->counters) return;
+    
+    for (size_t i = 0; i < m_impl->numThreads; ++i) {
+        WorkerCounters& counters = m_impl->counters[i];
+        counters.tasksExecuted.store(0, std::memory_order_relaxed);
+        counters.totalBusyNs.store(0, std::memory_order_relaxed);
+        counters.taskLatency.reset();
+        counters.queueWait.reset();
+        for (auto& slot : counters.window) {
+            slot.epoch.store(-1, std::memory_order_relaxed);
+            slot.busyNs.store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(m_impl->queueMutex);
+    for (size_t i = 0; i < m_impl->numThreads; ++i) {
+        WorkerCounters& counters = m_impl->counters[i];
+        if (counters.hardware) {
+            counters.hardwareBaseline = counters.hardware->read();
+        }
+    }
+}
+
+} // namespace RoadSim::Runtime
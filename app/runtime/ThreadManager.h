@@ -6,10 +6,14 @@
 #include <thread>
 #include <vector>
 #include <string>
+#include "LatencyHistogram.h"
+#include "InlineTask.h"
+#include "TaskStatePool.h"
+#include "../core/PerfCounters.h"
 
 namespace RoadSim::Runtime {
 
-using Task = std::function<void()>;
+using Task = InlineTask;
 using TaskId = size_t;
 
 /**
@@ -42,6 +46,8 @@ public:
     
     /**
      * @brief Submit a task for async execution
+     * Does not allocate once queues have grown, unless the callable exceeds
+     * InlineTask::InlineSize bytes
      * @param task Task function to execute
      * @return Task ID for tracking
      */
@@ -49,6 +55,7 @@ public:
     
     /**
      * @brief Submit a task with return value
+     * The promise/future shared state comes from TaskStatePool
      * @param task Task function to execute
      * @return Future for the result
      */
@@ -83,24 +90,66 @@ public:
     size_t getWorkerThreadCount() const;
     
     /**
-     * @brief Get thread utilization percentage
+     * @brief Get thread utilization over the rolling statistics window (0.0 - 1.0)
      */
     float getThreadUtilization() const;
     
     /**
      * @brief Set thread priority for worker threads
-     * @param priority Thread priority level
+     * @param priority Priority relative to normal, from -19 (lowest) to 20 (highest).
+     *        Mapped to the nice value on Linux; raising it needs CAP_SYS_NICE.
      */
     void setThreadPriority(int priority);
     
+    /**
+     * @brief Run worker threads under the SCHED_FIFO real-time policy
+     * @param rtPriority Real-time priority 1-99, or 0 to return to normal scheduling
+     */
+    void setRealtimePriority(int rtPriority);
+    
     /**
      * @brief Enable/disable thread affinity optimization
+     * Pins each worker to one CPU of its NUMA node so it keeps its caches
      * @param enabled Affinity optimization state
      */
     void setAffinityOptimization(bool enabled);
     
+    /**
+     * @brief Count cycles, instructions, cache and branch misses per worker
+     * Each worker opens counters for its own thread (Linux perf_event_open);
+     * workers without counters report hardwareCountersAvailable = false
+     * @param enabled Counter state
+     */
+    void setHardwareCountersEnabled(bool enabled);
+    
+    /**
+     * @brief CPU layout detected at initialization
+     */
+    struct Topology {
+        size_t logicalCpuCount = 0;
+        std::vector<std::vector<int>> nodeCpus; // CPUs of each NUMA node
+        std::vector<int> workerNodes;            // NUMA node of each worker
+        std::vector<int> workerCpus;             // Pinned CPU of each worker (-1 = not pinned)
+        bool affinityEnabled = false;
+    };
+    
+    /**
+     * @brief Per-worker counters over the rolling statistics window
+     */
+    struct WorkerStatistics {
+        size_t tasksExecuted = 0;       // Since initialization
+        double busyTime = 0.0;          // Seconds spent running tasks in the window
+        double idleTime = 0.0;          // Seconds spent waiting in the window
+        double utilization = 0.0;       // busyTime / window length
+        LatencyHistogram::Summary taskLatency;
+        LatencyHistogram::Summary queueWait;
+        bool hardwareCountersAvailable = false;
+        Core::PerfSample hardware;      // Since counters were enabled or statistics reset
+    };
+    
     /**
      * @brief Get performance statistics
+     * Safe to call while tasks run; counters are read without stopping workers
      */
     struct Statistics {
         size_t totalTasksExecuted = 0;
@@ -108,10 +157,28 @@ public:
         size_t activeThreads = 0;
         double averageTaskDuration = 0.0;
         double threadUtilization = 0.0;
+        Topology topology;
+        
+        double windowLength = 0.0;              // Seconds covered by the rolling window
+        double loadImbalance = 0.0;             // Busiest worker busy time / mean busy time
+        LatencyHistogram::Summary taskLatency;  // All workers merged
+        LatencyHistogram::Summary queueWait;    // Submit to start of execution
+        std::vector<WorkerStatistics> workers;
+        
+        size_t taskHeapFallbacks = 0;           // Tasks too large for inline storage
+        size_t taskStatePoolChunks = 0;         // Heap chunks backing pooled future states
+        size_t queueCapacity = 0;               // Task slots reserved across node queues
+        Core::PerfSample hardware;              // Sum over workers with counters
     };
     
     Statistics getStatistics() const;
     
+    /**
+     * @brief Clear latency histograms and counters
+     * Call while no tasks are running for exact results
+     */
+    void resetStatistics();
+    
 private:
     struct Impl;
     std::unique_ptr<Impl> m_impl;
@@ -122,13 +189,23 @@ template<typename F, typename... Args>
 auto ThreadManager::submitTaskWithResult(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type> {
     using return_type = typename std::invoke_result<F, Args...>::type;
     
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-    );
-    
-    std::future<return_type> result = task->get_future();
-    
-    submitTask([task](){ (*task)(); });
+    std::promise<return_type> promise(std::allocator_arg, PoolAllocator<return_type>());
+    std::future<return_type> result = promise.get_future();
+    
+    submitTask([promise = std::move(promise), 
+                function = std::forward<F>(f), 
+                ...arguments = std::forward<Args>(args)]() mutable {
+        try {
+            if constexpr (std::is_void_v<return_type>) {
+                std::invoke(std::move(function), std::move(arguments)...);
+                promise.set_value();
+            } else {
+                promise.set_value(std::invoke(std::move(function), std::move(arguments)...));
+            }
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    });
     
     return result;
 }
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * @brief Shared helpers for the benchmark executables
+ * Benchmarks print one "[Bench]" line per measurement and return non-zero
+ * when a property the code promises (e.g. no steady-state allocation) fails.
+ */
+namespace RoadSim::Bench {
+
+class Stopwatch {
+public:
+    Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+    
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+    
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * @brief Run body repeatedly and return the fastest time in seconds
+ */
+template <typename F>
+double bestOf(int repetitions, F&& body) {
+    double best = 0.0;
+    for (int i = 0; i < repetitions; ++i) {
+        Stopwatch stopwatch;
+        body();
+        const double elapsed = stopwatch.seconds();
+        if (i == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+} // namespace RoadSim::Bench
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace RoadSim::Bench {
+
+/**
+ * @brief Synthetic map document of about targetBytes, shaped like our city maps
+ * Node and road tables with integers, doubles, booleans and names; one
+ * name in eight carries escapes or non-ASCII UTF-8 so those paths are timed.
+ */
+inline std::string makeMapCorpus(size_t targetBytes) {
+    std::string text;
+    text.reserve(targetBytes + 4096);
+    text += "{\n  \"name\": \"Synthetic city\",\n  \"version\": 2,\n  \"nodes\": [\n";
+    
+    char buffer[256];
+    size_t count = 0;
+    const size_t nodeBytes = targetBytes / 2;
+    while (text.size() < nodeBytes) {
+        const int length = std::snprintf(buffer, sizeof(buffer),
+            "%s    {\"id\": %zu, \"x\": %.3f, \"y\": %.3f, \"signalised\": %s}",
+            count > 0 ? ",\n" : "", count, static_cast<double>(count % 5000) * 12.5 + 0.125,
+            static_cast<double>(count / 5000) * 12.5 - 0.5, count % 9 == 0 ? "true" : "false");
+        text.append(buffer, static_cast<size_t>(length));
+        ++count;
+    }
+    
+    text += "\n  ],\n  \"roads\": [\n";
+    const size_t nodes = count;
+    count = 0;
+    while (text.size() < targetBytes) {
+        const char* name = count % 8 == 0 ? "Rue de l\\u2019\\u00c9glise \\\"Nord\\\"" : count % 8 == 4 ? "Chaussée d’Ixelles" : "Main Street";
+        const int length = std::snprintf(buffer, sizeof(buffer),
+            "%s    {\"id\": %zu, \"from\": %zu, \"to\": %zu, \"lanes\": %zu, \"speedLimit\": %.1f, \"oneWay\": %s, \"name\": \"%s\"}",
+            count > 0 ? ",\n" : "", count, count % nodes, (count * 7 + 1) % nodes, count % 4 + 1,
+            13.9 + static_cast<double>(count % 3) * 2.5, count % 5 == 0 ? "true" : "false", name);
+        text.append(buffer, static_cast<size_t>(length));
+        ++count;
+    }
+    text += "\n  ]\n}\n";
+    return text;
+}
+
+/**
+ * @brief Corpus size from the first command-line argument in MB (default 32)
+ */
+inline size_t corpusBytesFromArguments(int argc, char** argv) {
+    size_t megabytes = 32;
+    if (argc > 1) {
+        megabytes = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+        if (megabytes == 0) megabytes = 32;
+    }
+    return megabytes * 1024 * 1024;
+}
+
+} // namespace RoadSim::Bench
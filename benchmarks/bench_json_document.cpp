@@ -0,0 +1,50 @@
+#include "BenchSupport.h"
+#include "JsonCorpus.h"
+#include "io/JsonDocument.h"
+#include "io/JsonLoader.h"
+#include "io/JsonParser.h"
+#include <cstdio>
+#include <string>
+
+using namespace RoadSim;
+
+/**
+ * Throughput of JsonDocument in MB/s: a cold parse into a fresh arena, a
+ * reparse into the warm arena of the same document, and JsonParser
+ * (JsonObject) on the same text for comparison.
+ * Usage: bench_json_document [corpus MB]
+ */
+int main(int argc, char** argv) {
+    const std::string text = Bench::makeMapCorpus(Bench::corpusBytesFromArguments(argc, argv));
+    const double megabytes = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    
+    size_t roads = 0;
+    const double cold = Bench::bestOf(3, [&] {
+        IO::JsonDocument document;
+        document.parse(std::string_view(text));
+        roads = document.root()["roads"].size();
+    });
+    
+    IO::JsonDocument warmDocument;
+    warmDocument.parse(std::string_view(text));
+    const double warm = Bench::bestOf(3, [&] {
+        warmDocument.parse(std::string_view(text));
+    });
+    const size_t warmRoads = warmDocument.root()["roads"].size();
+    
+    size_t parserRoads = 0;
+    const double parser = Bench::bestOf(3, [&] {
+        IO::JsonObject root = IO::JsonParser(text).parse();
+        parserRoads = root["roads"].size();
+    });
+    
+    std::printf("[Bench] JsonDocument cold:  %.1f MB in %.1f ms, %.1f MB/s (%zu roads)\n",
+                megabytes, cold * 1000.0, megabytes / cold, roads);
+    std::printf("[Bench] JsonDocument warm:  %.1f MB in %.1f ms, %.1f MB/s\n",
+                megabytes, warm * 1000.0, megabytes / warm);
+    std::printf("[Bench] JsonParser:         %.1f MB in %.1f ms, %.1f MB/s\n",
+                megabytes, parser * 1000.0, megabytes / parser);
+    
+    // Both trees must agree on what they read
+    return roads > 0 && roads == warmRoads && roads == parserRoads ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+#include "BenchSupport.h"
+#include "JsonCorpus.h"
+#include "io/JsonLoader.h"
+#include "io/JsonParser.h"
+#include <cstdio>
+#include <string>
+
+using namespace RoadSim;
+
+/**
+ * Throughput of JsonParser (the RFC 8259 parser behind JsonLoader) in MB/s.
+ * Usage: bench_json_parser [corpus MB]
+ */
+int main(int argc, char** argv) {
+    const std::string text = Bench::makeMapCorpus(Bench::corpusBytesFromArguments(argc, argv));
+    const double megabytes = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    
+    size_t roads = 0;
+    const double seconds = Bench::bestOf(3, [&] {
+        IO::JsonObject root = IO::JsonParser(text).parse();
+        roads = root["roads"].size();
+    });
+    
+    std::printf("[Bench] JsonParser: %.1f MB in %.1f ms, %.1f MB/s (%zu roads)\n",
+                megabytes, seconds * 1000.0, megabytes / seconds, roads);
+    return roads > 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#include "BenchSupport.h"
+#include "runtime/MemoryTracker.h"
+#include "runtime/ThreadManager.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace RoadSim;
+using namespace RoadSim::Runtime;
+
+/**
+ * Submission cost and heap allocations per task, in steady state.
+ * The baseline builds what submitTask/submitTaskWithResult used to:
+ * a std::function, or a make_shared<packaged_task> around a std::bind.
+ */
+
+namespace {
+
+constexpr size_t BatchSize = 4096;
+constexpr size_t Batches = 64;
+
+struct Result {
+    double seconds = 0.0;
+    double allocationsPerTask = 0.0;
+};
+
+template <typename F>
+Result measure(F&& runBatches) {
+    const MemoryTracker::Counters before = MemoryTracker::getTotalCounters();
+    Bench::Stopwatch stopwatch;
+    runBatches();
+    Result result;
+    result.seconds = stopwatch.seconds();
+    result.allocationsPerTask = static_cast<double>((MemoryTracker::getTotalCounters() - before).allocations) /
+                                static_cast<double>(BatchSize * Batches);
+    return result;
+}
+
+void report(const char* name, const Result& result) {
+    const double tasks = static_cast<double>(BatchSize * Batches);
+    std::printf("[Bench] %-34s %8.1f ns/task  %6.3f allocations/task\n", name,
+                result.seconds * 1e9 / tasks, result.allocationsPerTask);
+}
+
+} // namespace
+
+int main() {
+    if (!MemoryTracker::isEnabled()) {
+        std::printf("[Bench] Allocation tracking is compiled out; allocation counts will read 0\n");
+    }
+    
+    ThreadManager threads;
+    threads.initialize();
+    
+    std::atomic<uint64_t> sink{0};
+    uint64_t a = 1, b = 2, c = 3;
+    auto submitBatches = [&] {
+        for (size_t batch = 0; batch < Batches; ++batch) {
+            for (size_t i = 0; i < BatchSize; ++i) {
+                threads.submitTask([&sink, a, b, c, i] { sink.fetch_add(a + b + c + i, std::memory_order_relaxed); });
+            }
+            threads.waitForAllTasks();
+        }
+    };
+    
+    std::vector<std::future<uint64_t>> futures;
+    futures.reserve(BatchSize);
+    auto submitWithResultBatches = [&] {
+        for (size_t batch = 0; batch < Batches; ++batch) {
+            for (size_t i = 0; i < BatchSize; ++i) {
+                futures.push_back(threads.submitTaskWithResult([](uint64_t x, uint64_t y) { return x * y; }, a, i));
+            }
+            for (auto& future : futures) sink.fetch_add(future.get(), std::memory_order_relaxed);
+            futures.clear();
+        }
+    };
+    
+    // First pass grows queues and the future-state pool; the second is steady state
+    submitBatches();
+    submitWithResultBatches();
+    const Result submit = measure(submitBatches);
+    const Result submitWithResult = measure(submitWithResultBatches);
+    
+    // Cost of the old wrappers alone, without any queueing
+    const Result baselineFunction = measure([&] {
+        for (size_t i = 0; i < BatchSize * Batches; ++i) {
+            std::array<uint64_t, 8> payload{a, b, c, i};
+            std::function<void()> task = [&sink, payload] { sink.fetch_add(payload[3], std::memory_order_relaxed); };
+            task();
+        }
+    });
+    const Result baselinePackaged = measure([&] {
+        for (size_t i = 0; i < BatchSize * Batches; ++i) {
+            auto task = std::make_shared<std::packaged_task<uint64_t()>>(
+                std::bind([](uint64_t x, uint64_t y) { return x * y; }, a, i));
+            std::future<uint64_t> future = task->get_future();
+            std::function<void()> wrapper = [task] { (*task)(); };
+            wrapper();
+            sink.fetch_add(future.get(), std::memory_order_relaxed);
+        }
+    });
+    
+    std::printf("[Bench] %zu workers, %zu tasks per measurement\n", threads.getWorkerThreadCount(), BatchSize * Batches);
+    report("submitTask", submit);
+    report("submitTaskWithResult", submitWithResult);
+    report("baseline std::function (64 B)", baselineFunction);
+    report("baseline packaged_task + bind", baselinePackaged);
+    
+    const ThreadManager::Statistics statistics = threads.getStatistics();
+    std::printf("[Bench] heap fallbacks %zu, future-state pool chunks %zu (checksum %llu)\n",
+                statistics.taskHeapFallbacks, statistics.taskStatePoolChunks,
+                static_cast<unsigned long long>(sink.load()));
+    threads.shutdown();
+    
+    // Submission is meant to be allocation-free once warmed up
+    const bool allocationFree = submit.allocationsPerTask < 0.01 && submitWithResult.allocationsPerTask < 0.01;
+    if (MemoryTracker::isEnabled() && !allocationFree) {
+        std::printf("[Bench] FAILED: steady-state submission allocates\n");
+        return 1;
+    }
+    return 0;
+}
@@ -24,7 +24,7 @@ echo Using SFML from: %SFML_DIR%
 
 REM Compile all source files
 echo Compiling source files...
-cl /EHsc /std:c++20 /I".." /I"%SFML_DIR%\include" /c ..\app\core\Simulator.cpp ..\app\core\Scheduler.cpp ..\app\core\RNG.cpp ..\app\core\GameObject.cpp ..\app\core\Transform.cpp ..\app\core\Collider.cpp ..\app\core\Scene.cpp ..\app\editor\MapEditor.cpp ..\app\editor\EntityEditor.cpp ..\app\render\Window.cpp ..\app\render\Renderer.cpp ..\app\render\UIManager.cpp ..\app\io\JsonLoader.cpp ..\app\io\ConfigLoader.cpp ..\app\runtime\ThreadManager.cpp ..\app\runtime\Application.cpp ..\app\main.cpp
+cl /EHsc /std:c++20 /I".." /I"%SFML_DIR%\include" /c ..\app\core\Simulator.cpp ..\app\core\Scheduler.cpp ..\app\core\RNG.cpp ..\app\core\Trace.cpp ..\app\core\PerfCounters.cpp ..\app\core\GameObject.cpp ..\app\core\Transform.cpp ..\app\core\TransformStore.cpp ..\app\core\Collider.cpp ..\app\core\Scene.cpp ..\app\core\MapSpatialIndex.cpp ..\app\editor\MapEditor.cpp ..\app\editor\EntityEditor.cpp ..\app\render\Window.cpp ..\app\render\Renderer.cpp ..\app\render\RoadMesh.cpp ..\app\render\EntityBatch.cpp ..\app\render\DensityOverlay.cpp ..\app\render\UIManager.cpp ..\app\io\JsonLoader.cpp ..\app\io\JsonParser.cpp ..\app\io\JsonStreamReader.cpp ..\app\io\JsonDocument.cpp ..\app\io\JsonWriter.cpp ..\app\io\TomlParser.cpp ..\app\io\MappedFile.cpp ..\app\io\MapBinary.cpp ..\app\io\MapChunkReader.cpp ..\app\io\MetricsWriter.cpp ..\app\io\ConfigLoader.cpp ..\app\io\ConfigWatcher.cpp ..\app\runtime\ThreadManager.cpp ..\app\runtime\LatencyHistogram.cpp ..\app\runtime\TaskStatePool.cpp ..\app\runtime\BehaviourExecutor.cpp ..\app\runtime\FramePacer.cpp ..\app\runtime\MemoryTracker.cpp ..\app\runtime\LoadingPipeline.cpp ..\app\runtime\AutoSaver.cpp ..\app\runtime\Application.cpp ..\app\main.cpp
 
 if %errorlevel% neq 0 (
     echo.
@@ -12,7 +12,7 @@ echo.
 echo Compiling core components...
 
 :: Compile only non-SFML dependent files
-cl /EHsc /std:c++20 /I".." /c ..\app\core\Simulator.cpp ..\app\core\Scheduler.cpp ..\app\core\RNG.cpp ..\app\editor\MapEditor.cpp ..\app\editor\EntityEditor.cpp ..\app\io\JsonLoader.cpp ..\app\io\ConfigLoader.cpp ..\app\runtime\ThreadManager.cpp
+cl /EHsc /std:c++20 /I".." /c ..\app\core\Simulator.cpp ..\app\core\Scheduler.cpp ..\app\core\RNG.cpp ..\app\core\Trace.cpp ..\app\core\PerfCounters.cpp ..\app\editor\MapEditor.cpp ..\app\editor\EntityEditor.cpp ..\app\io\JsonLoader.cpp ..\app\io\JsonParser.cpp ..\app\io\JsonStreamReader.cpp ..\app\io\JsonDocument.cpp ..\app\io\JsonWriter.cpp ..\app\io\TomlParser.cpp ..\app\io\MappedFile.cpp ..\app\io\MapBinary.cpp ..\app\io\MapChunkReader.cpp ..\app\io\MetricsWriter.cpp ..\app\io\ConfigLoader.cpp ..\app\io\ConfigWatcher.cpp ..\app\runtime\ThreadManager.cpp ..\app\runtime\LatencyHistogram.cpp ..\app\runtime\TaskStatePool.cpp ..\app\runtime\BehaviourExecutor.cpp
 
 if %errorlevel% neq 0 (
     echo.
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <iostream>
+
+/**
+ * @brief Minimal checks for the framework-free test executables
+ * CHECK records a failure and keeps going; main() returns testResult().
+ */
+namespace RoadSim::Tests {
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline int testResult() {
+    if (failureCount() == 0) {
+        std::cout << "[Tests] All checks passed" << std::endl;
+        return 0;
+    }
+    std::cerr << "[Tests] " << failureCount() << " check(s) failed" << std::endl;
+    return 1;
+}
+
+} // namespace RoadSim::Tests
+
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) {                                                               \
+            ++RoadSim::Tests::failureCount();                                             \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" \
+                      << std::endl;                                                       \
+        }                                                                                 \
+    } while (false)
@@ -0,0 +1,141 @@
+#include "TestSupport.h"
+#include "core/FixedPoint.h"
+#include "core/Scene.h"
+#include "core/Simulator.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace RoadSim;
+using namespace RoadSim::Core;
+
+namespace {
+
+constexpr int AgentCount = 64;
+constexpr uint64_t TickCount = 600;
+constexpr uint64_t HashInterval = 30;
+
+// Hashes of the exact-tick scenario, one per HashInterval ticks, recorded once
+// and committed. A compiler, flag or platform change that alters any
+// fixed-point result fails against these instead of agreeing with itself.
+const std::vector<uint64_t> GoldenHashes = {
+    0x59f7d1773e76f71eull, 0x4b5046469496be5cull, 0x893dfd2fdc8b092full, 0xaff19a8752e3f1e2ull,
+    0xd534743943022d88ull, 0x681d8f6eedc9e6b6ull, 0x3af09a0d3d506cbcull, 0x224972515bdde80cull,
+    0x9437f9c31127f0e9ull, 0xf062933b35ee9ad5ull, 0x1d15c1d1e8bf7239ull, 0x3eaf8b468794dbe7ull,
+    0x752def838c5e7c89ull, 0x2277c6465c416b8aull, 0x332c8b09c7445e5eull, 0x8e515f68d27822b7ull,
+    0x812242f9e18c6e10ull, 0x521278b242ba0674ull, 0xb57383d7fdafd81bull, 0x786881cd0116c99cull
+};
+
+struct Agent {
+    GameObject* object = nullptr;
+    FixedVec2 position;
+    Fixed heading;
+};
+
+/**
+ * @brief Run a small fixed-point scenario and return the recorded state hashes
+ * @param jitter Feed step() uneven wall-clock deltas instead of exact ticks
+ * @param nudgeTick Tick at which one agent is displaced (0 = never)
+ * @param matchesGolden Set to Simulator::verifyStateHashes(GoldenHashes) when given
+ */
+std::vector<uint64_t> runScenario(bool jitter, uint64_t nudgeTick, bool* matchesGolden = nullptr) {
+    Scene scene("Determinism");
+    Simulator simulator;
+    simulator.initialize();
+    simulator.setNumericMode(Simulator::NumericMode::FixedPoint);
+    simulator.setFixedTimeStep(1.0 / 60.0);
+    simulator.setStateHashInterval(HashInterval);
+    simulator.setStateHashSource([&scene](StateHasher& hasher, Simulator::NumericMode mode) {
+        scene.hashState(hasher, mode == Simulator::NumericMode::FixedPoint);
+    });
+    
+    std::vector<Agent> agents(AgentCount);
+    for (int i = 0; i < AgentCount; ++i) {
+        agents[i].object = scene.createGameObject("Agent");
+        agents[i].position = {Fixed::fromInt(i * 10), Fixed::fromInt(i % 7)};
+        agents[i].heading = Fixed::fromInt(i * 37 % 360);
+    }
+    
+    const Fixed step = Fixed::fromDouble(1.0 / 60.0);
+    const Fixed speed = Fixed::fromInt(12);
+    simulator.setTickCallback([&](uint64_t tick, double) {
+        for (Agent& agent : agents) {
+            agent.heading += Fixed::fromDouble(0.75);
+            agent.position = agent.position + FixedTrig::direction(agent.heading) * (speed * step);
+            if (tick == nudgeTick && &agent == &agents[AgentCount / 2]) {
+                agent.position.x += Fixed::fromDouble(0.01);
+            }
+            agent.object->setPosition({agent.position.x.toFloat(), agent.position.y.toFloat()});
+            agent.object->setRotation(agent.heading.toFloat());
+        }
+    });
+    
+    simulator.start();
+    uint64_t frame = 0;
+    while (simulator.getTickCount() < TickCount) {
+        // Uneven frames change how many ticks run per step(), never the ticks themselves
+        const double delta = jitter ? (frame % 3 == 0 ? 0.011 : 0.019) : 1.0 / 60.0;
+        simulator.step(static_cast<float>(delta));
+        ++frame;
+    }
+    
+    if (matchesGolden) *matchesGolden = simulator.verifyStateHashes(GoldenHashes);
+    return simulator.getStateHashes();
+}
+
+void testReplayMatches() {
+    bool exactMatches = false;
+    bool jitteredMatches = false;
+    const std::vector<uint64_t> exact = runScenario(false, 0, &exactMatches);
+    runScenario(true, 0, &jitteredMatches);
+    
+    CHECK(GoldenHashes.size() == TickCount / HashInterval);
+    CHECK(exact.size() == GoldenHashes.size());
+    CHECK(exactMatches);
+    CHECK(jitteredMatches);
+}
+
+void testDivergenceIsDetected() {
+    bool nudgedMatches = true;
+    const std::vector<uint64_t> nudged = runScenario(false, 300, &nudgedMatches);
+    CHECK(!nudgedMatches);
+    
+    // Hashes agree up to the nudge and differ at every checkpoint after it
+    CHECK(nudged.size() == GoldenHashes.size());
+    for (size_t i = 0; i < std::min(nudged.size(), GoldenHashes.size()); ++i) {
+        const uint64_t tick = (i + 1) * HashInterval;
+        if (tick < 300) {
+            CHECK(GoldenHashes[i] == nudged[i]);
+        } else {
+            CHECK(GoldenHashes[i] != nudged[i]);
+        }
+    }
+}
+
+void testFixedDivision() {
+    CHECK((Fixed::fromInt(6) / Fixed::fromInt(3)) == Fixed::fromInt(2));
+    CHECK((Fixed::fromInt(-6) / Fixed::fromInt(4)) == Fixed::fromDouble(-1.5));
+    CHECK((Fixed::fromInt(5) / Fixed::fromInt(0)).raw() == INT32_MAX);
+    CHECK((Fixed::fromInt(-5) / Fixed::fromInt(0)).raw() == INT32_MIN);
+    CHECK((Fixed::fromInt(30000) / Fixed::fromRaw(1)).raw() == INT32_MAX);
+}
+
+void testFixedConversionSaturates() {
+    CHECK(Fixed::fromDouble(1.0e9).raw() == INT32_MAX);
+    CHECK(Fixed::fromDouble(-1.0e9).raw() == INT32_MIN);
+    CHECK(Fixed::fromFloat(40000.0f).raw() == INT32_MAX);
+    CHECK(Fixed::fromFloat(-40000.0f).raw() == INT32_MIN);
+    CHECK(Fixed::fromFloat(std::numeric_limits<float>::quiet_NaN()).raw() == 0);
+    CHECK(Fixed::fromDouble(-2.5) == Fixed::fromRaw(-2 * Fixed::One - Fixed::One / 2));
+}
+
+} // namespace
+
+int main() {
+    testReplayMatches();
+    testDivergenceIsDetected();
+    testFixedDivision();
+    testFixedConversionSaturates();
+    return Tests::testResult();
+}
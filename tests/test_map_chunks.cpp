@@ -0,0 +1,93 @@
+#include "TestSupport.h"
+#include "io/JsonLoader.h"
+#include "io/MapChunkReader.h"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace RoadSim;
+
+namespace {
+
+// Strings holding structural characters, nested arrays, a decoy table key
+// and a repeated table, so record boundaries are not where a naive scan puts them
+const char* const TrickyMap =
+    "{ \"meta\": {\"nodes\": [1,2]}, \"spawnPoints\": [ {\"x\":1,\"y\":2,\"type\":\"a\\\"],{\",\"rate\":3}, {\"x\":4,\"type\":\"b\"} ],\n"
+    " \"roads\": [], \"nodes\" : [ {\"id\":1,\"x\":0.5,\"y\":1, \"tags\":[{\"k\":\"v\"}]},{\"id\":2,\"x\":1,\"y\":2},"
+    "{\"id\":3,\"x\":1,\"y\":2} ],\n \"trafficLights\": [ {\"nodeId\":2} ], \"name\": \"tr\\\"icky\", \"nodes\": [{\"id\":9}] }";
+
+bool sameMap(const Core::MapData& a, const Core::MapData& b) {
+    if (a.name != b.name || a.nodes.size() != b.nodes.size() || a.roads.size() != b.roads.size() ||
+        a.trafficLights.size() != b.trafficLights.size() || a.spawnPoints.size() != b.spawnPoints.size()) return false;
+    for (size_t i = 0; i < a.nodes.size(); ++i) {
+        if (a.nodes[i].id != b.nodes[i].id || a.nodes[i].x != b.nodes[i].x || a.nodes[i].y != b.nodes[i].y) return false;
+    }
+    for (size_t i = 0; i < a.trafficLights.size(); ++i) {
+        if (a.trafficLights[i].nodeId != b.trafficLights[i].nodeId) return false;
+    }
+    for (size_t i = 0; i < a.spawnPoints.size(); ++i) {
+        if (a.spawnPoints[i].type != b.spawnPoints[i].type || a.spawnPoints[i].x != b.spawnPoints[i].x) return false;
+    }
+    return true;
+}
+
+void writeFile(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary);
+    file << text;
+}
+
+/**
+ * @brief Load a file through every chunk of a MapChunkReader
+ * @return False if planning, any chunk or the merge failed
+ */
+bool loadChunked(const std::string& path, size_t chunkBytes, Core::MapData& map) {
+    IO::MapChunkReader reader;
+    if (!reader.open(path, chunkBytes)) return false;
+    for (size_t i = 0; i < reader.getChunkCount(); ++i) {
+        if (!reader.parseChunk(i)) return false;
+    }
+    return reader.merge(map);
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string path = (directory / "roadsim_test_map_chunks.json").string();
+    
+    IO::JsonLoader loader;
+    loader.initialize();
+    
+    // Every chunk size yields the tables JsonLoader::loadMapData reads
+    {
+        writeFile(path, TrickyMap);
+        Core::MapData reference;
+        CHECK(loader.loadMapData(path, reference));
+        CHECK(reference.nodes.size() == 4);
+        
+        for (const size_t chunkBytes : {size_t{1}, size_t{10}, size_t{40}, IO::MapChunkReader::DefaultChunkBytes}) {
+            Core::MapData chunked;
+            CHECK(loadChunked(path, chunkBytes, chunked));
+            CHECK(sameMap(reference, chunked));
+        }
+    }
+    
+    // Malformed arrays and out-of-range fields are rejected by both, wherever the splits land
+    for (const char* malformed : {"{\"nodes\":[{\"id\":1},{\"id\":2},]}",
+                                  "{\"nodes\":[{\"id\":1},,{\"id\":2}]}",
+                                  "{\"nodes\":[,{\"id\":1}]}",
+                                  "{\"nodes\":[{\"id\":1},{\"id\":}]}",
+                                  "{\"nodes\":[{\"id\":1,\"x\":1e300}]}",
+                                  "{\"roads\":[{\"id\":1,\"lanes\":3e9}]}"}) {
+        writeFile(path, malformed);
+        Core::MapData map;
+        CHECK(!loader.loadMapData(path, map));
+        for (const size_t chunkBytes : {size_t{1}, size_t{8}, IO::MapChunkReader::DefaultChunkBytes}) {
+            CHECK(!loadChunked(path, chunkBytes, map));
+        }
+    }
+    
+    std::filesystem::remove(path);
+    return Tests::testResult();
+}
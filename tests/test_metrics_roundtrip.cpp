@@ -0,0 +1,146 @@
+#include "TestSupport.h"
+#include "io/MetricsWriter.h"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace RoadSim;
+using IO::MetricRecord;
+using IO::MetricsWriter;
+
+namespace {
+
+constexpr size_t RecordCount = 5000;
+constexpr size_t BlockRecords = 700; // Several blocks, the last one partial
+
+bool sameBits(float a, float b) {
+    return std::bit_cast<uint32_t>(a) == std::bit_cast<uint32_t>(b);
+}
+
+bool sameRecord(const MetricRecord& a, const MetricRecord& b) {
+    return std::bit_cast<uint64_t>(a.time) == std::bit_cast<uint64_t>(b.time) && a.laneId == b.laneId &&
+           a.vehicles == b.vehicles && sameBits(a.throughput, b.throughput) && sameBits(a.meanWait, b.meanWait) &&
+           sameBits(a.meanSpeed, b.meanSpeed) && sameBits(a.occupancy, b.occupancy);
+}
+
+/**
+ * @brief Samples whose XOR residues use every bit: irregular times, random
+ * mantissas, sign flips, extremes, repeats and unmeasured values
+ */
+std::vector<MetricRecord> makeRecords() {
+    std::mt19937_64 random(46);
+    std::uniform_real_distribution<double> step(0.001, 3.0);
+    std::uniform_real_distribution<float> value(-1000.0f, 1000.0f);
+    
+    std::vector<MetricRecord> records(RecordCount);
+    double time = 0.1;
+    for (size_t i = 0; i < records.size(); ++i) {
+        MetricRecord& record = records[i];
+        time += step(random);
+        record.time = i % 97 == 0 ? -time * 1e300 : time;
+        record.laneId = i % 5 == 0 ? MetricRecord::NetworkWide : static_cast<uint32_t>(random() % 4096);
+        record.vehicles = static_cast<uint32_t>(random());
+        record.throughput = value(random);
+        record.meanWait = i % 3 == 0 && i > 0 ? records[i - 1].meanWait : value(random) * 1e-30f;
+        record.meanSpeed = i % 11 == 0 ? MetricRecord::NotMeasured : value(random);
+        record.occupancy = i % 13 == 0 ? std::numeric_limits<float>::denorm_min() : std::bit_cast<float>(static_cast<uint32_t>(random()));
+    }
+    records[1].time = std::bit_cast<double>(~uint64_t{0} >> 1); // Residue with the odd part at 63 bits
+    records[2].occupancy = -std::numeric_limits<float>::infinity();
+    return records;
+}
+
+bool writeAll(const std::string& path, MetricsWriter::Format format, const std::vector<MetricRecord>& records,
+              MetricsWriter::Statistics& stats) {
+    MetricsWriter writer;
+    MetricsWriter::Options options;
+    options.format = format;
+    options.blockRecords = BlockRecords;
+    if (!writer.open(path, options)) return false;
+    
+    // Half one by one, half as a batch
+    const size_t half = records.size() / 2;
+    for (size_t i = 0; i < half; ++i) writer.push(records[i]);
+    writer.push(std::span<const MetricRecord>(records).subspan(half));
+    writer.close();
+    stats = writer.getStatistics();
+    return true;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<MetricRecord> records = makeRecords();
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    
+    // Columnar files decode to the exact bits that were pushed
+    {
+        const std::string path = (directory / "roadsim_test_metrics.bin").string();
+        MetricsWriter::Statistics stats;
+        CHECK(writeAll(path, MetricsWriter::Format::Columnar, records, stats));
+        CHECK(stats.recordsDropped == 0);
+        CHECK(stats.recordsWritten == records.size());
+        
+        std::vector<MetricRecord> decoded;
+        std::string error;
+        CHECK(MetricsWriter::readColumnar(path, decoded, error));
+        CHECK(decoded.size() == records.size());
+        
+        size_t mismatches = 0;
+        for (size_t i = 0; i < std::min(decoded.size(), records.size()); ++i) {
+            if (!sameRecord(decoded[i], records[i])) mismatches++;
+        }
+        CHECK(mismatches == 0);
+        
+        // A block count the remaining bytes cannot hold fails the read instead of allocating
+        std::string bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        const size_t header = 16; // Magic, version, column count
+        CHECK(bytes.size() > header + 4);
+        bytes.replace(header, 4, "\xFF\xFF\xFF\xFF");
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << bytes;
+        }
+        std::vector<MetricRecord> corrupt;
+        CHECK(!MetricsWriter::readColumnar(path, corrupt, error));
+        CHECK(corrupt.size() < records.size());
+        std::filesystem::remove(path);
+    }
+    
+    // CSV leaves unmeasured cells empty
+    {
+        const std::string path = (directory / "roadsim_test_metrics.csv").string();
+        MetricsWriter::Statistics stats;
+        CHECK(writeAll(path, MetricsWriter::Format::Csv, records, stats));
+        CHECK(stats.recordsWritten == records.size());
+        
+        std::ifstream file(path);
+        std::string header, first;
+        std::getline(file, header);
+        std::getline(file, first);
+        CHECK(header == "time,lane,vehicles,throughput,meanWait,meanSpeed,occupancy");
+        CHECK(first.find(",,") != std::string::npos); // Record 0 has no meanSpeed
+        CHECK(first.find("nan") == std::string::npos);
+        
+        size_t lines = 1;
+        for (std::string line; std::getline(file, line);) lines++;
+        CHECK(lines == records.size());
+        file.close();
+        std::filesystem::remove(path);
+    }
+    
+    return Tests::testResult();
+}